@@ -27,6 +27,10 @@ void BTManager::run_task()
         CONFIG_I2C_BAUDRATE
     );
 
+    feedback_cb_reg_.callback = send_feedback_cb;
+    feedback_cb_reg_.context = nullptr;
+    i2c_driver_.set_feedback_callback(feedback_ready_cb, this);
+
     xTaskCreatePinnedToCore(
         [](void* parameter)
         { 
@@ -159,56 +163,142 @@ void BTManager::driver_update_timer_cb(btstack_timer_source *ts)
     btstack_run_loop_add_timer(ts);
 }
 
-void BTManager::send_feedback_cb(void* context)
+void BTManager::set_rumble_timer(uint8_t index, uint32_t timeout_ms)
+{
+    Device& device = devices_[index];
+    if (device.rumble_timer_set)
+    {
+        btstack_run_loop_remove_timer(&device.rumble_timer);
+    }
+    device.rumble_timer_set = true;
+    device.rumble_timer.process = rumble_timer_cb;
+    device.rumble_timer.context = reinterpret_cast<void*>(static_cast<uintptr_t>(index));
+    btstack_run_loop_set_timer(&device.rumble_timer, timeout_ms);
+    btstack_run_loop_add_timer(&device.rumble_timer);
+}
+
+void BTManager::clear_rumble_timer(uint8_t index)
 {
-    FBContext* fb_context = reinterpret_cast<FBContext*>(context);
+    Device& device = devices_[index];
+    if (device.rumble_timer_set)
+    {
+        device.rumble_timer_set = false;
+        btstack_run_loop_remove_timer(&device.rumble_timer);
+    }
+}
+
+/*  Sends the last read pad out if it changed, or if rumble is on and due a refresh. Changes
+    closer than RUMBLE_MIN_INTERVAL_MS to the last send wait on the rumble timer, which
+    otherwise only runs while rumble is on. */
+void BTManager::update_rumble(uint8_t index)
+{
+    Device& device = devices_[index];
     uni_hid_device_t* bp_device = nullptr;
 
-    if (!(bp_device = get_connected_bp32_device(fb_context->index)))
+    if (!(bp_device = get_connected_bp32_device(index)))
     {
+        clear_rumble_timer(index);
         return;
     }
 
-    I2CDriver::PacketOut packet_out = fb_context->packet_out->load();
+    const I2CDriver::PacketOut& packet_out = device.packet_out;
+    const bool active = (packet_out.rumble_l || packet_out.rumble_r);
+    const bool changed = (packet_out.rumble_l != device.rumble.rumble_l || packet_out.rumble_r != device.rumble.rumble_r);
+    const uint32_t elapsed_ms = btstack_run_loop_get_time_ms() - device.rumble_sent_ms;
 
-    if (packet_out.rumble_l || packet_out.rumble_r)
+    if (!changed && !(active && elapsed_ms >= RUMBLE_REFRESH_MS))
     {
-        bp_device->report_parser.play_dual_rumble(
-            bp_device, 
-            0, 
-            FEEDBACK_TIME_MS, 
-            packet_out.rumble_l, 
-            packet_out.rumble_r
-            );
+        if (active && !device.rumble_timer_set)
+        {
+            set_rumble_timer(index, RUMBLE_REFRESH_MS - elapsed_ms);
+        }
+        return;
+    }
+    if (elapsed_ms < RUMBLE_MIN_INTERVAL_MS)
+    {
+        set_rumble_timer(index, RUMBLE_MIN_INTERVAL_MS - elapsed_ms);
+        return;
+    }
+
+    //Zero stops it now instead of letting the last length run out
+    bp_device->report_parser.play_dual_rumble(
+        bp_device, 
+        0, 
+        active ? RUMBLE_TIME_MS : 0, 
+        packet_out.rumble_l, 
+        packet_out.rumble_r
+        );
+    device.rumble = packet_out;
+    device.rumble_sent_ms = btstack_run_loop_get_time_ms();
+
+    if (active)
+    {
+        set_rumble_timer(index, RUMBLE_REFRESH_MS);
+    }
+    else
+    {
+        clear_rumble_timer(index);
     }
 }
 
-//This will have to be changed once full support for multiple devices is added
-void BTManager::feedback_timer_cb(btstack_timer_source *ts)
+void BTManager::rumble_timer_cb(btstack_timer_source *ts)
+{
+    const uint8_t index = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(ts->context));
+    BTManager& bt_manager = get_instance();
+    bt_manager.devices_[index].rumble_timer_set = false;
+    bt_manager.update_rumble(index);
+}
+
+void BTManager::send_feedback_cb(void* context)
 {
-    static FBContext fb_contexts[MAX_GAMEPADS];
     BTManager& bt_manager = get_instance();
 
+    //Cleared before the reads, a batch that lands after it posts again
+    bt_manager.feedback_posted_.store(false);
+
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
     {
-        if (!get_connected_bp32_device(i))
+        if (bt_manager.feedback_mailboxes_[i].read(bt_manager.devices_[i].packet_out))
         {
-            continue;
+            bt_manager.update_rumble(i);
         }
+    }
+}
 
-        FBContext& fb_context = fb_contexts[i];
-        fb_context.index = i;
-        fb_context.packet_out = &bt_manager.devices_[i].packet_out;
-        fb_context.cb_reg.callback = send_feedback_cb;
-        fb_context.cb_reg.context = reinterpret_cast<void*>(&fb_context);
+//Runs on the i2c thread
+void BTManager::feedback_ready_cb(const I2CDriver::Feedback& feedback, void* context)
+{
+    BTManager* bt_manager = static_cast<BTManager*>(context);
+    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+    {
+        if (feedback.valid & (1U << i))
+        {
+            bt_manager->feedback_mailboxes_[i].write(feedback.packet_out[i]);
+        }
+    }
+    if (!bt_manager->feedback_posted_.exchange(true))
+    {
+        btstack_run_loop_execute_on_main_thread(&bt_manager->feedback_cb_reg_);
+    }
+}
 
-        //Register a read on i2c thread, with callback to send feedback on btstack thread
-        bt_manager.i2c_driver_.read_packet(I2CDriver::MULTI_SLAVE ? i + 1 : 0x01,
-            [&fb_context](const I2CDriver::PacketOut& packet_out)
-            {
-                fb_context.packet_out->store(packet_out);
-                btstack_run_loop_execute_on_main_thread(&fb_context.cb_reg);
-            });
+//Every connected pad is read in the same i2c pass, together with any pad writes still pending.
+//Pads that are sending reports get read with each of those too, this covers the idle ones.
+void BTManager::feedback_timer_cb(btstack_timer_source *ts)
+{
+    uint32_t pad_mask = 0;
+
+    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+    {
+        if (get_connected_bp32_device(i))
+        {
+            pad_mask |= (1U << i);
+        }
+    }
+
+    if (pad_mask)
+    {
+        get_instance().i2c_driver_.request_feedback(pad_mask);
     }
 
     btstack_run_loop_set_timer(ts, FEEDBACK_TIME_MS);
@@ -240,10 +330,13 @@ void BTManager::manage_connection(uint8_t index, bool connected)
             }
         }
 
+        clear_rumble_timer(index);
+        devices_[index].rumble = I2CDriver::PacketOut();
+
         I2CDriver::PacketIn packet_in = I2CDriver::PacketIn();
         packet_in.packet_id = I2CDriver::PacketID::SET_PAD;
         packet_in.index = index;
-        i2c_driver_.write_packet(I2CDriver::MULTI_SLAVE ? packet_in.index + 1 : 0x01, packet_in);
+        i2c_driver_.write_packet(I2CDriver::pad_address(packet_in.index), packet_in);
     }
 }
 
@@ -8,6 +8,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include "Mailbox.h"
 #include "I2CDriver/I2CDriver.h"
 #include "Gamepad/Gamepad.h"
 
@@ -31,7 +32,10 @@ private:
     BTManager(const BTManager&) = delete;
     BTManager& operator=(const BTManager&) = delete;
 
-    static constexpr uint32_t FEEDBACK_TIME_MS = 200;
+    static constexpr uint32_t FEEDBACK_TIME_MS = 50;        //Feedback poll while no reports are coming in
+    static constexpr uint32_t RUMBLE_TIME_MS = 250;         //Rumble length sent to the controller
+    static constexpr uint32_t RUMBLE_REFRESH_MS = 200;      //Keep-alive while rumble is on, before it runs out
+    static constexpr uint32_t RUMBLE_MIN_INTERVAL_MS = 16;  //Rate limit for output reports
     static constexpr uint32_t LED_TIME_MS = 500;
 
     struct Device
@@ -39,29 +43,38 @@ private:
         std::atomic<bool> connected{false};
         GamepadMapper mapper;
         I2CDriver::PacketIn packet_in;
-        std::atomic<I2CDriver::PacketOut> packet_out; //Can be updated from i2c thread
-    };
-
-    struct FBContext
-    {
-        uint8_t index;
-        std::atomic<I2CDriver::PacketOut>* packet_out;
-        btstack_context_callback_registration_t cb_reg;
+        I2CDriver::PacketOut packet_out;
+        I2CDriver::PacketOut rumble; //Last sent
+        uint32_t rumble_sent_ms{0};
+        btstack_timer_source_t rumble_timer;
+        bool rumble_timer_set{false};
     };
 
     std::array<Device, MAX_GAMEPADS> devices_;
     I2CDriver i2c_driver_;
 
+    //Feedback reads come back from the i2c thread in batches, one callback posted per batch.
+    //A mailbox per pad, so a batch landing before the last one was handled only replaces the
+    //pads it read again.
+    std::array<Mailbox<I2CDriver::PacketOut>, MAX_GAMEPADS> feedback_mailboxes_;
+    std::atomic<bool> feedback_posted_{false};
+    btstack_context_callback_registration_t feedback_cb_reg_;
+
     btstack_timer_source_t fb_timer_;
     bool fb_timer_running_ = false;
 
     void send_driver_type(DeviceDriverType driver_type);
     void manage_connection(uint8_t index, bool connected);
+    void update_rumble(uint8_t index);
+    void set_rumble_timer(uint8_t index, uint32_t timeout_ms);
+    void clear_rumble_timer(uint8_t index);
     
     static uni_hid_device_t* get_connected_bp32_device(uint8_t index);
     static void check_led_cb(btstack_timer_source *ts);
     static void send_feedback_cb(void* context);
+    static void feedback_ready_cb(const I2CDriver::Feedback& feedback, void* context);
     static void feedback_timer_cb(btstack_timer_source *ts);
+    static void rumble_timer_cb(btstack_timer_source *ts);
     static void driver_update_timer_cb(btstack_timer_source *ts);
 
     //Bluepad32 driver
@@ -4,6 +4,7 @@
 #include <driver/gpio.h>
 #include <esp_log.h>
 
+#include "Board/ogxm_log.h"
 #include "I2CDriver/I2CDriver.h"
 
 I2CDriver::~I2CDriver()
@@ -20,53 +21,328 @@ void I2CDriver::initialize_i2c(i2c_port_t i2c_port, gpio_num_t sda, gpio_num_t s
 
     i2c_port_ = i2c_port;
 
-    i2c_config_t conf;
-    std::memset(&conf, 0, sizeof(i2c_config_t));
+    //Start at the fastest speed clk_speed allows
+    link_speed_ = NUM_LINK_SPEEDS - 1;
+    for (size_t i = 0; i < NUM_LINK_SPEEDS; ++i)
+    {
+        if (LINK_SPEEDS[i] <= clk_speed)
+        {
+            link_speed_ = i;
+            break;
+        }
+    }
 
-    conf.mode = I2C_MODE_MASTER;
-    conf.sda_io_num = sda;
-    conf.scl_io_num = scl;
-    conf.sda_pullup_en = GPIO_PULLUP_ENABLE;
-    conf.scl_pullup_en = GPIO_PULLUP_ENABLE;
-    conf.master.clk_speed = clk_speed;
+    std::memset(&config_, 0, sizeof(i2c_config_t));
 
-    i2c_param_config(i2c_port_, &conf);
-    i2c_driver_install(i2c_port_, conf.mode, 0, 0, 0);
+    config_.mode = I2C_MODE_MASTER;
+    config_.sda_io_num = sda;
+    config_.scl_io_num = scl;
+    config_.sda_pullup_en = GPIO_PULLUP_ENABLE;
+    config_.scl_pullup_en = GPIO_PULLUP_ENABLE;
+    config_.master.clk_speed = LINK_SPEEDS[link_speed_];
+
+    i2c_param_config(i2c_port_, &config_);
+    i2c_driver_install(i2c_port_, config_.mode, 0, 0, 0);
 
     initialized_ = true;
 }
 
+uint32_t I2CDriver::link_speed() const
+{
+    return LINK_SPEEDS[link_speed_];
+}
+
+void I2CDriver::set_link_speed(size_t speed)
+{
+    if (speed >= NUM_LINK_SPEEDS || speed == link_speed_)
+    {
+        return;
+    }
+
+    link_speed_ = speed;
+    link_transfers_ = 0;
+    link_errors_ = 0;
+
+    i2c_driver_delete(i2c_port_);
+    config_.master.clk_speed = LINK_SPEEDS[link_speed_];
+    i2c_param_config(i2c_port_, &config_);
+    i2c_driver_install(i2c_port_, config_.mode, 0, 0, 0);
+
+    OGXM_LOG("I2C: Link speed %lu kHz\n", LINK_SPEEDS[link_speed_] / 1000);
+}
+
+bool I2CDriver::test_link(uint8_t address, uint8_t seq)
+{
+    LinkTest test;
+    test.seq = seq;
+    for (size_t i = 0; i < test.payload.size(); ++i)
+    {
+        test.payload[i] = static_cast<uint8_t>(((i & 1) ? 0xAA : 0x55) ^ (address + i * seq));
+    }
+    test.crc = crc8(reinterpret_cast<const uint8_t*>(&test), sizeof(LinkTest) - 1);
+
+    if (i2c_write_blocking(address, reinterpret_cast<const uint8_t*>(&test), sizeof(LinkTest)) != ESP_OK)
+    {
+        return false;
+    }
+
+    LinkTestReply reply;
+    if (i2c_read_blocking(address, reinterpret_cast<uint8_t*>(&reply), sizeof(LinkTestReply)) != ESP_OK)
+    {
+        return false;
+    }
+
+    return  reply.packet_len == sizeof(LinkTestReply) &&
+            reply.packet_id == PacketID::LINK_TEST &&
+            reply.seq == seq &&
+            reply.status == PacketResp::OK &&
+            reply.crc == crc8(reinterpret_cast<const uint8_t*>(&reply), sizeof(LinkTestReply) - 1);
+}
+
+//Steps down until every test packet to the first slave comes back intact, the slowest speed is kept regardless
+void I2CDriver::train_link()
+{
+    while (true)
+    {
+        bool passed = true;
+        for (uint8_t seq = 1; seq <= LINK_TEST_PACKETS && passed; ++seq)
+        {
+            passed = test_link(0x01, seq);
+        }
+        if (passed || link_speed_ + 1 >= NUM_LINK_SPEEDS)
+        {
+            break;
+        }
+        set_link_speed(link_speed_ + 1);
+    }
+    OGXM_LOG("I2C: Link trained at %lu kHz\n", LINK_SPEEDS[link_speed_] / 1000);
+}
+
+//Drops a speed if too many transfers in the window fail
+void I2CDriver::link_result(bool ok)
+{
+    ++link_transfers_;
+    if (!ok)
+    {
+        ++link_errors_;
+    }
+    if (link_errors_ > LINK_ERROR_LIMIT)
+    {
+        OGXM_LOG("I2C: %u of %u transfers failed\n", link_errors_, link_transfers_);
+        set_link_speed(link_speed_ + 1);
+    }
+    if (link_transfers_ >= LINK_WINDOW)
+    {
+        link_transfers_ = 0;
+        link_errors_ = 0;
+    }
+}
+
 void I2CDriver::run_tasks()
 {
-    std::function<void()> task;
+    Command command;
+
+    task_handle_.store(xTaskGetCurrentTaskHandle());
+    train_link();
 
     while (true)
-    {   
-        while (task_queue_.pop(task))
+    {
+        while (command_queue_.pop(command))
         {
-            task();
+            run_command(command);
         }
+        service_pads();
+        //A push between the last pop and here leaves the notification pending, so nothing is missed
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+void I2CDriver::run_command(const Command& command)
+{
+    switch (command.op)
+    {
+        case Op::WRITE:
+            link_result(i2c_write_blocking(command.address, reinterpret_cast<const uint8_t*>(&command.packet_in), sizeof(PacketIn)) == ESP_OK);
+            break;
 
-        vTaskDelay(1);
+        case Op::READ:
+        {
+            PacketOut data_out;
+            const bool ok = (i2c_read_blocking(command.address, reinterpret_cast<uint8_t*>(&data_out), sizeof(PacketOut)) == ESP_OK);
+            link_result(ok);
+            if (ok && command.callback)
+            {
+                command.callback(data_out, command.context);
+            }
+            break;
+        }
     }
 }
 
-void I2CDriver::write_packet(uint8_t address, const PacketIn& data_in) 
+//Everything dirty since the last pass, one burst per slave
+void I2CDriver::service_pads()
 {
-    task_queue_.push([this, address, data_in]() 
+    PadWrites writes;
+    uint32_t write_mask = 0;
+    for (size_t i = 0; i < MAX_PADS; ++i)
     {
-        i2c_write_blocking(address, reinterpret_cast<const uint8_t*>(&data_in), sizeof(PacketIn));
-    });
+        if (pad_mailboxes_[i].read(writes[i]))
+        {
+            write_mask |= (1U << i);
+        }
+    }
+
+    const uint32_t read_mask = feedback_mask_.exchange(0) & ((1U << MAX_PADS) - 1);
+    uint32_t pending = write_mask | read_mask;
+    if (!pending)
+    {
+        return;
+    }
+
+    auto address_of = [&](size_t index)
+    {
+        return (write_mask & (1U << index)) ? writes[index].address : pad_address(index);
+    };
+
+    Feedback feedback;
+    for (size_t first = 0; first < MAX_PADS; ++first)
+    {
+        if (!(pending & (1U << first)))
+        {
+            continue;
+        }
+
+        const uint8_t address = address_of(first);
+        uint32_t slave_mask = 0;
+        for (size_t i = first; i < MAX_PADS; ++i)
+        {
+            if ((pending & (1U << i)) && address_of(i) == address)
+            {
+                slave_mask |= (1U << i);
+            }
+        }
+        pending &= ~slave_mask;
+
+        if (run_burst(address, slave_mask, writes, write_mask, read_mask, feedback))
+        {
+            feedback.valid |= (slave_mask & read_mask);
+        }
+    }
+
+    if (read_mask && feedback_callback_)
+    {
+        feedback_callback_(feedback, feedback_context_);
+    }
 }
 
-void I2CDriver::read_packet(uint8_t address, std::function<void(const PacketOut&)> callback) 
+/*  One START ... STOP for every pad of a slave. Each pad gets its write, or a 3 byte GET_PAD
+    header if only its feedback is wanted, then a repeated start read, which the slave answers
+    for the index it was just sent. A failure loses the whole burst, it's counted once. */
+bool I2CDriver::run_burst(uint8_t address, uint32_t pad_mask, const PadWrites& writes, uint32_t write_mask, uint32_t read_mask, Feedback& feedback)
 {
-    task_queue_.push([this, address, callback]() 
+    std::array<std::array<uint8_t, 3>, MAX_PADS> selects;
+    size_t bytes = 0;
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buffer_.data(), link_buffer_.size());
+    if (cmd == nullptr)
     {
-        PacketOut data_out;
-        if (i2c_read_blocking(address, reinterpret_cast<uint8_t*>(&data_out), sizeof(PacketOut)) == ESP_OK)
+        return false;
+    }
+
+    for (size_t i = 0; i < MAX_PADS; ++i)
+    {
+        const uint32_t bit = (1U << i);
+        if (!(pad_mask & bit))
+        {
+            continue;
+        }
+
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, true);
+        if (write_mask & bit)
+        {
+            i2c_master_write(cmd, reinterpret_cast<const uint8_t*>(&writes[i].packet_in), sizeof(PacketIn), true);
+            bytes += 1 + sizeof(PacketIn);
+        }
+        else
+        {
+            selects[i] = { static_cast<uint8_t>(selects[i].size()), static_cast<uint8_t>(PacketID::GET_PAD), static_cast<uint8_t>(i) };
+            i2c_master_write(cmd, selects[i].data(), selects[i].size(), true);
+            bytes += 1 + selects[i].size();
+        }
+
+        if (read_mask & bit)
         {
-            callback(data_out);
+            i2c_master_start(cmd);
+            i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_READ, true);
+            i2c_master_read(cmd, reinterpret_cast<uint8_t*>(&feedback.packet_out[i]), sizeof(PacketOut), I2C_MASTER_LAST_NACK);
+            bytes += 1 + sizeof(PacketOut);
         }
-    });
+    }
+    i2c_master_stop(cmd);
+
+    //2 ms like a single transfer, plus the time the extra bytes take at the current speed
+    const uint32_t timeout_ms = 2 + static_cast<uint32_t>((bytes * 9 * 1000) / LINK_SPEEDS[link_speed_]);
+    const esp_err_t ret = i2c_master_cmd_begin(i2c_port_, cmd, pdMS_TO_TICKS(timeout_ms));
+    i2c_cmd_link_delete_static(cmd);
+
+    link_result(ret == ESP_OK);
+    return (ret == ESP_OK);
+}
+
+void I2CDriver::notify_task()
+{
+    TaskHandle_t task_handle = task_handle_.load();
+    if (task_handle)
+    {
+        xTaskNotifyGive(task_handle);
+    }
+}
+
+void I2CDriver::push_command(const Command& command)
+{
+    if (!command_queue_.push(command))
+    {
+        OGXM_LOG("I2C: Command queue full, dropped\n");
+        return;
+    }
+    notify_task();
+}
+
+void I2CDriver::write_packet(uint8_t address, const PacketIn& data_in) 
+{
+    if (data_in.packet_id == PacketID::SET_PAD && data_in.index < MAX_PADS)
+    {
+        pad_mailboxes_[data_in.index].write({ address, data_in });
+        notify_task();
+        return;
+    }
+
+    Command command;
+    command.op = Op::WRITE;
+    command.address = address;
+    command.packet_in = data_in;
+    push_command(command);
+}
+
+void I2CDriver::read_packet(uint8_t address, ReadCallback callback, void* context) 
+{
+    Command command;
+    command.op = Op::READ;
+    command.address = address;
+    command.callback = callback;
+    command.context = context;
+    push_command(command);
+}
+
+void I2CDriver::set_feedback_callback(FeedbackCallback callback, void* context)
+{
+    feedback_callback_ = callback;
+    feedback_context_ = context;
+}
+
+void I2CDriver::request_feedback(uint32_t pad_mask)
+{
+    feedback_mask_.fetch_or(pad_mask);
+    notify_task();
 }
\ No newline at end of file
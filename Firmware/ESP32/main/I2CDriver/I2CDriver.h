@@ -3,11 +3,15 @@
 
 #include <cstdint>
 #include <cstring>
-#include <functional>
+#include <atomic>
+#include <array>
 #include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include "sdkconfig.h"
 #include "RingBuffer.h"
+#include "Mailbox.h"
 #include "UserSettings/DeviceDriverTypes.h"
 
 class I2CDriver 
@@ -20,7 +24,7 @@ public:
         true;
 #endif
 
-    enum class PacketID : uint8_t { UNKNOWN = 0, SET_PAD, GET_PAD, SET_DRIVER };
+    enum class PacketID : uint8_t { UNKNOWN = 0, SET_PAD, GET_PAD, SET_DRIVER, LINK_TEST };
     enum class PacketResp : uint8_t { OK = 1, ERROR };
 
     #pragma pack(push, 1)
@@ -52,8 +56,39 @@ public:
         std::array<uint8_t, 3> reserved{0};
     };
     static_assert(sizeof(PacketOut) == 8, "PacketOut is misaligned");
+
+    //Full size CRC'd write, the reply says whether the CRC matched and is CRC'd itself
+    struct LinkTest
+    {
+        uint8_t packet_len{sizeof(LinkTest)};
+        PacketID packet_id{PacketID::LINK_TEST};
+        uint8_t seq{0};
+        std::array<uint8_t, 28> payload{0};
+        uint8_t crc{0};
+    };
+    static_assert(sizeof(LinkTest) == 32, "LinkTest is misaligned");
+
+    struct LinkTestReply
+    {
+        uint8_t packet_len{0};
+        PacketID packet_id{PacketID::UNKNOWN};
+        uint8_t seq{0};
+        PacketResp status{PacketResp::ERROR};
+        std::array<uint8_t, 3> pattern{0};
+        uint8_t crc{0};
+    };
+    static_assert(sizeof(LinkTestReply) == 8, "LinkTestReply is misaligned");
     #pragma pack(pop)
 
+    static constexpr size_t MAX_PADS = CONFIG_BLUEPAD32_MAX_DEVICES;
+
+    //Pad reads from one service pass, packet_out[i] is only valid if bit i of valid is set
+    struct Feedback
+    {
+        std::array<PacketOut, MAX_PADS> packet_out;
+        uint32_t valid{0};
+    };
+
     I2CDriver() = default;
     ~I2CDriver();
 
@@ -62,15 +97,94 @@ public:
     //Does not return
     void run_tasks();
 
+    //Runs on the i2c task
+    using ReadCallback = void(*)(const PacketOut& packet_out, void* context);
+    using FeedbackCallback = void(*)(const Feedback& feedback, void* context);
+
+    //Both copy into the command ring and wake the i2c task, nothing is allocated.
+    //SET_PAD writes go to a mailbox per pad instead, only the newest state of each is sent.
     void write_packet(uint8_t address, const PacketIn& data_in);
-    void read_packet(uint8_t address, std::function<void(const PacketOut&)> callback);
+    void read_packet(uint8_t address, ReadCallback callback, void* context);
+
+    //Set before run_tasks. Pads in pad_mask are read on the next service pass, in the same
+    //burst as their pending writes, and all results go to the callback in one call.
+    void set_feedback_callback(FeedbackCallback callback, void* context);
+    void request_feedback(uint32_t pad_mask);
+
+    static constexpr uint8_t pad_address(uint8_t index)
+    {
+        return MULTI_SLAVE ? index + 1 : 0x01;
+    }
+
+    uint32_t link_speed() const;
 
 private:
-    using TaskQueue = RingBuffer<std::function<void()>, CONFIG_I2C_RING_BUFFER_SIZE>;
+    enum class Op : uint8_t { WRITE = 0, READ };
+
+    struct Command
+    {
+        Op op{Op::WRITE};
+        uint8_t address{0};
+        PacketIn packet_in;                 //WRITE
+        ReadCallback callback{nullptr};     //READ
+        void* context{nullptr};
+    };
+
+    struct PadWrite
+    {
+        uint8_t address{0};
+        PacketIn packet_in;
+    };
+
+    using CommandQueue = RingBuffer<Command, CONFIG_I2C_RING_BUFFER_SIZE>;
+    using PadWrites = std::array<PadWrite, MAX_PADS>;
+
+    //Fm+ first, then Fm and Sm, never faster than CONFIG_I2C_BAUDRATE
+    static constexpr uint32_t LINK_SPEEDS[] = { 1000 * 1000, 400 * 1000, 100 * 1000 };
+    static constexpr size_t NUM_LINK_SPEEDS = sizeof(LINK_SPEEDS) / sizeof(LINK_SPEEDS[0]);
+    static constexpr uint8_t LINK_TEST_PACKETS = 8;
+    static constexpr uint16_t LINK_WINDOW = 256;
+    static constexpr uint16_t LINK_ERROR_LIMIT = 8;
     
-    TaskQueue task_queue_;
+    CommandQueue command_queue_;
+    std::array<Mailbox<PadWrite>, MAX_PADS> pad_mailboxes_;
+    std::atomic<TaskHandle_t> task_handle_{nullptr};
+    std::atomic<uint32_t> feedback_mask_{0};
+    FeedbackCallback feedback_callback_{nullptr};
+    void* feedback_context_{nullptr};
+    //A write and a read per pad, linked statically so a burst doesn't allocate
+    alignas(4) std::array<uint8_t, I2C_LINK_RECOMMENDED_SIZE(2 * MAX_PADS)> link_buffer_{0};
     i2c_port_t i2c_port_ = I2C_NUM_0;
+    i2c_config_t config_;
     bool initialized_ = false;
+    size_t link_speed_ = 0; //Index into LINK_SPEEDS
+    uint16_t link_transfers_ = 0;
+    uint16_t link_errors_ = 0;
+
+    void set_link_speed(size_t speed);
+    bool test_link(uint8_t address, uint8_t seq);
+    void train_link();
+    void link_result(bool ok);
+    void push_command(const Command& command);
+    void notify_task();
+    void run_command(const Command& command);
+    void service_pads();
+    bool run_burst(uint8_t address, uint32_t pad_mask, const PadWrites& writes, uint32_t write_mask, uint32_t read_mask, Feedback& feedback);
+
+    //CRC-8, polynomial 0x07, matches the RP2040 side
+    static inline uint8_t crc8(const uint8_t* data, size_t len)
+    {
+        uint8_t crc = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            crc ^= data[i];
+            for (uint8_t bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
 
     static inline esp_err_t i2c_write_blocking(uint8_t address, const uint8_t* buffer, size_t len) 
     {
@@ -0,0 +1,47 @@
+#ifndef _MAILBOX_H_
+#define _MAILBOX_H_
+
+#include <cstdint>
+#include <atomic>
+#include <array>
+
+//Latest value handoff, single writer and single reader. Triple buffered, a write never waits
+//and replaces a value that hasn't been read yet, so readers only ever see the newest one.
+template<typename Type>
+class Mailbox
+{
+public:
+    Mailbox() = default;
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    void write(const Type& value)
+    {
+        buffers_[back_] = value;
+        back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    //False if nothing was written since the last read
+    bool read(Type& value)
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH))
+        {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+        value = buffers_[front_];
+        return true;
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH = 0x04;
+
+    std::array<Type, 3> buffers_{};
+    uint8_t back_{0};   //Writer's
+    uint8_t front_{1};  //Reader's
+    std::atomic<uint8_t> middle_{2};
+};
+
+#endif // _MAILBOX_H_
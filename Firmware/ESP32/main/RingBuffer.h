@@ -2,21 +2,23 @@
 #define _RING_BUFFER_H_
 
 #include <cstdint>
+#include <cstddef>
 #include <atomic>
 #include <array>
 
+//Lock-free single producer, single consumer. head_ is only written by push, tail_ only by pop.
+//Holds SIZE - 1 items, push fails instead of overwriting when full.
 template<typename Type, size_t SIZE>
 class RingBuffer
 {
 public:
+    static_assert(SIZE > 1, "RingBuffer needs at least 2 slots");
+
     RingBuffer() : head_(0), tail_(0) {}
 
     RingBuffer(const RingBuffer&) = delete;
     RingBuffer& operator=(const RingBuffer&) = delete;
 
-    RingBuffer(RingBuffer&&) = default;
-    RingBuffer& operator=(RingBuffer&&) = default;
-
     bool push(const Type& item)
     {
         size_t head = head_.load(std::memory_order_relaxed);
@@ -24,7 +26,7 @@ public:
 
         if (next_head == tail_.load(std::memory_order_acquire))
         {
-            tail_.store((tail_.load(std::memory_order_relaxed) + 1) % SIZE, std::memory_order_release);
+            return false;
         }
 
         buffer_[head] = item;
@@ -52,4 +54,4 @@ private:
     std::atomic<size_t> tail_;
 };
 
-#endif // _RING_BUFFER_H_
\ No newline at end of file
+#endif // _RING_BUFFER_H_
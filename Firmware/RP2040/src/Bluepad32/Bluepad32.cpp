@@ -20,19 +20,28 @@ static_assert((CONFIG_BLUEPAD32_MAX_DEVICES == MAX_GAMEPADS), "Mismatch between
 
 namespace bluepad32 {
 
-static constexpr uint32_t FEEDBACK_TIME_MS = 250;
+static constexpr uint32_t FEEDBACK_TIME_MS = 250;      //Rumble length sent to the controller
+static constexpr uint32_t RUMBLE_REFRESH_MS = 200;     //Keep-alive while rumble is on, before it runs out
+static constexpr uint32_t RUMBLE_MIN_INTERVAL_MS = 16; //Rate limit for output reports
 static constexpr uint32_t LED_CHECK_TIME_MS = 500;
 
+/*  Rumble is event driven: a pad out change posts feedback_posted_cb to the btstack thread,
+    which sends it right away unless the last send was under RUMBLE_MIN_INTERVAL_MS ago. The
+    feedback timer then only runs to finish a rate limited send or refresh active rumble. */
 struct BTDevice {
     bool connected{false};
     Gamepad* gamepad{nullptr};
+    std::atomic<bool> feedback_posted{false};
+    btstack_context_callback_registration_t feedback_cb_reg;
+    btstack_timer_source_t feedback_timer;
+    bool feedback_timer_set{false};
+    Gamepad::PadOut rumble;     //Last sent
+    uint32_t rumble_sent_ms{0};
 };
 
 BTDevice bt_devices_[MAX_GAMEPADS];
-btstack_timer_source_t feedback_timer_;
 btstack_timer_source_t led_timer_;
 bool led_timer_set_{false};
-bool feedback_timer_set_{false};
 
 bool any_connected()
 {
@@ -85,27 +94,101 @@ void set_rumble(uni_hid_device_t* bp_device, uint16_t length, uint8_t rumble_l,
     }
 }
 
-static void send_feedback_cb(btstack_timer_source *ts)
+static void feedback_timer_cb(btstack_timer_source *ts);
+
+static void set_feedback_timer(uint8_t index, uint32_t timeout_ms)
+{
+    BTDevice& device = bt_devices_[index];
+    if (device.feedback_timer_set)
+    {
+        btstack_run_loop_remove_timer(&device.feedback_timer);
+    }
+    device.feedback_timer_set = true;
+    device.feedback_timer.process = feedback_timer_cb;
+    device.feedback_timer.context = reinterpret_cast<void*>(static_cast<uintptr_t>(index));
+    btstack_run_loop_set_timer(&device.feedback_timer, timeout_ms);
+    btstack_run_loop_add_timer(&device.feedback_timer);
+}
+
+static void clear_feedback_timer(uint8_t index)
+{
+    BTDevice& device = bt_devices_[index];
+    if (device.feedback_timer_set)
+    {
+        device.feedback_timer_set = false;
+        btstack_run_loop_remove_timer(&device.feedback_timer);
+    }
+}
+
+//Sends pad out if it changed, or if rumble is on and due a refresh
+static void update_rumble(uint8_t index)
 {
+    BTDevice& device = bt_devices_[index];
     uni_hid_device_t* bp_device = nullptr;
 
-    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+    if (!device.connected || !(bp_device = uni_hid_device_get_instance_for_idx(index)))
     {
-        if (!bt_devices_[i].connected || 
-            !(bp_device = uni_hid_device_get_instance_for_idx(i)))
-        {
-            continue;
-        }
+        clear_feedback_timer(index);
+        return;
+    }
 
-        Gamepad::PadOut gp_out = bt_devices_[i].gamepad->get_pad_out();
-        if (gp_out.rumble_l > 0 || gp_out.rumble_r > 0)
+    const Gamepad::PadOut gp_out = device.gamepad->get_pad_out();
+    const bool active = (gp_out.rumble_l > 0 || gp_out.rumble_r > 0);
+    const bool changed = (gp_out.rumble_l != device.rumble.rumble_l || gp_out.rumble_r != device.rumble.rumble_r);
+    const uint32_t elapsed_ms = btstack_run_loop_get_time_ms() - device.rumble_sent_ms;
+
+    if (!changed && !(active && elapsed_ms >= RUMBLE_REFRESH_MS))
+    {
+        if (active && !device.feedback_timer_set)
         {
-            set_rumble(bp_device, static_cast<uint16_t>(FEEDBACK_TIME_MS), gp_out.rumble_l, gp_out.rumble_r);
+            set_feedback_timer(index, RUMBLE_REFRESH_MS - elapsed_ms);
         }
+        return;
+    }
+    if (elapsed_ms < RUMBLE_MIN_INTERVAL_MS)
+    {
+        set_feedback_timer(index, RUMBLE_MIN_INTERVAL_MS - elapsed_ms);
+        return;
     }
 
-    btstack_run_loop_set_timer(ts, FEEDBACK_TIME_MS);
-    btstack_run_loop_add_timer(ts);
+    //Zero stops it now instead of letting the last length run out
+    set_rumble(bp_device, active ? static_cast<uint16_t>(FEEDBACK_TIME_MS) : 0, gp_out.rumble_l, gp_out.rumble_r);
+    device.rumble = gp_out;
+    device.rumble_sent_ms = btstack_run_loop_get_time_ms();
+
+    if (active)
+    {
+        set_feedback_timer(index, RUMBLE_REFRESH_MS);
+    }
+    else
+    {
+        clear_feedback_timer(index);
+    }
+}
+
+static void feedback_timer_cb(btstack_timer_source *ts)
+{
+    const uint8_t index = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(ts->context));
+    bt_devices_[index].feedback_timer_set = false;
+    update_rumble(index);
+}
+
+static void feedback_posted_cb(void* context)
+{
+    const uint8_t index = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(context));
+    //Cleared first, a change that lands during the update posts again
+    bt_devices_[index].feedback_posted.store(false);
+    update_rumble(index);
+}
+
+//Gamepad pad out listener, runs on core0
+static void pad_out_changed(void* context)
+{
+    BTDevice& device = bt_devices_[reinterpret_cast<uintptr_t>(context)];
+    if (!device.feedback_posted.exchange(true))
+    {
+        btstack_run_loop_execute_on_main_thread(&device.feedback_cb_reg);
+    }
 }
 
 static void check_led_cb(btstack_timer_source *ts)
@@ -147,6 +230,7 @@ static void device_disconnected_cb(uni_hid_device_t* device) {
         return;
     }
 
+    OGXM_LOG_AT(BT, INFO, "BT: gamepad %i disconnected\n", idx);
     bt_devices_[idx].connected = false;
     bt_devices_[idx].gamepad->reset_pad_in();
 
@@ -157,10 +241,8 @@ static void device_disconnected_cb(uni_hid_device_t* device) {
         btstack_run_loop_set_timer(&led_timer_, LED_CHECK_TIME_MS);
         btstack_run_loop_add_timer(&led_timer_);
     }
-    if (feedback_timer_set_ && !any_connected()) {
-        feedback_timer_set_ = false;
-        btstack_run_loop_remove_timer(&feedback_timer_);
-    }
+    clear_feedback_timer(static_cast<uint8_t>(idx));
+    bt_devices_[idx].rumble = Gamepad::PadOut();
 }
 
 static uni_error_t device_ready_cb(uni_hid_device_t* device) {    
@@ -169,6 +251,7 @@ static uni_error_t device_ready_cb(uni_hid_device_t* device) {
         return UNI_ERROR_SUCCESS;
     }
 
+    OGXM_LOG_AT(BT, INFO, "BT: gamepad %i ready\n", idx);
     bt_devices_[idx].connected = true;
 
     if (led_timer_set_) {
@@ -176,13 +259,8 @@ static uni_error_t device_ready_cb(uni_hid_device_t* device) {
         btstack_run_loop_remove_timer(&led_timer_);
         board_api::set_led(true);
     }
-    if (!feedback_timer_set_) {
-        feedback_timer_set_ = true;
-        feedback_timer_.process = send_feedback_cb;
-        feedback_timer_.context = nullptr;
-        btstack_run_loop_set_timer(&feedback_timer_, FEEDBACK_TIME_MS);
-        btstack_run_loop_add_timer(&feedback_timer_);
-    }
+    //Picks up rumble that was already on before it connected
+    update_rumble(static_cast<uint8_t>(idx));
     return UNI_ERROR_SUCCESS;
 }
 
@@ -201,6 +279,7 @@ static void controller_data_cb(uni_hid_device_t* device, uni_controller_t* contr
     int idx = uni_hid_device_get_idx_for_instance(device);
 
     Gamepad* gamepad = bt_devices_[idx].gamepad;
+    gamepad->update_profile();
     Gamepad::PadIn gp_in;
 
     switch (uni_gp->dpad) 
@@ -292,6 +371,9 @@ void run_task(Gamepad(&gamepads)[MAX_GAMEPADS])
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
     {
         bt_devices_[i].gamepad = &gamepads[i];
+        bt_devices_[i].feedback_cb_reg.callback = feedback_posted_cb;
+        bt_devices_[i].feedback_cb_reg.context = reinterpret_cast<void*>(static_cast<uintptr_t>(i));
+        gamepads[i].set_pad_out_listener(pad_out_changed, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
     }
 
     uni_platform_set_custom(get_driver());
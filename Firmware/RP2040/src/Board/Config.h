@@ -17,6 +17,11 @@
     #define MAX_GAMEPADS 1
 #endif
 
+//Unchanged IN reports are only resent after this long, 0 sends every loop
+#ifndef IN_REPORT_KEEPALIVE_MS
+    #define IN_REPORT_KEEPALIVE_MS 100
+#endif
+
 #if defined(CONFIG_OGXM_BOARD_PI_PICO) || defined(CONFIG_OGXM_BOARD_PI_PICO2)
     #define OGXM_BOARD          PI_PICO
     #define PIO_USB_DP_PIN      0 // DM = 1
@@ -83,6 +88,7 @@
     #define MODE_SEL_PIN        21
     #define ESP_PROG_PIN        20 // ESP32 IO0
     #define ESP_RST_PIN         8  // ESP32 EN
+    #define ESP_DATA_READY_PIN  22 // Optional, a BlueRetro build that pulls it low per report, stock BlueRetro leaves it alone
 
     #if MAX_GAMEPADS > 1
         #undef MAX_GAMEPADS
@@ -101,10 +107,18 @@
 #if defined(CONFIG_OGXM_DEBUG)
     //Pins and port are defined in CMakeLists.txt
     #define DEBUG_UART_PORT __CONCAT(uart,PICO_DEFAULT_UART)
+
+    //Module logs more verbose than this are compiled out, see ogxm_log::Level
+    #if !defined(CONFIG_OGXM_LOG_LEVEL)
+        #define CONFIG_OGXM_LOG_LEVEL 4 //DEBUG
+    #endif
 #endif // defined(CONFIG_OGXM_DEBUG)
 
 #if defined(I2C_SDA_PIN)
-    #define I2C_BAUDRATE 400 * 1000
+    //Fm+, links that fail training or keep failing fall back to Fm then Sm
+    #define I2C_BAUDRATE    1000 * 1000
+    #define I2C_BAUDRATE_FM 400 * 1000
+    #define I2C_BAUDRATE_SM 100 * 1000
     #define I2C_PORT    ((I2C_SDA_PIN == 2 ) || \
                          (I2C_SDA_PIN == 6 ) || \
                          (I2C_SDA_PIN == 10) || \
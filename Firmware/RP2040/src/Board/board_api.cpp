@@ -1,3 +1,4 @@
+#include <atomic>
 #include <pico/stdlib.h>
 #include <pico/mutex.h>
 #include <pico/multicore.h>
@@ -14,6 +15,7 @@
 namespace board_api {
 
 mutex_t gpio_mutex_;
+std::atomic<bool> core1_stopped_{false};
 
 bool usb::host_connected() {
     if (board_api_usbh::host_connected) {
@@ -34,6 +36,7 @@ void usb::disconnect_all() {
 
     TaskQueue::suspend_delayed_tasks();
     multicore_reset_core1();
+    core1_stopped_.store(true);
     sleep_ms(500);
     tud_disconnect();
     sleep_ms(500);
@@ -71,6 +74,11 @@ uint32_t ms_since_boot() {
     return to_ms_since_boot(get_absolute_time());
 }
 
+//True once disconnect_all has reset core1, it's never relaunched before reboot
+bool core1_stopped() {
+    return core1_stopped_.load();
+}
+
 //Call after board is initialized
 void init_bluetooth() {
     if (board_api_bt::init) {
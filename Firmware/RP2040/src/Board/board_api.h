@@ -10,6 +10,7 @@ namespace board_api {
     void reboot();
     void set_led(bool state);
     uint32_t ms_since_boot();
+    bool core1_stopped();
 
     namespace usb {
         bool host_connected();
@@ -0,0 +1,19 @@
+#ifndef BOARD_CRC8_H
+#define BOARD_CRC8_H
+
+#include <cstdint>
+#include <cstddef>
+
+//CRC-8, polynomial 0x07, init 0. Guards the I2C packets, the ESP32 firmware computes the same.
+static inline uint8_t crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+#endif // BOARD_CRC8_H
@@ -2,15 +2,23 @@
 #if defined(CONFIG_OGXM_DEBUG)
 
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <array>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
 #include <pico/mutex.h>
+#include <pico/platform.h>
 #include <hardware/uart.h>
 #include <hardware/gpio.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
 
 #include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
 #include "Board/ogxm_log.h"
@@ -45,6 +53,131 @@ size_t usb_log_count = 0;
 mutex_t log_mutex;
 bool log_mutex_initialized = false;
 
+constexpr size_t TRACE_RING_SIZE = 64; //Records per core, power of 2
+constexpr uint8_t TRACE_FRAME_START = 0x1E; //ASCII record separator, never in text logs
+constexpr uint8_t TRACE_FRAME_TYPE = 'T';
+
+struct TraceRecord
+{
+    uint32_t fmt;
+    uint32_t time_us;
+    uint32_t args[TRACE_ARGS_MAX];
+};
+
+//Single producer (the owning core, interrupts masked while writing), single consumer (flush_trace)
+struct TraceRing
+{
+    std::array<TraceRecord, TRACE_RING_SIZE> records;
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    std::atomic<uint32_t> dropped{0};
+};
+
+static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE must be a power of 2");
+
+std::array<TraceRing, 2> trace_rings;
+
+/*  Debug UART output is queued here and drained by a DMA channel, logging never
+    waits on the UART. When the buffer is full the whole message is dropped and
+    counted, a notice goes out once there's room again. */
+constexpr size_t UART_TX_BUFFER_SIZE = 4096; //Power of 2
+constexpr uint UART_TX_DMA_IRQ = DMA_IRQ_1;
+
+static_assert((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) == 0, "UART_TX_BUFFER_SIZE must be a power of 2");
+
+std::array<uint8_t, UART_TX_BUFFER_SIZE> uart_tx_buffer{};
+//Free running indices, everything below is guarded by uart_tx_lock
+uint32_t uart_tx_head = 0;
+uint32_t uart_tx_tail = 0;
+uint32_t uart_tx_in_flight = 0;
+int uart_tx_dma = -1;
+spin_lock_t* uart_tx_lock = nullptr;
+UartStats uart_tx_stats{};
+uint32_t uart_tx_reported_drops = 0;
+
+//Call with uart_tx_lock held
+void uart_tx_start()
+{
+    if (uart_tx_dma < 0 || uart_tx_in_flight > 0 || uart_tx_head == uart_tx_tail)
+    {
+        return;
+    }
+    const uint32_t index = uart_tx_tail & (UART_TX_BUFFER_SIZE - 1);
+    uart_tx_in_flight = std::min(uart_tx_head - uart_tx_tail, static_cast<uint32_t>(UART_TX_BUFFER_SIZE - index));
+    dma_channel_transfer_from_buffer_now(static_cast<uint>(uart_tx_dma), &uart_tx_buffer[index], uart_tx_in_flight);
+}
+
+void uart_tx_dma_irq_handler()
+{
+    if (!dma_channel_get_irq1_status(static_cast<uint>(uart_tx_dma)))
+    {
+        return;
+    }
+    dma_channel_acknowledge_irq1(static_cast<uint>(uart_tx_dma));
+
+    uint32_t irq_state = spin_lock_blocking(uart_tx_lock);
+    uart_tx_tail += uart_tx_in_flight;
+    uart_tx_in_flight = 0;
+    uart_tx_start();
+    spin_unlock(uart_tx_lock, irq_state);
+}
+
+//All or nothing, returns false if the message doesn't fit
+bool uart_try_write(const uint8_t* data, size_t size)
+{
+    if (uart_tx_lock == nullptr || size > UART_TX_BUFFER_SIZE)
+    {
+        return false;
+    }
+
+    uint32_t irq_state = spin_lock_blocking(uart_tx_lock);
+    if (size > UART_TX_BUFFER_SIZE - (uart_tx_head - uart_tx_tail))
+    {
+        spin_unlock(uart_tx_lock, irq_state);
+        return false;
+    }
+
+    const uint32_t index = uart_tx_head & (UART_TX_BUFFER_SIZE - 1);
+    const size_t first = std::min(size, UART_TX_BUFFER_SIZE - index);
+    std::memcpy(&uart_tx_buffer[index], data, first);
+    std::memcpy(uart_tx_buffer.data(), data + first, size - first);
+    uart_tx_head += size;
+    uart_tx_start();
+
+    spin_unlock(uart_tx_lock, irq_state);
+    return true;
+}
+
+void uart_write(const uint8_t* data, size_t size)
+{
+    if (uart_try_write(data, size) || uart_tx_lock == nullptr)
+    {
+        return;
+    }
+    uint32_t irq_state = spin_lock_blocking(uart_tx_lock);
+    ++uart_tx_stats.dropped_messages;
+    uart_tx_stats.dropped_bytes += size;
+    spin_unlock(uart_tx_lock, irq_state);
+}
+
+//Call with log_mutex held
+void report_uart_drops()
+{
+    const UartStats stats = uart_stats();
+    if (stats.dropped_messages == uart_tx_reported_drops)
+    {
+        return;
+    }
+    char buffer[80];
+    int len = std::snprintf(buffer, sizeof(buffer), "OGXM: %lu log messages dropped (%lu bytes total), UART busy\n",
+                            static_cast<unsigned long>(stats.dropped_messages - uart_tx_reported_drops),
+                            static_cast<unsigned long>(stats.dropped_bytes));
+    if (len > 0 && uart_try_write(reinterpret_cast<const uint8_t*>(buffer), std::min(static_cast<size_t>(len), sizeof(buffer) - 1)))
+    {
+        uart_tx_reported_drops = stats.dropped_messages;
+    }
+}
+
 void ensure_log_mutex()
 {
     if (!log_mutex_initialized)
@@ -82,20 +215,124 @@ void push_usb_log_bytes(const uint8_t* data, size_t size)
 }
 } // namespace
 
+std::atomic<Level> module_levels[static_cast<uint8_t>(Module::COUNT)] = {
+    LEVEL_DEFAULT, LEVEL_DEFAULT, LEVEL_DEFAULT, LEVEL_DEFAULT, LEVEL_DEFAULT, LEVEL_DEFAULT, LEVEL_DEFAULT
+};
+static_assert(static_cast<uint8_t>(Module::COUNT) == 7, "Update module_levels initializer");
+
+bool set_level(Module module, Level level) {
+    if (module > Module::COUNT || level > Level::VERBOSE) {
+        return false;
+    }
+    if (module == Module::COUNT) {
+        for (auto& module_level : module_levels) {
+            module_level.store(level, std::memory_order_relaxed);
+        }
+    } else {
+        module_levels[static_cast<uint8_t>(module)].store(level, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+Level get_level(Module module) {
+    if (module >= Module::COUNT) {
+        return Level::NONE;
+    }
+    return module_levels[static_cast<uint8_t>(module)].load(std::memory_order_relaxed);
+}
+
 void init() {
     uart_init(DEBUG_UART_PORT, PICO_DEFAULT_UART_BAUD_RATE);
     gpio_set_function(PICO_DEFAULT_UART_TX_PIN, GPIO_FUNC_UART);
     gpio_set_function(PICO_DEFAULT_UART_RX_PIN, GPIO_FUNC_UART);
+
+    uart_tx_lock = spin_lock_instance(static_cast<uint>(spin_lock_claim_unused(true)));
+    uart_tx_dma = dma_claim_unused_channel(true);
+
+    dma_channel_config config = dma_channel_get_default_config(static_cast<uint>(uart_tx_dma));
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, uart_get_dreq(DEBUG_UART_PORT, true));
+    dma_channel_configure(static_cast<uint>(uart_tx_dma), &config, &uart_get_hw(DEBUG_UART_PORT)->dr, nullptr, 0, false);
+
+    dma_channel_set_irq1_enabled(static_cast<uint>(uart_tx_dma), true);
+    irq_add_shared_handler(UART_TX_DMA_IRQ, uart_tx_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(UART_TX_DMA_IRQ, true);
+}
+
+UartStats uart_stats() {
+    if (uart_tx_lock == nullptr) {
+        return uart_tx_stats;
+    }
+    uint32_t irq_state = spin_lock_blocking(uart_tx_lock);
+    const UartStats stats = uart_tx_stats;
+    spin_unlock(uart_tx_lock, irq_state);
+    return stats;
+}
+
+void trace_record(const char* fmt, const uint32_t (&args)[TRACE_ARGS_MAX]) {
+    TraceRing& ring = trace_rings[get_core_num()];
+    uint32_t irq_state = save_and_disable_interrupts();
+
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= TRACE_RING_SIZE) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        restore_interrupts(irq_state);
+        return;
+    }
+
+    TraceRecord& record = ring.records[head & (TRACE_RING_SIZE - 1)];
+    record.fmt = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fmt));
+    record.time_us = time_us_32();
+    std::copy(std::begin(args), std::end(args), record.args);
+    ring.head.store(head + 1, std::memory_order_release);
+
+    restore_interrupts(irq_state);
+}
+
+//Frame: start byte, type, core, record length, record (little endian words)
+void flush_trace() {
+    ensure_log_mutex();
+    if (!mutex_try_enter(&log_mutex, nullptr)) {
+        return;
+    }
+
+    for (uint8_t core = 0; core < trace_rings.size(); ++core) {
+        TraceRing& ring = trace_rings[core];
+        uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+
+        //Records stay in the ring while the UART buffer is full, they're only lost if the ring fills too
+        for (; tail != head; ++tail) {
+            uint8_t frame[4 + sizeof(TraceRecord)] = { TRACE_FRAME_START, TRACE_FRAME_TYPE, core, sizeof(TraceRecord) };
+            std::memcpy(&frame[4], &ring.records[tail & (TRACE_RING_SIZE - 1)], sizeof(TraceRecord));
+            if (!uart_try_write(frame, sizeof(frame))) {
+                break;
+            }
+            ring.tail.store(tail + 1, std::memory_order_release);
+        }
+
+        if (uint32_t dropped = ring.dropped.exchange(0, std::memory_order_relaxed)) {
+            char buffer[48];
+            int len = std::snprintf(buffer, sizeof(buffer), "OGXM: %lu trace records dropped on core %u\n", static_cast<unsigned long>(dropped), core);
+            uart_write(reinterpret_cast<const uint8_t*>(buffer), std::min(static_cast<size_t>(std::max(len, 0)), sizeof(buffer) - 1));
+        }
+    }
+
+    mutex_exit(&log_mutex);
 }
 
 void log(const std::string& message) {
+    flush_trace();
     ensure_log_mutex();
 
     mutex_enter_blocking(&log_mutex);
 
     std::string formatted_msg = "OGXM: " + message;
 
-    uart_puts(DEBUG_UART_PORT, formatted_msg.c_str());
+    report_uart_drops();
+    uart_write(reinterpret_cast<const uint8_t*>(formatted_msg.data()), formatted_msg.size());
     push_usb_log_bytes(reinterpret_cast<const uint8_t*>(formatted_msg.data()), formatted_msg.size());
 
     mutex_exit(&log_mutex);
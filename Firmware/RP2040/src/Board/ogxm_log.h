@@ -5,11 +5,36 @@
 #include <cstddef>
 
 #include "Board/Config.h"
+
+namespace ogxm_log {
+    enum class Module : uint8_t {
+        HOST_MANAGER = 0,
+        SWITCH_PRO,
+        XINPUT,
+        TASK_QUEUE,
+        NVS,
+        I2C,
+        BT,
+        COUNT
+    };
+
+    enum class Level : uint8_t {
+        NONE = 0,
+        ERROR,
+        WARN,
+        INFO,
+        DEBUG,
+        VERBOSE
+    };
+}
+
 #if defined(CONFIG_OGXM_DEBUG)
 
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <atomic>
+#include <type_traits>
 #include <stdarg.h>
 
 #include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
@@ -17,6 +42,20 @@
 std::ostream& operator<<(std::ostream& os, DeviceDriverType type);
 
 namespace ogxm_log {
+    //Levels above this are compiled out of OGXM_LOG_AT/OGXM_TRACE_AT
+    static constexpr Level LEVEL_FLOOR = static_cast<Level>(CONFIG_OGXM_LOG_LEVEL);
+    static constexpr Level LEVEL_DEFAULT = Level::INFO;
+
+    //Runtime threshold per module, only read through enabled()
+    extern std::atomic<Level> module_levels[static_cast<uint8_t>(Module::COUNT)];
+
+    inline bool enabled(Module module, Level level) {
+        return level <= module_levels[static_cast<uint8_t>(module)].load(std::memory_order_relaxed);
+    }
+    //Returns false if module or level is out of range, Module::COUNT sets every module
+    bool set_level(Module module, Level level);
+    Level get_level(Module module);
+
     void init() __attribute__((weak));
     //Don't use this directly, use the OGXM_LOG macro
     void log(const std::string& message);
@@ -27,6 +66,43 @@ namespace ogxm_log {
     bool usb_log_available();
     size_t read_usb_log(uint8_t* buffer, size_t size);
 
+    //Messages that didn't fit in the debug UART's DMA buffer
+    struct UartStats {
+        uint32_t dropped_messages;
+        uint32_t dropped_bytes;
+    };
+    UartStats uart_stats();
+
+    /*  Binary trace: OGXM_TRACE stores the format string's address, a timestamp and the
+        raw arguments in a per-core ring, no formatting or locking on the calling core.
+        flush_trace() sends the records out the debug UART as binary frames and
+        Tools/ogxm-trace-decode.py formats them against the firmware ELF. The format has
+        to be a string literal, %s arguments only decode if they point at one too. */
+    static constexpr size_t TRACE_ARGS_MAX = 8;
+
+    //Don't use this directly, use the OGXM_TRACE macro
+    void trace_record(const char* fmt, const uint32_t (&args)[TRACE_ARGS_MAX]);
+    //Call from core0's loop
+    void flush_trace();
+
+    template <typename T>
+    inline uint32_t trace_arg(T value) {
+        if constexpr (std::is_pointer_v<T>) {
+            return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value));
+        } else {
+            static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "OGXM_TRACE takes integers, enums and pointers");
+            return static_cast<uint32_t>(value);
+        }
+    }
+
+    //Don't use this directly, use the OGXM_TRACE macro
+    template <typename... Args>
+    inline void trace(const char* fmt, Args... args) {
+        static_assert(sizeof...(Args) <= TRACE_ARGS_MAX, "Too many OGXM_TRACE arguments");
+        const uint32_t words[TRACE_ARGS_MAX] = { trace_arg(args)... };
+        trace_record(fmt, words);
+    }
+
     template <typename T>
     std::string to_string(const T& value) {
         std::ostringstream stream;
@@ -37,6 +113,20 @@ namespace ogxm_log {
 
 #define OGXM_LOG ogxm_log::log
 #define OGXM_LOG_HEX ogxm_log::log_hex
+#define OGXM_TRACE ogxm_log::trace
+//Filtered by module and level, arguments aren't evaluated unless the message goes out
+#define OGXM_LOG_AT(module, level, ...) \
+    do { \
+        if constexpr (ogxm_log::Level::level <= ogxm_log::LEVEL_FLOOR) { \
+            if (ogxm_log::enabled(ogxm_log::Module::module, ogxm_log::Level::level)) { ogxm_log::log(__VA_ARGS__); } \
+        } \
+    } while (0)
+#define OGXM_TRACE_AT(module, level, ...) \
+    do { \
+        if constexpr (ogxm_log::Level::level <= ogxm_log::LEVEL_FLOOR) { \
+            if (ogxm_log::enabled(ogxm_log::Module::module, ogxm_log::Level::level)) { ogxm_log::trace(__VA_ARGS__); } \
+        } \
+    } while (0)
 #define OGXM_ASSERT(x) if (!(x)) { OGXM_LOG("Assertion failed: " #x); while(1); }
 #define OGXM_ASSERT_MSG(x, msg) if (!(x)) { OGXM_LOG("Assertion failed: " #x " " msg); while(1); }
 #define OGXM_TO_STRING ogxm_log::to_string
@@ -47,10 +137,16 @@ namespace ogxm_log {
     void init() __attribute__((weak));
     inline bool usb_log_available() { return false; }
     inline size_t read_usb_log(uint8_t* buffer, size_t size) { (void)buffer; return size ? 0 : 0; }
+    inline void flush_trace() {}
+    inline bool set_level(Module module, Level level) { (void)module; (void)level; return false; }
+    inline Level get_level(Module module) { (void)module; return Level::NONE; }
 }
 
 #define OGXM_LOG(...)
 #define OGXM_LOG_HEX(...)
+#define OGXM_TRACE(...)
+#define OGXM_LOG_AT(...)
+#define OGXM_TRACE_AT(...)
 #define OGXM_ASSERT(x)
 #define OGXM_ASSERT_MSG(x, msg)
 #define OGXM_TO_STRING(x)
@@ -0,0 +1,288 @@
+#ifndef _BUTTON_MAP_H_
+#define _BUTTON_MAP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Gamepad/Gamepad.h"
+
+/*  Table driven button/dpad translation for host drivers.
+
+    A driver describes its report once as a constexpr table of
+    (source byte offset, source mask) -> default Gamepad::BUTTON_* / Gamepad::DPAD_* bits,
+    plus an optional hat switch. Translator fuses that table with the user's profile
+    into one 256 entry LUT per source byte, rebuilt lazily when the profile changes,
+    so translating a report costs one halfword load per source byte.
+
+    Offsets are relative to whatever pointer the driver hands to translate(). */
+
+namespace ButtonMap
+{
+    struct Bit
+    {
+        uint8_t offset;
+        uint8_t mask;
+        uint16_t button;
+        uint8_t dpad;
+    };
+
+    struct Hat
+    {
+        uint8_t offset{0};
+        uint8_t mask{0}; //0 = no hat
+        //Masked source value for UP, UP_RIGHT, RIGHT, DOWN_RIGHT, DOWN, DOWN_LEFT, LEFT, UP_LEFT
+        std::array<uint8_t, 8> values{};
+    };
+
+    static_assert((Gamepad::BUTTON_A | Gamepad::BUTTON_B | Gamepad::BUTTON_X | Gamepad::BUTTON_Y |
+                   Gamepad::BUTTON_L3 | Gamepad::BUTTON_R3 | Gamepad::BUTTON_BACK | Gamepad::BUTTON_START |
+                   Gamepad::BUTTON_LB | Gamepad::BUTTON_RB | Gamepad::BUTTON_SYS | Gamepad::BUTTON_MISC) <= 0x0FFF,
+                  "ButtonMap packs buttons into 12 bits");
+
+    static constexpr std::array<uint8_t, 8> HAT_DIRECTIONS =
+    {
+        Gamepad::DPAD_UP,   Gamepad::DPAD_UP_RIGHT,  Gamepad::DPAD_RIGHT, Gamepad::DPAD_DOWN_RIGHT,
+        Gamepad::DPAD_DOWN, Gamepad::DPAD_DOWN_LEFT, Gamepad::DPAD_LEFT,  Gamepad::DPAD_UP_LEFT
+    };
+
+    //Any bit of mask set -> button, a mask of 0xFF means "source byte is nonzero"
+    static constexpr Bit button(uint8_t offset, uint8_t mask, uint16_t gp_button)
+    {
+        return { offset, mask, gp_button, 0 };
+    }
+
+    static constexpr Bit dpad(uint8_t offset, uint8_t mask, uint8_t gp_dpad)
+    {
+        return { offset, mask, 0, gp_dpad };
+    }
+
+    //Little endian 16 bit source field, mask must not span both bytes
+    static constexpr Bit button16(uint8_t offset, uint16_t mask, uint16_t gp_button)
+    {
+        return (mask & 0xFF) ? button(offset, static_cast<uint8_t>(mask), gp_button)
+                             : button(static_cast<uint8_t>(offset + 1), static_cast<uint8_t>(mask >> 8), gp_button);
+    }
+
+    //Hat switch with the usual 0 = UP, clockwise encoding
+    static constexpr Hat hat(uint8_t offset, uint8_t mask)
+    {
+        return { offset, mask, { 0, 1, 2, 3, 4, 5, 6, 7 } };
+    }
+
+    static constexpr Hat hat(uint8_t offset, uint8_t mask, const std::array<uint8_t, 8>& values)
+    {
+        return { offset, mask, values };
+    }
+
+    //Little endian 16 bit source field, mask must not span both bytes
+    static constexpr Hat hat16(uint8_t offset, uint16_t mask, const std::array<uint16_t, 8>& values)
+    {
+        const bool high = (mask & 0xFF) == 0;
+        Hat hat{ static_cast<uint8_t>(offset + (high ? 1 : 0)),
+                 static_cast<uint8_t>(high ? (mask >> 8) : mask), {} };
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            hat.values[i] = static_cast<uint8_t>(high ? (values[i] >> 8) : values[i]);
+        }
+        return hat;
+    }
+
+    template <size_t N>
+    struct Table
+    {
+        Hat hat;
+        std::array<Bit, N> bits;
+    };
+
+    template <typename... Bits>
+    constexpr Table<sizeof...(Bits)> make(const Hat& hat, Bits... bits)
+    {
+        return { hat, { bits... } };
+    }
+
+    template <typename... Bits>
+    constexpr Table<sizeof...(Bits)> make(Bits... bits)
+    {
+        return { Hat{}, { bits... } };
+    }
+
+    //A source byte gets a LUT if it holds a hat or any real bitmask,
+    //bytes only tested for nonzero (pressure buttons, bool arrays) are gathered directly
+    template <size_t N>
+    constexpr bool needs_lut(const Table<N>& table, size_t offset)
+    {
+        if (table.hat.mask && table.hat.offset == offset)
+        {
+            return true;
+        }
+        for (const Bit& bit : table.bits)
+        {
+            if (bit.offset == offset && bit.mask != 0xFF)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <size_t N>
+    constexpr size_t num_lut_offsets(const Table<N>& table)
+    {
+        size_t count = 0;
+        for (size_t offset = 0; offset < 256; ++offset)
+        {
+            if (needs_lut(table, offset))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    template <size_t N>
+    constexpr size_t num_direct_bits(const Table<N>& table)
+    {
+        size_t count = 0;
+        for (const Bit& bit : table.bits)
+        {
+            if (!needs_lut(table, bit.offset))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    template <const auto& TABLE>
+    constexpr auto lut_offsets()
+    {
+        std::array<uint8_t, num_lut_offsets(TABLE)> offsets{};
+        size_t idx = 0;
+        for (size_t offset = 0; offset < 256; ++offset)
+        {
+            if (needs_lut(TABLE, offset))
+            {
+                offsets[idx++] = static_cast<uint8_t>(offset);
+            }
+        }
+        return offsets;
+    }
+
+    template <const auto& TABLE>
+    constexpr auto direct_bits()
+    {
+        std::array<Bit, num_direct_bits(TABLE)> bits{};
+        size_t idx = 0;
+        for (const Bit& bit : TABLE.bits)
+        {
+            if (!needs_lut(TABLE, bit.offset))
+            {
+                bits[idx++] = bit;
+            }
+        }
+        return bits;
+    }
+
+    template <const auto& TABLE>
+    class Translator
+    {
+    public:
+        //ORs mapped buttons and dpad into gp_in
+        inline void translate(const Gamepad& gamepad, const uint8_t* src, Gamepad::PadIn& gp_in)
+        {
+            const uint32_t profile_version = gamepad.profile_version();
+            if (profile_version_ != profile_version)
+            {
+                build(gamepad, profile_version);
+            }
+
+            uint16_t entries = 0;
+
+            for (size_t i = 0; i < LUT_OFFSETS.size(); ++i)
+            {
+                entries |= lut_[i][src[LUT_OFFSETS[i]]];
+            }
+            for (size_t i = 0; i < DIRECT_BITS.size(); ++i)
+            {
+                if (src[DIRECT_BITS[i].offset])
+                {
+                    entries |= direct_[i];
+                }
+            }
+
+            gp_in.buttons |= (entries & BUTTONS_MASK);
+            gp_in.dpad |= static_cast<uint8_t>(entries >> DPAD_SHIFT);
+        }
+
+    private:
+        //Mapped buttons in the low 12 bits, mapped dpad in the high 4, one halfword per entry
+        static constexpr uint16_t BUTTONS_MASK = 0x0FFF;
+        static constexpr uint8_t DPAD_SHIFT = 12;
+
+        static constexpr auto LUT_OFFSETS = lut_offsets<TABLE>();
+        static constexpr auto DIRECT_BITS = direct_bits<TABLE>();
+
+        std::array<std::array<uint16_t, 256>, LUT_OFFSETS.size()> lut_{};
+        std::array<uint16_t, DIRECT_BITS.size()> direct_{};
+        uint32_t profile_version_{0};
+
+        static inline uint16_t entry(const Gamepad& gamepad, uint16_t buttons, uint8_t dpad)
+        {
+            return static_cast<uint16_t>((gamepad.map_buttons(buttons) & BUTTONS_MASK) |
+                                         (gamepad.map_dpad(dpad) << DPAD_SHIFT));
+        }
+
+        void build(const Gamepad& gamepad, uint32_t profile_version)
+        {
+            std::array<uint16_t, TABLE.bits.size()> mapped{};
+            for (size_t i = 0; i < TABLE.bits.size(); ++i)
+            {
+                mapped[i] = entry(gamepad, TABLE.bits[i].button, TABLE.bits[i].dpad);
+            }
+
+            std::array<uint16_t, HAT_DIRECTIONS.size()> mapped_hat{};
+            for (size_t dir = 0; dir < HAT_DIRECTIONS.size(); ++dir)
+            {
+                mapped_hat[dir] = entry(gamepad, 0, HAT_DIRECTIONS[dir]);
+            }
+
+            for (size_t i = 0; i < LUT_OFFSETS.size(); ++i)
+            {
+                for (size_t value = 0; value < 256; ++value)
+                {
+                    uint16_t lut_entry = 0;
+                    for (size_t j = 0; j < TABLE.bits.size(); ++j)
+                    {
+                        if (TABLE.bits[j].offset == LUT_OFFSETS[i] && (value & TABLE.bits[j].mask))
+                        {
+                            lut_entry |= mapped[j];
+                        }
+                    }
+                    if (TABLE.hat.mask && TABLE.hat.offset == LUT_OFFSETS[i])
+                    {
+                        for (size_t dir = 0; dir < HAT_DIRECTIONS.size(); ++dir)
+                        {
+                            if ((value & TABLE.hat.mask) == TABLE.hat.values[dir])
+                            {
+                                lut_entry |= mapped_hat[dir];
+                                break;
+                            }
+                        }
+                    }
+                    lut_[i][value] = lut_entry;
+                }
+            }
+
+            for (size_t i = 0; i < DIRECT_BITS.size(); ++i)
+            {
+                direct_[i] = entry(gamepad, DIRECT_BITS[i].button, DIRECT_BITS[i].dpad);
+            }
+
+            profile_version_ = profile_version;
+        }
+    };
+
+} // namespace ButtonMap
+
+#endif // _BUTTON_MAP_H_
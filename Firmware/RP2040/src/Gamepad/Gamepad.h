@@ -124,6 +124,7 @@ public:
     mutex_init(&pad_in_mutex_);
     mutex_init(&pad_out_mutex_);
     mutex_init(&chatpad_in_mutex_);
+    mutex_init(&profile_mutex_);
     reset_pad_in();
     reset_pad_out();
     reset_chatpad_in();
@@ -134,6 +135,7 @@ public:
   // Get
   inline bool new_pad_in() const { return new_pad_in_.load(); }
   inline bool new_pad_out() const { return new_pad_out_.load(); }
+  inline bool new_chatpad_in() const { return new_chatpad_in_.load(); }
 
   // True if both host and device have enabled analog
   inline bool analog_enabled() const {
@@ -161,6 +163,7 @@ public:
   inline ChatpadIn get_chatpad_in() {
     mutex_enter_blocking(&chatpad_in_mutex_);
     ChatpadIn chatpad_in = chatpad_in_;
+    new_chatpad_in_.store(false);
     mutex_exit(&chatpad_in_mutex_);
 
     return chatpad_in;
@@ -187,6 +190,60 @@ public:
   void set_profile(const UserProfile &user_profile) {
     set_profile_mappings(user_profile);
     set_profile_settings(user_profile);
+    profile_version_.fetch_add(1);
+  }
+
+  // Hands a profile to the core that maps input, safe to call from either core.
+  // Applied by the next update_profile(), a newer profile replaces one not yet applied.
+  void queue_profile(const UserProfile &user_profile) {
+    mutex_enter_blocking(&profile_mutex_);
+    pending_profile_ = user_profile;
+    new_profile_.store(true);
+    mutex_exit(&profile_mutex_);
+  }
+
+  // Call from the core that maps input, between reports
+  inline void update_profile() {
+    if (!new_profile_.load()) {
+      return;
+    }
+    mutex_enter_blocking(&profile_mutex_);
+    UserProfile user_profile = pending_profile_;
+    new_profile_.store(false);
+    mutex_exit(&profile_mutex_);
+
+    set_profile(user_profile);
+  }
+
+  // Bumped on every set_profile, lets cached mappings know to rebuild
+  inline uint32_t profile_version() const { return profile_version_.load(); }
+
+  // Translate default BUTTON_* bits to the profile's MAP_BUTTON_* values
+  uint16_t map_buttons(uint16_t buttons) const {
+    uint16_t mapped = 0;
+    if (buttons & BUTTON_A)     mapped |= MAP_BUTTON_A;
+    if (buttons & BUTTON_B)     mapped |= MAP_BUTTON_B;
+    if (buttons & BUTTON_X)     mapped |= MAP_BUTTON_X;
+    if (buttons & BUTTON_Y)     mapped |= MAP_BUTTON_Y;
+    if (buttons & BUTTON_L3)    mapped |= MAP_BUTTON_L3;
+    if (buttons & BUTTON_R3)    mapped |= MAP_BUTTON_R3;
+    if (buttons & BUTTON_BACK)  mapped |= MAP_BUTTON_BACK;
+    if (buttons & BUTTON_START) mapped |= MAP_BUTTON_START;
+    if (buttons & BUTTON_LB)    mapped |= MAP_BUTTON_LB;
+    if (buttons & BUTTON_RB)    mapped |= MAP_BUTTON_RB;
+    if (buttons & BUTTON_SYS)   mapped |= MAP_BUTTON_SYS;
+    if (buttons & BUTTON_MISC)  mapped |= MAP_BUTTON_MISC;
+    return mapped;
+  }
+
+  // Translate default DPAD_* bits to the profile's MAP_DPAD_* values
+  uint8_t map_dpad(uint8_t dpad) const {
+    uint8_t mapped = 0;
+    if (dpad & DPAD_UP)    mapped |= MAP_DPAD_UP;
+    if (dpad & DPAD_DOWN)  mapped |= MAP_DPAD_DOWN;
+    if (dpad & DPAD_LEFT)  mapped |= MAP_DPAD_LEFT;
+    if (dpad & DPAD_RIGHT) mapped |= MAP_DPAD_RIGHT;
+    return mapped;
   }
 
   inline void set_pad_in(PadIn pad_in) {
@@ -198,14 +255,29 @@ public:
 
   inline void set_pad_out(const PadOut &pad_out) {
     mutex_enter_blocking(&pad_out_mutex_);
+    const bool changed = std::memcmp(&pad_out_, &pad_out, sizeof(PadOut)) != 0;
     pad_out_ = pad_out;
     new_pad_out_.store(true);
     mutex_exit(&pad_out_mutex_);
+
+    PadOutListener listener = pad_out_listener_.load(std::memory_order_acquire);
+    if (changed && listener) {
+      listener(pad_out_listener_context_);
+    }
+  }
+
+  // Called on whichever core changed pad out, for consumers that sleep instead of
+  // polling new_pad_out(). Can be set while the other core is already using the gamepad.
+  using PadOutListener = void (*)(void *context);
+  void set_pad_out_listener(PadOutListener listener, void *context) {
+    pad_out_listener_context_ = context;
+    pad_out_listener_.store(listener, std::memory_order_release);
   }
 
   inline void set_chatpad_in(const ChatpadIn &chatpad_in) {
     mutex_enter_blocking(&chatpad_in_mutex_);
     chatpad_in_ = chatpad_in;
+    new_chatpad_in_.store(true);
     mutex_exit(&chatpad_in_mutex_);
   }
 
@@ -217,15 +289,13 @@ public:
   }
 
   inline void reset_pad_out() {
-    mutex_enter_blocking(&pad_out_mutex_);
-    pad_out_ = PadOut();
-    new_pad_out_.store(true);
-    mutex_exit(&pad_out_mutex_);
+    set_pad_out(PadOut());
   }
 
   inline void reset_chatpad_in() {
     mutex_enter_blocking(&chatpad_in_mutex_);
     chatpad_in_.fill(0);
+    new_chatpad_in_.store(true);
     mutex_exit(&chatpad_in_mutex_);
   }
 
@@ -307,6 +377,7 @@ private:
   mutex_t pad_in_mutex_;
   mutex_t pad_out_mutex_;
   mutex_t chatpad_in_mutex_;
+  mutex_t profile_mutex_;
 
   PadOut pad_out_;
   PadIn pad_in_;
@@ -314,11 +385,20 @@ private:
 
   std::atomic<bool> new_pad_in_{false};
   std::atomic<bool> new_pad_out_{false};
+  std::atomic<bool> new_chatpad_in_{false};
+
+  std::atomic<PadOutListener> pad_out_listener_{nullptr};
+  void *pad_out_listener_context_{nullptr};
 
   std::atomic<bool> analog_enabled_{false};
   std::atomic<bool> analog_host_{false};
   std::atomic<bool> analog_device_{false};
 
+  std::atomic<uint32_t> profile_version_{1};
+
+  UserProfile pending_profile_;
+  std::atomic<bool> new_profile_{false};
+
   bool profile_analog_enabled_{false};
 
   JoystickSettings joy_settings_l_;
@@ -333,8 +413,17 @@ private:
 
   void set_profile_settings(const UserProfile &profile) {
     profile_analog_enabled_ = profile.analog_enabled ? true : false;
+    analog_enabled_.store(analog_host_.load() && analog_device_.load() &&
+                          profile_analog_enabled_);
     OGXM_LOG("profile_analog_enabled_: %d\n", profile_analog_enabled_);
 
+    // Settings are only enabled if they differ from the defaults, compare
+    // against those and not whatever a previous profile left behind
+    joy_settings_l_ = JoystickSettings();
+    joy_settings_r_ = JoystickSettings();
+    trig_settings_l_ = TriggerSettings();
+    trig_settings_r_ = TriggerSettings();
+
     if ((joy_settings_l_en_ =
              !joy_settings_l_.is_same(profile.joystick_settings_l))) {
       joy_settings_l_.set_from_raw(profile.joystick_settings_l);
@@ -0,0 +1,382 @@
+#ifndef _REPORT_MAP_H_
+#define _REPORT_MAP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/Range.h"
+
+/*  Table driven IN report builder for device drivers, the output side counterpart of ButtonMap.
+
+    A driver describes once, as a constexpr table, where each Gamepad::BUTTON_*,
+    dpad direction, digital trigger, axis and pressure value lands in its report
+    and how it's encoded. Everything is resolved at compile time: buttons, dpad and
+    digital triggers become nibble indexed LUTs over up to 4 packed report bytes,
+    axes and pressure values become a short loop.
+
+    Offsets are relative to whatever pointer the driver hands to write(). Drivers keep
+    their table public so test/ReportMap_test.cpp can diff it against the old builders. */
+
+namespace ReportMap
+{
+    enum class Source : uint8_t
+    {
+        BUTTONS,
+        TRIGGER_L,
+        TRIGGER_R,
+        JOYSTICK_LX,
+        JOYSTICK_LY,
+        JOYSTICK_RX,
+        JOYSTICK_RY,
+    };
+
+    enum class Encoding : uint8_t
+    {
+        UINT8,              //Trigger value as is
+        INT16,              //Joystick value as is
+        INT16_INVERTED,     //Range::invert
+        UINT8_CENTERED,     //Scale::int16_to_uint8, 0x80 center
+        UINT8_DEADZONE,     //0-255 with a ~5% deadzone snapping to 0x80
+        UINT8_DEADZONE_7F,  //0-254 with a ~5% deadzone snapping to 0x7F (PS3)
+    };
+
+    struct Bit
+    {
+        Source source;
+        uint16_t button;
+        uint8_t offset;
+        uint8_t mask;
+    };
+
+    struct Axis
+    {
+        Source source;
+        Encoding encoding;
+        uint8_t offset;
+    };
+
+    //0xFF while pressed, or the Gamepad::analog value if the driver passes analog_enabled
+    struct Pressure
+    {
+        uint8_t offset;
+        uint8_t analog;
+        uint16_t button;
+        uint8_t dpad;
+    };
+
+    struct Dpad
+    {
+        uint8_t offset{0};
+        uint8_t size{0}; //0 = no dpad, else bytes written little endian
+        std::array<uint16_t, 16> values{}; //Indexed by Gamepad::PadIn::dpad
+    };
+
+    static constexpr uint8_t NO_ANALOG = 0xFF;
+    static constexpr int16_t DEADZONE = 1640; //~5% of 32768
+
+    static constexpr std::array<uint8_t, 8> DPAD_DIRECTIONS =
+    {
+        Gamepad::DPAD_UP,   Gamepad::DPAD_UP_RIGHT,  Gamepad::DPAD_RIGHT, Gamepad::DPAD_DOWN_RIGHT,
+        Gamepad::DPAD_DOWN, Gamepad::DPAD_DOWN_LEFT, Gamepad::DPAD_LEFT,  Gamepad::DPAD_UP_LEFT
+    };
+
+    static constexpr uint8_t dpad_size(uint16_t value)
+    {
+        return (value > 0xFF) ? 2 : 1;
+    }
+
+    //Hat switch, values for UP, UP_RIGHT, RIGHT, DOWN_RIGHT, DOWN, DOWN_LEFT, LEFT, UP_LEFT,
+    //center is written for anything else
+    static constexpr Dpad hat(uint8_t offset, const std::array<uint16_t, 8>& values, uint16_t center)
+    {
+        Dpad dpad{ offset, dpad_size(center), {} };
+        dpad.values.fill(center);
+        for (size_t i = 0; i < DPAD_DIRECTIONS.size(); ++i)
+        {
+            dpad.values[DPAD_DIRECTIONS[i]] = values[i];
+            dpad.size = (dpad_size(values[i]) > dpad.size) ? dpad_size(values[i]) : dpad.size;
+        }
+        return dpad;
+    }
+
+    //One bit per direction, only the 8 valid directions are written
+    static constexpr Dpad dpad_bits(uint8_t offset, uint16_t up, uint16_t down, uint16_t left, uint16_t right)
+    {
+        return hat(offset, { up, static_cast<uint16_t>(up | right), right, static_cast<uint16_t>(down | right),
+                             down, static_cast<uint16_t>(down | left), left, static_cast<uint16_t>(up | left) }, 0);
+    }
+
+    //Little endian field, mask must not span bytes
+    static constexpr Bit button(uint8_t offset, uint16_t mask, uint16_t gp_button)
+    {
+        return (mask & 0xFF) ? Bit{ Source::BUTTONS, gp_button, offset, static_cast<uint8_t>(mask) }
+                             : Bit{ Source::BUTTONS, gp_button, static_cast<uint8_t>(offset + 1), static_cast<uint8_t>(mask >> 8) };
+    }
+
+    //Set while the trigger is pressed at all
+    static constexpr Bit trigger(uint8_t offset, uint16_t mask, Source trigger_source)
+    {
+        Bit bit = button(offset, mask, 0);
+        bit.source = trigger_source;
+        return bit;
+    }
+
+    static constexpr Axis axis(uint8_t offset, Source source, Encoding encoding)
+    {
+        return { source, encoding, offset };
+    }
+
+    static constexpr Pressure pressure(uint8_t offset, uint8_t analog, uint16_t gp_button)
+    {
+        return { offset, analog, gp_button, 0 };
+    }
+
+    static constexpr Pressure pressure_dpad(uint8_t offset, uint8_t analog, uint8_t gp_dpad)
+    {
+        return { offset, analog, 0, gp_dpad };
+    }
+
+    template <size_t NB, size_t NA, size_t NP>
+    struct Table
+    {
+        Dpad dpad;
+        std::array<Bit, NB> bits;
+        std::array<Axis, NA> axes;
+        std::array<Pressure, NP> pressures;
+    };
+
+    template <size_t N, typename T>
+    constexpr std::array<T, N> to_array(const T (&items)[N])
+    {
+        std::array<T, N> array{};
+        for (size_t i = 0; i < N; ++i)
+        {
+            array[i] = items[i];
+        }
+        return array;
+    }
+
+    template <size_t NB, size_t NA>
+    constexpr Table<NB, NA, 0> make(const Dpad& dpad, const Bit (&bits)[NB], const Axis (&axes)[NA])
+    {
+        return { dpad, to_array(bits), to_array(axes), {} };
+    }
+
+    template <size_t NB, size_t NA, size_t NP>
+    constexpr Table<NB, NA, NP> make(const Dpad& dpad, const Bit (&bits)[NB], const Axis (&axes)[NA],
+                                     const Pressure (&pressures)[NP])
+    {
+        return { dpad, to_array(bits), to_array(axes), to_array(pressures) };
+    }
+
+    //Report bytes owned by the dpad and bits, cleared and rewritten on every write()
+    template <typename TABLE_T>
+    constexpr bool owns_byte(const TABLE_T& table, size_t offset)
+    {
+        if (table.dpad.size && offset >= table.dpad.offset && offset < table.dpad.offset + table.dpad.size)
+        {
+            return true;
+        }
+        for (const Bit& bit : table.bits)
+        {
+            if (bit.offset == offset)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename TABLE_T>
+    constexpr size_t num_owned_bytes(const TABLE_T& table)
+    {
+        size_t count = 0;
+        for (size_t offset = 0; offset < 256; ++offset)
+        {
+            if (owns_byte(table, offset))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    template <const auto& TABLE>
+    class Writer
+    {
+    public:
+        static inline void write(const Gamepad::PadIn& gp_in, bool analog_enabled, uint8_t* report)
+        {
+            uint32_t packed = DPAD_LUT[gp_in.dpad & 0x0F];
+            for (size_t nibble = 0; nibble < BUTTON_LUT.size(); ++nibble)
+            {
+                packed |= BUTTON_LUT[nibble][(gp_in.buttons >> (nibble * 4)) & 0x0F];
+            }
+            if (gp_in.trigger_l)
+            {
+                packed |= TRIGGER_L_BITS;
+            }
+            if (gp_in.trigger_r)
+            {
+                packed |= TRIGGER_R_BITS;
+            }
+            for (size_t i = 0; i < OWNED_BYTES.size(); ++i)
+            {
+                report[OWNED_BYTES[i]] = static_cast<uint8_t>(packed >> (i * 8));
+            }
+
+            for (const Axis& axis : TABLE.axes)
+            {
+                write_axis(gp_in, axis, report);
+            }
+
+            for (const Pressure& pressure : TABLE.pressures)
+            {
+                if (analog_enabled && pressure.analog != NO_ANALOG)
+                {
+                    report[pressure.offset] = gp_in.analog[pressure.analog];
+                }
+                else
+                {
+                    report[pressure.offset] = ((gp_in.buttons & pressure.button) || (gp_in.dpad & pressure.dpad))
+                                              ? Range::MAX<uint8_t> : 0;
+                }
+            }
+        }
+
+    private:
+        static_assert(num_owned_bytes(TABLE) <= 4, "ReportMap packs owned bytes into 32 bits");
+
+        static constexpr auto owned_bytes()
+        {
+            std::array<uint8_t, num_owned_bytes(TABLE)> offsets{};
+            size_t idx = 0;
+            for (size_t offset = 0; offset < 256; ++offset)
+            {
+                if (owns_byte(TABLE, offset))
+                {
+                    offsets[idx++] = static_cast<uint8_t>(offset);
+                }
+            }
+            return offsets;
+        }
+
+        static constexpr auto OWNED_BYTES = owned_bytes();
+
+        static constexpr uint32_t pack(uint8_t offset, uint8_t value)
+        {
+            for (size_t i = 0; i < OWNED_BYTES.size(); ++i)
+            {
+                if (OWNED_BYTES[i] == offset)
+                {
+                    return static_cast<uint32_t>(value) << (i * 8);
+                }
+            }
+            return 0;
+        }
+
+        static constexpr uint32_t pack_bits(Source source, uint16_t buttons)
+        {
+            uint32_t packed = 0;
+            for (const Bit& bit : TABLE.bits)
+            {
+                if (bit.source == source && (source != Source::BUTTONS || (bit.button & buttons)))
+                {
+                    packed |= pack(bit.offset, bit.mask);
+                }
+            }
+            return packed;
+        }
+
+        static constexpr auto dpad_lut()
+        {
+            std::array<uint32_t, 16> lut{};
+            for (size_t dpad = 0; dpad < lut.size() && TABLE.dpad.size; ++dpad)
+            {
+                for (size_t byte = 0; byte < TABLE.dpad.size; ++byte)
+                {
+                    lut[dpad] |= pack(static_cast<uint8_t>(TABLE.dpad.offset + byte),
+                                      static_cast<uint8_t>(TABLE.dpad.values[dpad] >> (byte * 8)));
+                }
+            }
+            return lut;
+        }
+
+        //Gamepad::BUTTON_* fit in 12 bits, see ButtonMap
+        static constexpr auto button_lut()
+        {
+            std::array<std::array<uint32_t, 16>, 3> lut{};
+            for (size_t nibble = 0; nibble < lut.size(); ++nibble)
+            {
+                for (size_t value = 0; value < 16; ++value)
+                {
+                    lut[nibble][value] = pack_bits(Source::BUTTONS, static_cast<uint16_t>(value << (nibble * 4)));
+                }
+            }
+            return lut;
+        }
+
+        static constexpr auto DPAD_LUT = dpad_lut();
+        static constexpr auto BUTTON_LUT = button_lut();
+        static constexpr uint32_t TRIGGER_L_BITS = pack_bits(Source::TRIGGER_L, 0);
+        static constexpr uint32_t TRIGGER_R_BITS = pack_bits(Source::TRIGGER_R, 0);
+
+        static inline int16_t joystick(const Gamepad::PadIn& gp_in, Source source)
+        {
+            switch (source)
+            {
+                case Source::JOYSTICK_LX: return gp_in.joystick_lx;
+                case Source::JOYSTICK_LY: return gp_in.joystick_ly;
+                case Source::JOYSTICK_RX: return gp_in.joystick_rx;
+                case Source::JOYSTICK_RY: return gp_in.joystick_ry;
+                default: return 0;
+            }
+        }
+
+        static inline uint8_t deadzone_to_uint8(int16_t value, uint8_t center, int32_t max)
+        {
+            if (value > -DEADZONE && value < DEADZONE)
+            {
+                return center;
+            }
+            return static_cast<uint8_t>(((static_cast<int32_t>(value) + 32768) * max) / 65535);
+        }
+
+        static inline void write_axis(const Gamepad::PadIn& gp_in, const Axis& axis, uint8_t* report)
+        {
+            switch (axis.encoding)
+            {
+                case Encoding::UINT8:
+                    report[axis.offset] = (axis.source == Source::TRIGGER_L) ? gp_in.trigger_l : gp_in.trigger_r;
+                    break;
+                case Encoding::INT16:
+                {
+                    const int16_t value = joystick(gp_in, axis.source);
+                    std::memcpy(report + axis.offset, &value, sizeof(value));
+                    break;
+                }
+                case Encoding::INT16_INVERTED:
+                {
+                    const int16_t value = Range::invert(joystick(gp_in, axis.source));
+                    std::memcpy(report + axis.offset, &value, sizeof(value));
+                    break;
+                }
+                case Encoding::UINT8_CENTERED:
+                    report[axis.offset] = Scale::int16_to_uint8(joystick(gp_in, axis.source));
+                    break;
+                case Encoding::UINT8_DEADZONE:
+                    report[axis.offset] = deadzone_to_uint8(joystick(gp_in, axis.source), 0x80, 255);
+                    break;
+                case Encoding::UINT8_DEADZONE_7F:
+                    report[axis.offset] = deadzone_to_uint8(joystick(gp_in, axis.source), 0x7F, 254);
+                    break;
+            }
+        }
+    };
+
+} // namespace ReportMap
+
+#endif // _REPORT_MAP_H_
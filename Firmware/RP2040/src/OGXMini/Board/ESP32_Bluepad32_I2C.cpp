@@ -3,7 +3,9 @@
 #if (OGXM_BOARD == ESP32_BLUEPAD32_I2C)
 
 #include <cstring>
+#include <atomic>
 #include <pico/multicore.h>
+#include <pico/flash.h>
 #include <pico/i2c_slave.h>
 #include <hardware/gpio.h>
 #include <hardware/i2c.h>
@@ -14,15 +16,23 @@
 #include "USBDevice/DeviceManager.h"
 #include "UserSettings/UserSettings.h"
 #include "Board/board_api.h"
+#include "Board/ogxm_log.h"
 #include "Board/esp32_api.h"
+#include "Board/crc8.h"
 #include "Gamepad/Gamepad.h"
 #include "TaskQueue/TaskQueue.h"
+#include "TaskQueue/Mailbox.h"
 
 enum class PacketID : uint8_t { 
     UNKNOWN = 0, 
     SET_PAD, 
     GET_PAD, 
-    SET_DRIVER 
+    SET_DRIVER,
+    LINK_TEST
+};
+enum class PacketResp : uint8_t { 
+    OK = 1, 
+    ERROR 
 };
 
 #pragma pack(push, 1)
@@ -44,71 +54,169 @@ struct PacketOut {
     uint8_t         reserved[3]{0};
 };
 static_assert(sizeof(PacketOut) == 8, "i2c_driver_esp::PacketOut size mismatch");
+
+//The ESP32 trains the link with these before sending pads, see I2CDriver::train_link
+struct LinkTest {
+    uint8_t     packet_len{sizeof(LinkTest)};
+    PacketID    packet_id{PacketID::LINK_TEST};
+    uint8_t     seq{0};
+    uint8_t     payload[28]{0};
+    uint8_t     crc{0};
+};
+static_assert(sizeof(LinkTest) == 32, "i2c_driver_esp::LinkTest size mismatch");
+
+struct LinkTestReply {
+    uint8_t     packet_len{sizeof(LinkTestReply)};
+    PacketID    packet_id{PacketID::LINK_TEST};
+    uint8_t     seq{0};
+    PacketResp  status{PacketResp::ERROR}; //OK if the test packet's CRC matched
+    uint8_t     pattern[3]{0x55, 0xAA, 0x0F};
+    uint8_t     crc{0};
+};
+static_assert(sizeof(LinkTestReply) == 8, "i2c_driver_esp::LinkTestReply size mismatch");
 #pragma pack(pop)
 
 constexpr size_t  MAX_BUFFER_SIZE = std::max(sizeof(PacketOut), sizeof(PacketIn));
+constexpr size_t  GET_PAD_LEN = 3; //len, GET_PAD, index, selects the pad the next read answers for
 constexpr uint8_t I2C_ADDR = 0x01;
 
 static Gamepad _gamepads[MAX_GAMEPADS];
 static bool _uart_bridge_mode = false;
 
+/*  The IRQ handler runs on core1 and only touches its own buffers. Pads go to and from core0
+    through mailboxes, driver changes are left to core0, and both replies fit the TX FIFO,
+    so the handler does bounded work and never takes a mutex. */
+static Mailbox<Gamepad::PadIn> _pad_in_mailboxes[MAX_GAMEPADS];     //IRQ -> core0
+static Mailbox<Gamepad::PadOut> _pad_out_mailboxes[MAX_GAMEPADS];   //Core0 -> IRQ
+static std::atomic<DeviceDriverType> _driver_request{DeviceDriverType::NONE};
+
+//Straight into the 16 byte TX FIFO, never waits
+static inline void write_reply(i2c_inst_t* i2c, const uint8_t* buffer, size_t len) {
+    static_assert(sizeof(PacketOut) <= 16 && sizeof(LinkTestReply) <= 16, "Replies must fit the TX FIFO");
+    i2c_hw_t* hw = i2c_get_hw(i2c);
+    for (size_t i = 0; i < len; ++i) {
+        hw->data_cmd = buffer[i];
+    }
+}
+
+//UNKNOWN unless the write is exactly as long as its packet says and its ID needs
+static inline PacketID get_packet_id(const uint8_t* buffer_in, size_t count) {
+    if (count < 2 || buffer_in[0] != count) {
+        return PacketID::UNKNOWN;
+    }
+    const PacketID packet_id = static_cast<PacketID>(buffer_in[1]);
+    switch (packet_id) {
+        case PacketID::SET_PAD:
+        case PacketID::SET_DRIVER:
+            return (count == sizeof(PacketIn)) ? packet_id : PacketID::UNKNOWN;
+        case PacketID::GET_PAD:
+            return (count == GET_PAD_LEN) ? packet_id : PacketID::UNKNOWN;
+        case PacketID::LINK_TEST:
+            return (count == sizeof(LinkTest)) ? packet_id : PacketID::UNKNOWN;
+        default:
+            return PacketID::UNKNOWN;
+    }
+}
+
 static inline void slave_handler(i2c_inst_t *i2c, i2c_slave_event_t event) {
     static size_t count = 0;
-    static PacketIn packet_in;
+    static uint8_t buffer_in[sizeof(PacketIn)];
+    static PacketIn packet_in; //Last accepted write, its index selects the pad for reads
     static PacketOut packet_out;
-    static DeviceDriverType current_device_type = 
-        UserSettings::get_instance().get_current_driver();
+    static LinkTestReply link_test_reply;
+    static bool link_test = false; //Next read gets link_test_reply
 
     switch (event) {
         case I2C_SLAVE_RECEIVE:
-            if (count < sizeof(PacketIn)) {
-                reinterpret_cast<uint8_t*>(&packet_in)[count] = i2c_read_byte_raw(i2c);
+            if (count < sizeof(buffer_in)) {
+                buffer_in[count] = i2c_read_byte_raw(i2c);
                 ++count;
+            } else {
+                (void)i2c_read_byte_raw(i2c);
+                count = SIZE_MAX; //Too long, never matches a length byte
             }
             break;
         case I2C_SLAVE_FINISH:
             if (count == 0) {
                 break;
             }
-            switch (packet_in.packet_id) {
+            switch (get_packet_id(buffer_in, count)) {
+                case PacketID::GET_PAD:
+                    packet_in.index = buffer_in[2];
+                    break;
                 case PacketID::SET_PAD:
+                    std::memcpy(&packet_in, buffer_in, sizeof(PacketIn));
                     if (packet_in.index < MAX_GAMEPADS) {
-                        _gamepads[packet_in.index].set_pad_in(packet_in.pad_in);
+                        _pad_in_mailboxes[packet_in.index].write(packet_in.pad_in);
                     }
                     break;
                 case PacketID::SET_DRIVER:
-                    if (packet_in.device_type != DeviceDriverType::NONE &&
-                        packet_in.device_type != current_device_type) {
-                        OGXM_LOG("I2C: Driver change detected.\n");
-                        //Any writes to flash should be done on Core0
-                        TaskQueue::Core0::queue_delayed_task(
-                            TaskQueue::Core0::get_new_task_id(), 1000, false, 
-                            [new_device_type = packet_in.device_type] { 
-                                UserSettings::get_instance().store_driver_type(new_device_type);
-                            }
-                        );
+                    std::memcpy(&packet_in, buffer_in, sizeof(PacketIn));
+                    if (packet_in.device_type != DeviceDriverType::NONE) {
+                        _driver_request.store(packet_in.device_type);
                     }
                     break;
+                case PacketID::LINK_TEST:
+                    link_test_reply = LinkTestReply();
+                    link_test_reply.seq = buffer_in[2];
+                    link_test_reply.status = (crc8(buffer_in, sizeof(LinkTest) - 1) == buffer_in[sizeof(LinkTest) - 1]) 
+                                             ? PacketResp::OK : PacketResp::ERROR;
+                    link_test_reply.crc = 
+                        crc8(reinterpret_cast<const uint8_t*>(&link_test_reply), sizeof(LinkTestReply) - 1);
+                    link_test = true;
+                    break;
                 default:
                     break;
             }
             count = 0;
             break;
         case I2C_SLAVE_REQUEST:
+            if (link_test) {
+                link_test = false;
+                write_reply(i2c, reinterpret_cast<const uint8_t*>(&link_test_reply), sizeof(LinkTestReply));
+                break;
+            }
             if (packet_in.index < MAX_GAMEPADS) {
                 packet_out.index = packet_in.index;
-                packet_out.pad_out = _gamepads[packet_in.index].get_pad_out();
+                _pad_out_mailboxes[packet_in.index].read(packet_out.pad_out);
             }
-            i2c_write_raw_blocking( i2c, 
-                                    reinterpret_cast<const uint8_t*>(&packet_out), 
-                                    packet_out.packet_len);
+            write_reply(i2c, reinterpret_cast<const uint8_t*>(&packet_out), sizeof(PacketOut));
             break;
         default:
             break;
     }
 }
 
+//Core0 side of the slave handoff
+static void process_slave() {
+    static DeviceDriverType current_device_type = UserSettings::get_instance().get_current_driver();
+
+    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
+        Gamepad::PadIn pad_in;
+        if (_pad_in_mailboxes[i].read(pad_in)) {
+            _gamepads[i].set_pad_in(pad_in);
+        }
+        if (_gamepads[i].new_pad_out()) {
+            _pad_out_mailboxes[i].write(_gamepads[i].get_pad_out());
+        }
+    }
+
+    const DeviceDriverType device_type = _driver_request.load();
+    if (device_type != DeviceDriverType::NONE && device_type != current_device_type) {
+        OGXM_LOG_AT(I2C, INFO, "I2C: Driver change detected.\n");
+        current_device_type = device_type;
+        //Give the ESP32 a moment before the flash write and reboot
+        TaskQueue::Core0::queue_delayed_task(
+            TaskQueue::Core0::get_new_task_id(), 1000, false, 
+            [device_type] { 
+                UserSettings::get_instance().store_driver_type(device_type);
+            }
+        );
+    }
+}
+
 static void core1_task() {
+    flash_safe_execute_core_init(); //Lets core0 park this core while it writes settings
     i2c_init(I2C_PORT, I2C_BAUDRATE);
 
     gpio_init(I2C_SDA_PIN);
@@ -120,7 +228,7 @@ static void core1_task() {
 
     i2c_slave_init(I2C_PORT, I2C_ADDR, &slave_handler);
 
-    OGXM_LOG("I2C Driver initialized\n");
+    OGXM_LOG_AT(I2C, INFO, "I2C Driver initialized\n");
 
     while (true) {
         tight_loop_contents();
@@ -184,11 +292,11 @@ void esp32_bp32_i2c::run() {
 
     while (true) {
         TaskQueue::Core0::process_tasks();
+        process_slave();
 
-        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-            device_driver->process(i, _gamepads[i]);
-            tud_task();
-        }
+        device_driver->process_all(_gamepads);
+        tud_task();
+        ogxm_log::flush_trace();
         sleep_ms(1);
     }
 }
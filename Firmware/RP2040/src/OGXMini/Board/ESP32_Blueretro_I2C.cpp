@@ -2,9 +2,14 @@
 #include "OGXMini/Board/ESP32_Blueretro_I2C.h"
 #if (OGXM_BOARD == ESP32_BLUERETRO_I2C)
 
+#include <atomic>
+#include <algorithm>
 #include <pico/multicore.h>
+#include <pico/flash.h>
+#include <pico/time.h>
 #include <hardware/gpio.h>
 #include <hardware/i2c.h>
+#include <hardware/irq.h>
 
 #include "tusb.h"
 #include "bsp/board_api.h"
@@ -12,6 +17,7 @@
 #include "UserSettings/UserSettings.h"
 #include "USBDevice/DeviceManager.h"
 #include "Board/board_api.h"
+#include "Board/ogxm_log.h"
 #include "Board/esp32_api.h"
 #include "Gamepad/Gamepad.h"
 #include "TaskQueue/TaskQueue.h"
@@ -37,32 +43,72 @@ static_assert(sizeof(PacketOut) == 8, "i2c_driver_esp::PacketOut size mismatch")
 constexpr uint8_t SLAVE_ADDR = 0x50;
 constexpr uint32_t FEEDBACK_DELAY_MS = 250;
 
+/*  Reports are read when ESP_DATA_READY_PIN falls. Neither stock BlueRetro nor the Bluepad32
+    firmware in Firmware/ESP32 drives that pin, only a BlueRetro build that pulls it low once
+    per report does. So the slave is polled every POLL_INTERVAL_US like before until
+    READY_EDGE_READS edge triggered reads in a row have each returned a report, no more than
+    READY_EDGE_WINDOW_US apart. Only then does the poll drop to READY_POLL_INTERVAL_US, in case
+    an edge gets missed, and it goes back to POLL_INTERVAL_US once the edges stop for
+    READY_EDGE_WINDOW_US. A floating or noisy line can't slow the reads down that way.
+    Failed reads back off from RETRY_MIN_US to RETRY_MAX_US, MAX_FAILURES in a row sends it
+    back to waiting for the slave. */
+constexpr uint32_t POLL_INTERVAL_US = 1000;
+constexpr uint32_t READY_POLL_INTERVAL_US = 20 * 1000;
+constexpr uint32_t READY_EDGE_WINDOW_US = 100 * 1000;
+constexpr uint8_t  READY_EDGE_READS = 8;
+constexpr uint32_t RETRY_MIN_US = 1000;
+constexpr uint32_t RETRY_MAX_US = 100 * 1000;
+constexpr uint8_t  MAX_FAILURES = 20;
+
 static Gamepad _gamepads[MAX_GAMEPADS];
 static bool _uart_bridge_mode = false;
+static std::atomic<bool> _data_ready{false};
+
+static void data_ready_irq_handler() {
+    if (gpio_get_irq_event_mask(ESP_DATA_READY_PIN) & GPIO_IRQ_EDGE_FALL) {
+        gpio_acknowledge_irq(ESP_DATA_READY_PIN, GPIO_IRQ_EDGE_FALL);
+        _data_ready.store(true);
+    }
+}
+
+static void init_data_ready() {
+    gpio_init(ESP_DATA_READY_PIN);
+    gpio_set_dir(ESP_DATA_READY_PIN, GPIO_IN);
+    gpio_pull_up(ESP_DATA_READY_PIN);
+    gpio_add_raw_irq_handler(ESP_DATA_READY_PIN, data_ready_irq_handler);
+    gpio_set_irq_enabled(ESP_DATA_READY_PIN, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+static bool slave_present() {
+    uint8_t addr = SLAVE_ADDR;
+    return (i2c_read_blocking(I2C_PORT, SLAVE_ADDR, &addr, 1, false) == 1);
+}
 
 static void core1_task() {
-    i2c_init(I2C_PORT, I2C_BAUDRATE);
+    flash_safe_execute_core_init(); //Lets core0 park this core while it writes settings
+    i2c_init(I2C_PORT, I2C_BAUDRATE_FM); //BlueRetro firmware, no link training
 
     gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
     gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SCL_PIN);
     gpio_pull_up(I2C_SDA_PIN);
 
-    bool slave_ready = false;
+    std::atomic<bool> slave_ready{false};
     PacketIn packet_in;
     PacketOut packet_out;
     Gamepad::PadIn pad_in;
     Gamepad& gamepad = _gamepads[0];
     uint32_t tid = TaskQueue::Core1::get_new_task_id();
 
+    init_data_ready();
+
     sleep_ms(500); // Wait for ESP32 to start
 
     TaskQueue::Core1::queue_delayed_task(tid, FEEDBACK_DELAY_MS, true, 
     [&packet_out, &gamepad, &slave_ready] { 
-        if (!slave_ready) { // Check if slave present
-            uint8_t addr = SLAVE_ADDR;
-            int result = i2c_read_blocking(I2C_PORT, SLAVE_ADDR, &addr, 1, false);
-            slave_ready = (result == 1);
+        if (!slave_ready.load()) { // Check if slave present
+            slave_ready.store(slave_present());
 
         } else { // Update rumble
             Gamepad::PadOut pad_out = gamepad.get_pad_out();
@@ -73,42 +119,79 @@ static void core1_task() {
                                             sizeof(PacketOut), false);
 
             if (result != sizeof(PacketOut)) {
-                OGXM_LOG("I2C write failed\n");
+                OGXM_LOG_AT(I2C, WARN, "I2C write failed\n");
             } else {
-                OGXM_LOG("I2C sent rumble, L: %02X, R: %02X\n", 
+                OGXM_LOG_AT(I2C, DEBUG, "I2C sent rumble, L: %02X, R: %02X\n", 
                     packet_out.rumble_l, packet_out.rumble_r);
                 sleep_ms(1);
             }
         }
     });
 
-    OGXM_LOG("I2C Driver initialized\n");
+    OGXM_LOG_AT(I2C, INFO, "I2C Driver initialized\n");
 
-    //Wait for slave to be detected
-    while (!slave_ready) {
-        TaskQueue::Core1::process_tasks();
-        sleep_ms(100);
-    }
-
-    OGXM_LOG("I2C Slave ready\n");
+    uint32_t retry_us = RETRY_MIN_US;
+    uint8_t failures = 0;
+    uint8_t edge_reads = 0; //Edge triggered reads in a row that returned a report
+    absolute_time_t last_edge = nil_time;
+    absolute_time_t next_read = get_absolute_time();
 
     while (true) {
-        TaskQueue::Core1::process_tasks();
-        int result = i2c_read_blocking( I2C_PORT, SLAVE_ADDR, 
-                                        reinterpret_cast<uint8_t*>(&packet_in), 
-                                        sizeof(PacketIn), false);
-
-        if (result == sizeof(PacketIn)) {
-            std::memcpy(reinterpret_cast<uint8_t*>(&pad_in), 
-                        packet_in.gp_data, 
-                        sizeof(packet_in.gp_data));
-            gamepad.set_pad_in(pad_in);
-
-        } else {
-            OGXM_LOG("I2C read failed\n");
-            return;
+        //Wait for slave to be detected
+        while (!slave_ready.load()) {
+            TaskQueue::Core1::process_tasks();
+            sleep_ms(100);
+        }
+        OGXM_LOG_AT(I2C, INFO, "I2C Slave ready\n");
+
+        while (slave_ready.load()) {
+            TaskQueue::Core1::process_tasks();
+
+            //Clear before reading, an edge that lands mid-read gets another one
+            const bool edge = _data_ready.load();
+            if (!edge && !time_reached(next_read)) {
+                //Any IRQ wakes this, the data ready edge included
+                best_effort_wfe_or_timeout(absolute_time_min(next_read, make_timeout_time_us(POLL_INTERVAL_US)));
+                continue;
+            }
+            _data_ready.store(false);
+
+            int result = i2c_read_blocking( I2C_PORT, SLAVE_ADDR, 
+                                            reinterpret_cast<uint8_t*>(&packet_in), 
+                                            sizeof(PacketIn), false);
+
+            if (result == sizeof(PacketIn)) {
+                std::memcpy(reinterpret_cast<uint8_t*>(&pad_in), 
+                            packet_in.gp_data, 
+                            sizeof(packet_in.gp_data));
+                gamepad.set_pad_in(pad_in);
+
+                retry_us = RETRY_MIN_US;
+                failures = 0;
+
+                const absolute_time_t now = get_absolute_time();
+                const bool edge_recent = absolute_time_diff_us(last_edge, now) <= READY_EDGE_WINDOW_US;
+                if (edge) {
+                    edge_reads = edge_recent ? std::min<uint8_t>(edge_reads + 1, READY_EDGE_READS) : 1;
+                    last_edge = now;
+                } else if (!edge_recent) {
+                    edge_reads = 0;
+                }
+                next_read = make_timeout_time_us((edge_reads >= READY_EDGE_READS) ? READY_POLL_INTERVAL_US : POLL_INTERVAL_US);
+
+            } else {
+                OGXM_LOG_AT(I2C, WARN, "I2C read failed, retrying in %u us\n", static_cast<unsigned>(retry_us));
+                next_read = make_timeout_time_us(retry_us);
+                retry_us = std::min(retry_us * 2, RETRY_MAX_US);
+
+                if (++failures >= MAX_FAILURES) {
+                    OGXM_LOG_AT(I2C, WARN, "I2C Slave lost\n");
+                    failures = 0;
+                    retry_us = RETRY_MIN_US;
+                    slave_ready.store(false);
+                }
+            }
         }
-        sleep_ms(1);
     }
 }
 
@@ -188,6 +271,7 @@ void esp32_br_i2c::run() {
         TaskQueue::Core0::process_tasks();
         device_driver->process(0, _gamepads[0]);
         tud_task();
+        ogxm_log::flush_trace();
         sleep_ms(1);
     }
 }
@@ -3,10 +3,15 @@
 #if ((OGXM_BOARD == INTERNAL_4CH_I2C) || (OGXM_BOARD == EXTERNAL_4CH_I2C))
 
 #include <atomic>
+#include <algorithm>
 #include <cstring>
 #include <pico/multicore.h>
+#include <pico/flash.h>
 #include <hardware/gpio.h>
 #include <hardware/i2c.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
 #include <pico/i2c_slave.h>
 
 #include "tusb.h"
@@ -17,11 +22,11 @@
 #include "USBHost/HostManager.h"
 #include "Board/board_api.h"
 #include "Board/ogxm_log.h"
+#include "Board/crc8.h"
 #include "UserSettings/UserSettings.h"
 #include "Gamepad/Gamepad.h"
 #include "TaskQueue/TaskQueue.h"
-
-constexpr uint32_t FEEDBACK_DELAY_MS = 250;
+#include "TaskQueue/Mailbox.h"
 
 Gamepad _gamepads[MAX_GAMEPADS];
 
@@ -33,12 +38,16 @@ namespace I2C {
     enum class PacketID : uint8_t { 
         UNKNOWN = 0, 
         PAD, 
-        COMMAND 
+        COMMAND,
+        PAD_V2,
+        LINK_TEST,
+        PAD_BURST
     };
     enum class Command : uint8_t { 
         UNKNOWN = 0, 
         STATUS, 
-        DISABLE 
+        DISABLE,
+        VERSION
     };
     enum class Status : uint8_t { 
         UNKNOWN = 0, 
@@ -72,39 +81,283 @@ namespace I2C {
         PacketID    packet_id{PacketID::COMMAND};
         Command     command{Command::UNKNOWN};
         Status      status{Status::UNKNOWN};
-        uint8_t     reserved[4]{0};
+        uint8_t     version{0}; //Command::VERSION reply, v1 slaves leave it 0
+        uint8_t     reserved[3]{0};
     };
     static_assert(sizeof(PacketCMD) == 8, "I2CDriver::PacketCMD is misaligned");
     #pragma pack(pop)
 
     constexpr size_t MAX_PACKET_SIZE = sizeof(PacketIn);
+    constexpr uint8_t PROTOCOL_VERSION = 2;
+
+    /*  Link training, v2 slaves only. A full size CRC'd write, the reply carries the CRC the
+        slave computed and a fixed pattern so both directions get checked. */
+    #pragma pack(push, 1)
+    struct LinkTest {
+        uint8_t     packet_len{sizeof(LinkTest)};
+        PacketID    packet_id{PacketID::LINK_TEST};
+        uint8_t     seq{0};
+        uint8_t     payload[28]{0};
+        uint8_t     crc{0};
+    };
+    static_assert(sizeof(LinkTest) == MAX_PACKET_SIZE, "I2CDriver::LinkTest is misaligned");
+
+    struct LinkTestReply {
+        uint8_t     packet_len{sizeof(LinkTestReply)};
+        PacketID    packet_id{PacketID::LINK_TEST};
+        uint8_t     seq{0};
+        Status      status{Status::UNKNOWN};    //OK if the test packet's CRC matched
+        uint8_t     pattern[3]{0x55, 0xAA, 0x0F};
+        uint8_t     crc{0};
+    };
+    static_assert(sizeof(LinkTestReply) == 8, "I2CDriver::LinkTestReply is misaligned");
+    #pragma pack(pop)
+
+    /*  Protocol v2, only used once Command::VERSION says the slave has it, v1 slaves keep
+        the STATUS + PAD exchange.
+        Master writes: len, PAD_V2, seq, change bitmap, the changed fields in bit order, CRC-8.
+        Slave replies: len, PAD_V2, seq, status, pad_out, CRC-8.
+        Fields are relative to the last state the slave acknowledged. A failed or rejected
+        exchange makes the next write carry every field, so does every FULL_INTERVAL'th. */
+    namespace V2 {
+        #pragma pack(push, 1)
+        struct PadState {
+            Gamepad::PadIn      pad_in{Gamepad::PadIn()};
+            Gamepad::ChatpadIn  chatpad_in{0};
+        };
+        static_assert(sizeof(PadState) == 26, "Update V2::FIELDS");
+
+        struct Reply {
+            uint8_t         packet_len{sizeof(Reply)};
+            PacketID        packet_id{PacketID::PAD_V2};
+            uint8_t         seq{0};
+            Status          status{Status::UNKNOWN};
+            Gamepad::PadOut pad_out{Gamepad::PadOut()};
+            uint8_t         crc{0};
+        };
+        static_assert(sizeof(Reply) == 7, "I2CDriver::V2::Reply is misaligned");
+        #pragma pack(pop)
+
+        struct Field {
+            uint8_t offset;
+            uint8_t len;
+        };
+        //Byte ranges of PadState, one bitmap bit each
+        static constexpr Field FIELDS[] = {
+            { 0,  3 }, //dpad, buttons
+            { 3,  2 }, //triggers
+            { 5,  4 }, //left stick
+            { 9,  4 }, //right stick
+            { 13, 5 }, //analog 0-4
+            { 18, 5 }, //analog 5-9
+            { 23, 3 }, //chatpad
+        };
+        static constexpr uint8_t NUM_FIELDS = sizeof(FIELDS) / sizeof(FIELDS[0]);
+        static constexpr uint8_t ALL_FIELDS = (1 << NUM_FIELDS) - 1;
+        static constexpr size_t HEADER_LEN = 4;
+        static constexpr uint8_t FULL_INTERVAL = 32;
+        static_assert(HEADER_LEN + sizeof(PadState) + 1 <= MAX_PACKET_SIZE, "I2CDriver::V2 packet too large");
+
+        static size_t fields_len(uint8_t bitmap) {
+            size_t len = 0;
+            for (uint8_t i = 0; i < NUM_FIELDS; ++i) {
+                if (bitmap & (1 << i)) {
+                    len += FIELDS[i].len;
+                }
+            }
+            return len;
+        }
+
+        //Writes the fields that differ from acked (all of them if full), returns the bitmap
+        static uint8_t encode_fields(uint8_t* buffer, const PadState& state, const PadState& acked, bool full) {
+            const uint8_t* current = reinterpret_cast<const uint8_t*>(&state);
+            const uint8_t* previous = reinterpret_cast<const uint8_t*>(&acked);
+            uint8_t bitmap = 0;
+
+            for (uint8_t i = 0; i < NUM_FIELDS; ++i) {
+                const Field& field = FIELDS[i];
+                if (full || std::memcmp(current + field.offset, previous + field.offset, field.len) != 0) {
+                    bitmap |= static_cast<uint8_t>(1 << i);
+                    std::memcpy(buffer, current + field.offset, field.len);
+                    buffer += field.len;
+                }
+            }
+            return bitmap;
+        }
+
+        static void apply_fields(const uint8_t* buffer, uint8_t bitmap, PadState& state) {
+            uint8_t* current = reinterpret_cast<uint8_t*>(&state);
+            for (uint8_t i = 0; i < NUM_FIELDS; ++i) {
+                if (bitmap & (1 << i)) {
+                    std::memcpy(current + FIELDS[i].offset, buffer, FIELDS[i].len);
+                    buffer += FIELDS[i].len;
+                }
+            }
+        }
+
+        //Returns the packet length
+        static uint8_t encode(uint8_t* buffer, uint8_t seq, const PadState& state, const PadState& acked, bool full) {
+            const uint8_t bitmap = encode_fields(buffer + HEADER_LEN, state, acked, full);
+            const uint8_t len = static_cast<uint8_t>(HEADER_LEN + fields_len(bitmap));
+            buffer[0] = len + 1;
+            buffer[1] = static_cast<uint8_t>(PacketID::PAD_V2);
+            buffer[2] = seq;
+            buffer[3] = bitmap;
+            buffer[len] = crc8(buffer, len);
+            return len + 1;
+        }
+
+        //False if the packet is malformed, the fields start at HEADER_LEN
+        static bool check(const uint8_t* buffer, size_t len, uint8_t& bitmap) {
+            if (len < HEADER_LEN + 1 || buffer[0] != len || crc8(buffer, len - 1) != buffer[len - 1]) {
+                return false;
+            }
+            bitmap = buffer[3];
+            return !(bitmap & ~ALL_FIELDS) && (HEADER_LEN + fields_len(bitmap) + 1) == len;
+        }
+
+        /*  Multi-pad burst, a single general call write to every v2 slave that's ready:
+            len, PAD_BURST, block count, per slave (address, seq, bitmap, fields), CRC-8.
+            Each slave applies its own block and answers its next read with a Reply, same as PAD_V2. */
+        static constexpr size_t BURST_HEADER_LEN = 3;
+        static constexpr size_t BLOCK_HEADER_LEN = 3;
+        static constexpr size_t MAX_BURST_SIZE = 
+            BURST_HEADER_LEN + (MAX_GAMEPADS - 1) * (BLOCK_HEADER_LEN + sizeof(PadState)) + 1;
+        static_assert(MAX_BURST_SIZE <= 0xFF, "I2CDriver::V2 burst too large");
+
+        //Finds address's block, false if the burst is malformed or doesn't have one
+        static bool find_block(const uint8_t* buffer, size_t len, uint8_t address, const uint8_t*& block) {
+            if (len < BURST_HEADER_LEN + 1 || buffer[0] != len || crc8(buffer, len - 1) != buffer[len - 1]) {
+                return false;
+            }
+            size_t offset = BURST_HEADER_LEN;
+            for (uint8_t i = 0; i < buffer[2]; ++i) {
+                if (offset + BLOCK_HEADER_LEN >= len) {
+                    return false;
+                }
+                const uint8_t bitmap = buffer[offset + 2];
+                const size_t block_len = BLOCK_HEADER_LEN + fields_len(bitmap);
+                if ((bitmap & ~ALL_FIELDS) || offset + block_len >= len) {
+                    return false;
+                }
+                if (buffer[offset] == address) {
+                    block = buffer + offset;
+                    return true;
+                }
+                offset += block_len;
+            }
+            return false;
+        }
+
+        static void seal(Reply& reply) {
+            reply.crc = crc8(reinterpret_cast<const uint8_t*>(&reply), sizeof(Reply) - 1);
+        }
+
+        static bool valid(const Reply& reply, uint8_t seq) {
+            return  reply.packet_len == sizeof(Reply) &&
+                    reply.packet_id == PacketID::PAD_V2 &&
+                    reply.seq == seq &&
+                    reply.crc == crc8(reinterpret_cast<const uint8_t*>(&reply), sizeof(Reply) - 1);
+        }
+    } // namespace V2
 
     static Role _i2c_role = Role::SLAVE;
 
     namespace Slave {
-        static inline PacketID get_packet_id(uint8_t* buffer_in) {
+        /*  The IRQ handler only works on its own buffers. Pads go to and from the thread through
+            mailboxes and host_mounted() is left to the thread, so the handler never takes a mutex.
+            Replies are composed at FINISH and fit the TX FIFO, so REQUEST never waits either. */
+        static constexpr size_t MAX_REPLY_SIZE = 8;
+        static constexpr size_t TX_FIFO_DEPTH = 16;
+        static_assert(  sizeof(PacketOut) <= MAX_REPLY_SIZE && sizeof(PacketCMD) <= MAX_REPLY_SIZE && 
+                        sizeof(V2::Reply) <= MAX_REPLY_SIZE && sizeof(LinkTestReply) <= MAX_REPLY_SIZE &&
+                        MAX_REPLY_SIZE <= TX_FIFO_DEPTH, "I2C::Slave replies must fit the TX FIFO");
+
+        static uint8_t _address = 0;
+        static bool _enabled = false;
+        static V2::PadState _v2_state;
+        static bool _v2_synced = false; //Deltas only apply on top of a full state
+        static Gamepad::PadOut _v2_pad_out;
+
+        static Mailbox<Gamepad::PadIn> _pad_in_mailbox;   //IRQ -> thread
+        static Mailbox<Gamepad::PadOut> _pad_out_mailbox; //Thread -> IRQ
+        static std::atomic<bool> _mount_request{false};
+        static std::atomic<bool> _unmount_request{false};
+
+        //PAD_V2 and PAD_BURST, the status rides along with every pad exchange
+        static void pad_v2(uint8_t seq, uint8_t bitmap, const uint8_t* fields, bool valid, uint8_t* buffer_out) {
+            const bool ready = !tuh_mounted(BOARD_TUH_RHPORT);
+            valid = valid && (_v2_synced || bitmap == V2::ALL_FIELDS);
+
+            V2::Reply* reply_p = reinterpret_cast<V2::Reply*>(buffer_out);
+            *reply_p = V2::Reply();
+            reply_p->seq = seq;
+            reply_p->status = !valid ? Status::ERROR : (ready ? Status::READY : Status::NOT_READY);
+
+            if (valid && ready) {
+                V2::apply_fields(fields, bitmap, _v2_state);
+                _v2_synced = true;
+                _pad_in_mailbox.write(_v2_state.pad_in);
+                _pad_out_mailbox.read(_v2_pad_out);
+                if (!_enabled) {
+                    _enabled = true;
+                    _mount_request.store(true);
+                }
+            }
+            reply_p->pad_out = _v2_pad_out;
+            V2::seal(*reply_p);
+        }
+
+        //UNKNOWN unless the write is exactly as long as its packet says and its ID needs
+        static inline PacketID get_packet_id(const uint8_t* buffer_in, size_t count) {
+            if (count < 2 || buffer_in[0] != count) {
+                return PacketID::UNKNOWN;
+            }
             switch (static_cast<PacketID>(buffer_in[1])) {
                 case PacketID::PAD:
-                    if (buffer_in[0] == sizeof(PacketIn)) {
+                    if (count == sizeof(PacketIn)) {
                         return PacketID::PAD;
                     }
                     break;
                 case PacketID::COMMAND:
-                    if (buffer_in[0] == sizeof(PacketCMD)) {
+                    if (count == sizeof(PacketCMD)) {
                         return PacketID::COMMAND;
                     }
                     break;
+                case PacketID::PAD_V2: //Fields checked in V2::check
+                    if (count >= V2::HEADER_LEN + 1 && count <= MAX_PACKET_SIZE) {
+                        return PacketID::PAD_V2;
+                    }
+                    break;
+                case PacketID::LINK_TEST:
+                    if (count == sizeof(LinkTest)) {
+                        return PacketID::LINK_TEST;
+                    }
+                    break;
+                case PacketID::PAD_BURST: //Blocks checked in V2::find_block
+                    if (count >= V2::BURST_HEADER_LEN + 1) {
+                        return PacketID::PAD_BURST;
+                    }
+                    break;
                 default:
                     break;
             }
             return PacketID::UNKNOWN;
         }
 
+        //Straight into the FIFO, MAX_REPLY_SIZE bytes always fit
+        static inline void write_reply(i2c_inst_t* i2c, const uint8_t* buffer) {
+            i2c_hw_t* hw = i2c_get_hw(i2c);
+            const size_t len = std::min<size_t>(buffer[0], MAX_REPLY_SIZE);
+            for (size_t i = 0; i < len; ++i) {
+                hw->data_cmd = buffer[i];
+            }
+        }
+
         static void slave_handler(i2c_inst_t *i2c, i2c_slave_event_t event) {
             static size_t count = 0;
-            static bool enabled = false;
-            static uint8_t buffer_in[MAX_PACKET_SIZE];
-            static uint8_t buffer_out[MAX_PACKET_SIZE];
+            static uint8_t buffer_in[V2::MAX_BURST_SIZE];
+            static uint8_t buffer_out[MAX_REPLY_SIZE];
 
             PacketIn  *packet_in_p = reinterpret_cast<PacketIn*>(buffer_in);
             PacketOut *packet_out_p = reinterpret_cast<PacketOut*>(buffer_out);
@@ -113,25 +366,27 @@ namespace I2C {
 
             switch (event) {
                 case I2C_SLAVE_RECEIVE: // master has written
-                    if (count < MAX_PACKET_SIZE) {
+                    if (count < sizeof(buffer_in)) {
                         buffer_in[count] = i2c_read_byte_raw(i2c);
                         ++count;
+                    } else {
+                        (void)i2c_read_byte_raw(i2c);
+                        count = SIZE_MAX; //Too long, never matches a length byte
                     }
                     break;
 
                 case I2C_SLAVE_FINISH:
                     // Each master write has an ID indicating the type of data to send back on the next read request
                     // Every write has an associated read
-                    switch (get_packet_id(buffer_in)) {
-                        case PacketID::PAD:
-                            // instance_->packet_in_ = *packet_in_p;
-                            // *packet_out_p = instance_->packet_out_;
-                            // instance_->new_pad_in_.store(true);
-                            _gamepads[0].set_pad_in(packet_in_p->pad_in);
-                            if (_gamepads[0].new_pad_out()) {
-                                packet_out_p->pad_out = _gamepads[0].get_pad_out();
+                    switch (get_packet_id(buffer_in, count)) {
+                        case PacketID::PAD: {
+                            _pad_in_mailbox.write(packet_in_p->pad_in);
+                            Gamepad::PadOut pad_out;
+                            if (_pad_out_mailbox.read(pad_out)) {
+                                packet_out_p->pad_out = pad_out;
                             }
                             break;
+                        }
 
                         case PacketID::COMMAND:
                             switch (packet_cmd_in_p->command) {
@@ -142,7 +397,7 @@ namespace I2C {
                                     packet_cmd_out_p->status = Status::OK;
 
                                     if (!tuh_mounted(BOARD_TUH_RHPORT)) {
-                                        four_ch_i2c::host_mounted(false);
+                                        _unmount_request.store(true);
                                     }
                                     break;
 
@@ -153,115 +408,759 @@ namespace I2C {
                                     packet_cmd_out_p->status = 
                                         tuh_mounted(BOARD_TUH_RHPORT) ? Status::NOT_READY : Status::READY;
 
-                                    if (!tuh_mounted(BOARD_TUH_RHPORT) && !enabled) {
-                                        enabled = true;
-                                        four_ch_i2c::host_mounted(true);
+                                    if (!tuh_mounted(BOARD_TUH_RHPORT) && !_enabled) {
+                                        _enabled = true;
+                                        _mount_request.store(true);
                                     }
                                     break;
 
+                                case Command::VERSION:
+                                    packet_cmd_out_p->packet_len = sizeof(PacketCMD);
+                                    packet_cmd_out_p->packet_id = PacketID::COMMAND;
+                                    packet_cmd_out_p->command = Command::VERSION;
+                                    packet_cmd_out_p->status = Status::OK;
+                                    packet_cmd_out_p->version = PROTOCOL_VERSION;
+                                    break;
+
                                 default:
                                     break;
                             }
                             break;
+
+                        case PacketID::PAD_V2: {
+                            uint8_t bitmap = 0;
+                            const bool valid = V2::check(buffer_in, count, bitmap);
+                            pad_v2(buffer_in[2], bitmap, buffer_in + V2::HEADER_LEN, valid, buffer_out);
+                            break;
+                        }
+
+                        case PacketID::PAD_BURST: {
+                            //A broken burst leaves the last reply, its seq won't match so the master resyncs
+                            const uint8_t* block = nullptr;
+                            if (V2::find_block(buffer_in, count, _address, block)) {
+                                pad_v2(block[1], block[2], block + V2::BLOCK_HEADER_LEN, true, buffer_out);
+                            }
+                            break;
+                        }
+
+                        case PacketID::LINK_TEST: {
+                            LinkTestReply* reply_p = reinterpret_cast<LinkTestReply*>(buffer_out);
+                            *reply_p = LinkTestReply();
+                            reply_p->seq = buffer_in[2];
+                            reply_p->status = (crc8(buffer_in, sizeof(LinkTest) - 1) == buffer_in[sizeof(LinkTest) - 1]) 
+                                              ? Status::OK : Status::ERROR;
+                            reply_p->crc = crc8(buffer_out, sizeof(LinkTestReply) - 1);
+                            break;
+                        }
+
+                        default:
+                            break;
                     }
                     count = 0;
-                    std::memset(buffer_in, 0, sizeof(buffer_in));
                     break;
 
                 case I2C_SLAVE_REQUEST:
-                    i2c_write_raw_blocking(i2c, buffer_out, buffer_out[0]);
+                    write_reply(i2c, buffer_out);
                     break;
 
                 default:
                     break;
             }
         }
+
+        //Thread side of the handoff
+        static void process() {
+            Gamepad& gamepad = _gamepads[0];
+            Gamepad::PadIn pad_in;
+            if (_pad_in_mailbox.read(pad_in)) {
+                gamepad.set_pad_in(pad_in);
+            }
+            if (gamepad.new_pad_out()) {
+                _pad_out_mailbox.write(gamepad.get_pad_out());
+            }
+            if (_mount_request.load()) {
+                _mount_request.store(false);
+                four_ch_i2c::host_mounted(true);
+            }
+            if (_unmount_request.load()) {
+                _unmount_request.store(false);
+                four_ch_i2c::host_mounted(false);
+            }
+        }
     } // namespace Slave
 
     namespace Master {
+        /*  Exchanges packets with the slaves in the background. Every exchange is a STOP terminated
+            write followed by a read, like before. The bytes go through two DMA channels, command words
+            out and data in. The I2C IRQ (STOP_DET, TX_ABRT) moves on to the next step or slave, so
+            core0 only copies pads in and out in process(). The IRQ is on core0 as well, so turning
+            interrupts off is all the locking needed. Anything logged from the IRQ or with interrupts
+            off goes through OGXM_TRACE_AT, OGXM_LOG_AT allocates and takes a mutex.
+            Slaves are polled with STATUS first, same as v1. VERSION only goes to a slave that sent
+            back a well-formed STATUS reply, a v1 slave that hasn't replied to anything yet has
+            nothing to send and can hold the bus. v2 slaves then get a single PAD_V2 exchange per
+            pass with their status folded into the reply.
+            The bus starts at Fm+. Each v2 slave has to pass LINK_TEST_PACKETS test packets before
+            it gets pads, a failure drops the bus a speed and starts its test over. v1 slaves cap
+            the bus at Fm. After that the bus drops a speed whenever more than LINK_ERROR_LIMIT of
+            LINK_WINDOW exchanges with known slaves fail. It never goes back up until reboot.
+            Work is planned in laps. When two or more v2 slaves are ready their pads share one
+            general call PAD_BURST write and each is only read back on its own. Disabling every
+            slave is a single general call DISABLE, the replies are then read one by one. */
+        enum class Step : uint8_t {
+            IDLE = 0,
+            STATUS_WRITE,
+            STATUS_READ,
+            PAD_WRITE,
+            PAD_READ,
+            DISABLE_WRITE,
+            DISABLE_READ,
+            VERSION_WRITE,
+            VERSION_READ,
+            PAD_V2_WRITE,
+            PAD_V2_READ,
+            LINK_TEST_WRITE,
+            LINK_TEST_READ,
+            BURST_WRITE,
+            BROADCAST_DISABLE_WRITE
+        };
+
         struct Slave {
-            uint8_t address{0xFF};
-            Status  status{Status::NC};
-            bool    enabled{false};
+            uint8_t     address{0xFF};
+            Status      status{Status::UNKNOWN};
+            bool        enabled{false};
+            uint8_t     disable_retries{0}; //DISABLE attempts left, 0 if none pending
+            bool        disable_sent{false};//Broadcast DISABLE went out, read the reply before writing again
+            uint32_t    status_time_us{0};
+            uint8_t     version{0};         //Protocol version, 0 until negotiated
+            uint8_t     seq{0};
+            bool        resync{true};       //Next PAD_V2 write carries every field
+            uint8_t     link_tests{0};      //Test packets left to pass at the current speed
+            V2::PadState acked;             //Last state the slave acknowledged
+            V2::PadState sent;              //State in the PAD_V2 write or burst block awaiting its reply
+            PacketIn    packet_in;          //Newest pad from core0
+            PacketOut   packet_out;         //Newest reply for core0
+            bool        new_packet_out{false};
         };
 
         static constexpr size_t NUM_SLAVES = MAX_GAMEPADS - 1;
         static_assert(NUM_SLAVES > 0, "I2CMaster::NUM_SLAVES must be greater than 0 to use I2C");
+        static_assert(NUM_SLAVES <= 8, "I2CMaster lap masks are 8 bits");
+
+        static constexpr uint32_t GENERAL_CALL = I2C_IC_TAR_SPECIAL_BITS; //GC_OR_START 0 = general call
+
+        static constexpr uint8_t  DISABLE_RETRIES = 10;
+        static constexpr uint32_t STATUS_INTERVAL_US = 100 * 1000;
+        static constexpr uint32_t TRANSFER_MARGIN_US = 5 * 1000; //On top of the time on the wire
+
+        static constexpr uint32_t LINK_SPEEDS[] = { I2C_BAUDRATE, I2C_BAUDRATE_FM, I2C_BAUDRATE_SM };
+        static constexpr uint8_t  NUM_LINK_SPEEDS = sizeof(LINK_SPEEDS) / sizeof(LINK_SPEEDS[0]);
+        static constexpr uint8_t  LINK_SPEED_V1 = 1; //Fm, what v1 slaves were built for
+        static constexpr uint8_t  LINK_TEST_PACKETS = 8;
+        static constexpr uint16_t LINK_WINDOW = 256;
+        static constexpr uint16_t LINK_ERROR_LIMIT = 8;
 
         std::array<Slave, NUM_SLAVES> _slaves; 
 
-        static inline bool read_blocking(uint8_t address, void* buffer, size_t len) {
-            return (i2c_read_blocking(  I2C_PORT, address, reinterpret_cast<uint8_t*>(buffer), 
-                                        len, false) == static_cast<int>(len));
+        //Owned by the IRQ while _step != Step::IDLE
+        static Step _step = Step::IDLE;
+        static uint8_t _slave_idx = 0;
+        static bool _transfer_read = false;
+        static bool _transfer_failed = false;
+        static uint32_t _transfer_start_us = 0;
+        static uint32_t _transfer_timeout_us = 0;
+        static PacketCMD _packet_cmd;
+        static PacketIn _packet_in;
+        static PacketOut _packet_out;
+        static V2::Reply _v2_reply;
+        static std::array<uint8_t, MAX_PACKET_SIZE> _v2_buffer;
+        static LinkTest _link_test;
+        static LinkTestReply _link_test_reply;
+        static uint8_t _link_speed = 0;     //Index into LINK_SPEEDS
+        static uint16_t _link_transfers = 0;
+        static uint16_t _link_errors = 0;
+        static std::array<uint8_t, V2::MAX_BURST_SIZE> _burst_buffer;
+        static uint8_t _lap_pending = 0;    //Slaves still to visit this lap, one bit each
+        static uint8_t _burst_reads = 0;    //Slaves in the last burst whose reply hasn't been read
+        static bool _broadcast_disable = false;
+        static std::array<uint32_t, V2::MAX_BURST_SIZE> _cmd_words;
+        static uint _dma_tx = 0;
+        static uint _dma_rx = 0;
+
+        static void reset_bus() {
+            i2c_init(I2C_PORT, LINK_SPEEDS[_link_speed]);
+            i2c_get_hw(I2C_PORT)->intr_mask = I2C_IC_INTR_MASK_M_TX_ABRT_BITS | I2C_IC_INTR_MASK_M_STOP_DET_BITS;
         }
 
-        static inline bool write_blocking(uint8_t address, void* buffer, size_t len) {
-            return (i2c_write_blocking( I2C_PORT, address, reinterpret_cast<uint8_t*>(buffer), 
-                                        len, false) == static_cast<int>(len));
+        //Address and data bytes at 9 clocks each on the current link, plus the margin for clock
+        //stretching and the IRQ. A full burst at Sm is ~8 ms on the wire alone.
+        static uint32_t transfer_timeout_us(size_t len) {
+            const uint64_t wire_us = ((len + 1) * 9 * 1000000ULL) / LINK_SPEEDS[_link_speed];
+            return static_cast<uint32_t>(wire_us) + TRANSFER_MARGIN_US;
+        }
+
+        static void start_transfer(uint32_t target, void* buffer, size_t len, bool read) {
+            i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+            hw->enable = 0;
+            hw->tar = target;
+            hw->enable = 1;
+
+            const uint8_t* data = static_cast<const uint8_t*>(buffer);
+            for (size_t i = 0; i < len; ++i) {
+                _cmd_words[i] = (read ? I2C_IC_DATA_CMD_CMD_BITS : data[i]) | 
+                                ((i == len - 1) ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+            }
+
+            _transfer_read = read;
+            _transfer_failed = false;
+            _transfer_start_us = time_us_32();
+            _transfer_timeout_us = transfer_timeout_us(len);
+
+            if (read) {
+                dma_channel_transfer_to_buffer_now(_dma_rx, buffer, len);
+            }
+            dma_channel_transfer_from_buffer_now(_dma_tx, _cmd_words.data(), len);
         }
 
-        static inline bool slave_detected(uint8_t address) {
-            uint8_t dummy = 0;
-            int result = i2c_write_timeout_us(I2C_PORT, address, &dummy, 0, false, 1000);
-            return (result >= 0);
+        static bool full_write(const Slave& slave) {
+            return slave.resync || (slave.seq % V2::FULL_INTERVAL) == 0;
         }
 
-        static void notify_disable(uint8_t address) {
-            if (!slave_detected(address)) {
+        static void start_step(Step step) {
+            Slave& slave = _slaves[_slave_idx];
+            _step = step;
+
+            switch (step) {
+                case Step::STATUS_WRITE:
+                case Step::DISABLE_WRITE:
+                case Step::VERSION_WRITE:
+                    _packet_cmd = PacketCMD();
+                    _packet_cmd.command =   (step == Step::STATUS_WRITE) ? Command::STATUS : 
+                                            (step == Step::DISABLE_WRITE) ? Command::DISABLE : Command::VERSION;
+                    start_transfer(slave.address, &_packet_cmd, sizeof(PacketCMD), false);
+                    break;
+
+                case Step::STATUS_READ:
+                case Step::DISABLE_READ:
+                case Step::VERSION_READ:
+                    start_transfer(slave.address, &_packet_cmd, sizeof(PacketCMD), true);
+                    break;
+
+                case Step::PAD_V2_WRITE: {
+                    slave.sent.pad_in = slave.packet_in.pad_in;
+                    slave.sent.chatpad_in = slave.packet_in.chatpad_in;
+                    const uint8_t len = V2::encode(_v2_buffer.data(), slave.seq, slave.sent, slave.acked, full_write(slave));
+                    start_transfer(slave.address, _v2_buffer.data(), len, false);
+                    break;
+                }
+
+                case Step::BURST_WRITE: {
+                    uint8_t* buffer = _burst_buffer.data();
+                    size_t len = V2::BURST_HEADER_LEN;
+                    uint8_t count = 0;
+                    for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                        if (!(_burst_reads & (1 << i))) {
+                            continue;
+                        }
+                        Slave& burst_slave = _slaves[i];
+                        burst_slave.sent.pad_in = burst_slave.packet_in.pad_in;
+                        burst_slave.sent.chatpad_in = burst_slave.packet_in.chatpad_in;
+
+                        uint8_t* block = buffer + len;
+                        block[0] = burst_slave.address;
+                        block[1] = burst_slave.seq;
+                        block[2] = V2::encode_fields(block + V2::BLOCK_HEADER_LEN, burst_slave.sent, 
+                                                     burst_slave.acked, full_write(burst_slave));
+                        len += V2::BLOCK_HEADER_LEN + V2::fields_len(block[2]);
+                        ++count;
+                    }
+                    buffer[0] = static_cast<uint8_t>(len + 1);
+                    buffer[1] = static_cast<uint8_t>(PacketID::PAD_BURST);
+                    buffer[2] = count;
+                    buffer[len] = crc8(buffer, len);
+                    start_transfer(GENERAL_CALL, buffer, len + 1, false);
+                    break;
+                }
+
+                case Step::BROADCAST_DISABLE_WRITE:
+                    _packet_cmd = PacketCMD();
+                    _packet_cmd.command = Command::DISABLE;
+                    start_transfer(GENERAL_CALL, &_packet_cmd, sizeof(PacketCMD), false);
+                    break;
+
+                case Step::PAD_V2_READ:
+                    _v2_reply = V2::Reply();
+                    start_transfer(slave.address, &_v2_reply, sizeof(V2::Reply), true);
+                    break;
+
+                case Step::LINK_TEST_WRITE:
+                    _link_test = LinkTest();
+                    _link_test.seq = slave.link_tests;
+                    for (uint8_t i = 0; i < sizeof(_link_test.payload); ++i) {
+                        _link_test.payload[i] = static_cast<uint8_t>(((i & 1) ? 0xAA : 0x55) ^ (slave.address + i * slave.link_tests));
+                    }
+                    _link_test.crc = crc8(reinterpret_cast<const uint8_t*>(&_link_test), sizeof(LinkTest) - 1);
+                    start_transfer(slave.address, &_link_test, sizeof(LinkTest), false);
+                    break;
+
+                case Step::LINK_TEST_READ:
+                    _link_test_reply = LinkTestReply();
+                    start_transfer(slave.address, &_link_test_reply, sizeof(LinkTestReply), true);
+                    break;
+
+                case Step::PAD_WRITE:
+                    _packet_in = slave.packet_in;
+                    start_transfer(slave.address, &_packet_in, sizeof(PacketIn), false);
+                    break;
+
+                case Step::PAD_READ:
+                    start_transfer(slave.address, &_packet_out, sizeof(PacketOut), true);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        static Step first_step(const Slave& slave) {
+            if (slave.disable_retries > 0) {
+                return slave.disable_sent ? Step::DISABLE_READ : Step::DISABLE_WRITE;
+            }
+            if (!slave.enabled) {
+                return Step::IDLE;
+            }
+            const bool status_due = (slave.status == Status::UNKNOWN) || 
+                                    ((time_us_32() - slave.status_time_us) >= STATUS_INTERVAL_US);
+            if (slave.version == 0) {
+                return status_due ? Step::STATUS_WRITE : Step::IDLE;
+            }
+            if (slave.link_tests > 0) {
+                return Step::LINK_TEST_WRITE;
+            }
+            if (slave.version >= 2) {
+                //Every PAD_V2 reply carries the status, so it doubles as the status poll
+                return (status_due || slave.status == Status::READY) ? Step::PAD_V2_WRITE : Step::IDLE;
+            }
+            if (status_due) {
+                return Step::STATUS_WRITE;
+            }
+            return (slave.status == Status::READY) ? Step::PAD_WRITE : Step::IDLE;
+        }
+
+        //Slave NACKed its address, it may come back running something else
+        static void slave_lost(Slave& slave) {
+            slave.status = Status::NC;
+            slave.status_time_us = time_us_32();
+            slave.version = 0;
+            slave.resync = true;
+            slave.link_tests = 0;
+        }
+
+        //Bus is idle between transfers, safe to call from the IRQ
+        static void set_link_speed(uint8_t speed) {
+            if (speed == _link_speed || speed >= NUM_LINK_SPEEDS) {
+                return;
+            }
+            _link_speed = speed;
+            _link_transfers = 0;
+            _link_errors = 0;
+            reset_bus();
+            for (auto& slave : _slaves) {
+                slave.resync = true;
+            }
+            OGXM_TRACE_AT(I2C, INFO, "I2C: Link speed %u kHz\n", static_cast<unsigned>(LINK_SPEEDS[_link_speed] / 1000));
+        }
+
+        //Counts exchanges with slaves known to be on the bus, too many failures drop the bus a speed
+        static void link_result(const Slave& slave, bool ok) {
+            if (slave.version == 0 || slave.link_tests > 0) {
                 return;
             }
-            int retries = 10;
+            ++_link_transfers;
+            if (!ok) {
+                ++_link_errors;
+            }
+            if (_link_errors > LINK_ERROR_LIMIT) {
+                OGXM_TRACE_AT(I2C, WARN, "I2C: %u of %u transfers failed\n", _link_errors, _link_transfers);
+                set_link_speed(_link_speed + 1);
+            }
+            if (_link_transfers >= LINK_WINDOW) {
+                _link_transfers = 0;
+                _link_errors = 0;
+            }
+        }
 
-            while (retries--) {
-                PacketCMD packet_cmd;
-                packet_cmd.packet_id = PacketID::COMMAND;
-                packet_cmd.command = Command::DISABLE;
+        //Plans a lap, true if it started a general call itself
+        static bool start_lap() {
+            _lap_pending = 0;
+            if (_broadcast_disable) {
+                _broadcast_disable = false;
+                start_step(Step::BROADCAST_DISABLE_WRITE);
+                return true;
+            }
 
-                if (write_blocking(address, &packet_cmd, sizeof(PacketCMD))) {
-                    if (read_blocking(address, &packet_cmd, sizeof(PacketCMD))) {
-                        if (packet_cmd.status == Status::OK) {
-                            break;
+            uint8_t burst = 0;
+            uint8_t burst_count = 0;
+            for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                const Slave& slave = _slaves[i];
+                const Step step = first_step(slave);
+                if (step == Step::PAD_V2_WRITE && slave.status == Status::READY) {
+                    burst |= (1 << i);
+                    ++burst_count;
+                } else if (step != Step::IDLE) {
+                    _lap_pending |= (1 << i);
+                }
+            }
+            if (burst_count >= 2) {
+                _burst_reads = burst;
+                start_step(Step::BURST_WRITE);
+                return true;
+            }
+            _lap_pending |= burst;
+            return false;
+        }
+
+        //Burst replies first, then the rest of the lap, then a new lap. Goes idle after a lap without any work
+        static void next_slave() {
+            for (uint8_t lap = 0; lap < 2; ++lap) {
+                for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                    if (_burst_reads & (1 << i)) {
+                        _burst_reads &= ~(1 << i);
+                        _slave_idx = i;
+                        start_step(Step::PAD_V2_READ);
+                        return;
+                    }
+                }
+                for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                    if (_lap_pending & (1 << i)) {
+                        _lap_pending &= ~(1 << i);
+                        _slave_idx = i;
+                        Step step = first_step(_slaves[i]);
+                        if (step != Step::IDLE) {
+                            start_step(step);
+                            return;
                         }
                     }
                 }
-                sleep_ms(1);
+                if (start_lap()) {
+                    return;
+                }
+                if (_lap_pending == 0) {
+                    break;
+                }
             }
+            _step = Step::IDLE;
         }
 
-        static void process() {
-            for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
-                Slave& slave = _slaves[i];
+        static void transfer_done(bool success) {
+            Slave& slave = _slaves[_slave_idx];
 
-                if (!slave.enabled || !slave_detected(slave.address)) {
-                    continue;
+            switch (_step) {
+                case Step::STATUS_WRITE:
+                    link_result(slave, success);
+                    if (success) {
+                        start_step(Step::STATUS_READ);
+                        return;
+                    }
+                    slave_lost(slave);
+                    break;
+
+                case Step::STATUS_READ: {
+                    const bool well_formed =    success && 
+                                                _packet_cmd.packet_len == sizeof(PacketCMD) &&
+                                                _packet_cmd.packet_id == PacketID::COMMAND &&
+                                                _packet_cmd.command == Command::STATUS &&
+                                                (_packet_cmd.status == Status::READY || 
+                                                 _packet_cmd.status == Status::NOT_READY);
+                    slave.status = well_formed ? _packet_cmd.status : Status::NC;
+                    slave.status_time_us = time_us_32();
+                    if (slave.version == 0) {
+                        //Only ask for the version once the slave has a reply buffer to send from
+                        if (well_formed) {
+                            start_step(Step::VERSION_WRITE);
+                            return;
+                        }
+                        break;
+                    }
+                    if (slave.status == Status::READY) {
+                        start_step(Step::PAD_WRITE);
+                        return;
+                    }
+                    break;
                 }
 
-                PacketCMD packet_cmd;
-                packet_cmd.packet_id = PacketID::COMMAND;
-                packet_cmd.command = Command::STATUS;
+                case Step::PAD_WRITE:
+                    link_result(slave, success);
+                    if (success) {
+                        start_step(Step::PAD_READ);
+                        return;
+                    }
+                    slave.status = Status::UNKNOWN;
+                    break;
+
+                case Step::PAD_READ:
+                    link_result(slave, success);
+                    if (success) {
+                        slave.packet_out = _packet_out;
+                        slave.new_packet_out = true;
+                    } else {
+                        slave.status = Status::UNKNOWN;
+                    }
+                    break;
+
+                case Step::DISABLE_WRITE:
+                    if (success) {
+                        start_step(Step::DISABLE_READ);
+                        return;
+                    }
+                    slave.disable_retries = 0; //Not on the bus
+                    break;
 
-                if (!write_blocking(slave.address, &packet_cmd, sizeof(PacketCMD)) ||
-                    !read_blocking(slave.address, &packet_cmd, sizeof(PacketCMD))) {
-                    continue;
+                case Step::DISABLE_READ:
+                    slave.disable_sent = false;
+                    if (success && _packet_cmd.command == Command::DISABLE && _packet_cmd.status == Status::OK) {
+                        slave.disable_retries = 0;
+                    } else {
+                        --slave.disable_retries;
+                    }
+                    break;
+
+                case Step::VERSION_WRITE:
+                    if (success) {
+                        start_step(Step::VERSION_READ);
+                        return;
+                    }
+                    slave_lost(slave);
+                    break;
+
+                case Step::VERSION_READ:
+                    if (!success) {
+                        slave_lost(slave);
+                        break;
+                    }
+                    //v1 slaves ignore VERSION and send their STATUS reply again, it won't match
+                    if (_packet_cmd.command == Command::VERSION && _packet_cmd.status == Status::OK) {
+                        slave.version = std::clamp(_packet_cmd.version, uint8_t(1), PROTOCOL_VERSION);
+                    } else {
+                        slave.version = 1;
+                    }
+                    slave.resync = true;
+                    OGXM_TRACE_AT(I2C, INFO, "I2C: Slave 0x%02X uses protocol v%d\n", slave.address, slave.version);
+                    if (slave.version >= 2) {
+                        slave.link_tests = LINK_TEST_PACKETS;
+                        start_step(Step::LINK_TEST_WRITE);
+                    } else {
+                        if (_link_speed < LINK_SPEED_V1) {
+                            set_link_speed(LINK_SPEED_V1);
+                        }
+                        //Status came with the probe
+                        if (slave.status == Status::READY) {
+                            start_step(Step::PAD_WRITE);
+                            return;
+                        }
+                        break;
+                    }
+                    return;
+
+                case Step::LINK_TEST_WRITE:
+                case Step::LINK_TEST_READ: {
+                    const bool passed = success && ((_step == Step::LINK_TEST_WRITE) || 
+                                        (_link_test_reply.packet_len == sizeof(LinkTestReply) && 
+                                         _link_test_reply.packet_id == PacketID::LINK_TEST && 
+                                         _link_test_reply.seq == slave.link_tests && 
+                                         _link_test_reply.status == Status::OK && 
+                                         _link_test_reply.crc == crc8(reinterpret_cast<const uint8_t*>(&_link_test_reply), 
+                                                                      sizeof(LinkTestReply) - 1)));
+                    if (!passed) {
+                        if (_link_speed + 1 < NUM_LINK_SPEEDS) {
+                            set_link_speed(_link_speed + 1);
+                            slave.link_tests = LINK_TEST_PACKETS;
+                        } else {
+                            //Nothing slower to try, run with it
+                            OGXM_TRACE_AT(I2C, WARN, "I2C: Slave 0x%02X failed link training\n", slave.address);
+                            slave.link_tests = 0;
+                        }
+                        break;
+                    }
+                    if (_step == Step::LINK_TEST_WRITE) {
+                        start_step(Step::LINK_TEST_READ);
+                        return;
+                    }
+                    if (--slave.link_tests > 0) {
+                        start_step(Step::LINK_TEST_WRITE);
+                        return;
+                    }
+                    OGXM_TRACE_AT(I2C, INFO, "I2C: Slave 0x%02X trained at %u kHz\n", 
+                                  slave.address, static_cast<unsigned>(LINK_SPEEDS[_link_speed] / 1000));
+                    start_step(Step::PAD_V2_WRITE);
+                    return;
                 }
 
-                if (packet_cmd.status == Status::READY) {
-                    Gamepad& gamepad = _gamepads[i + 1];
-                    PacketIn packet_in;
-                    packet_in.pad_in = gamepad.get_pad_in();
-                    packet_in.chatpad_in = gamepad.get_chatpad_in();
+                case Step::PAD_V2_WRITE:
+                    link_result(slave, success);
+                    if (success) {
+                        start_step(Step::PAD_V2_READ);
+                        return;
+                    }
+                    slave_lost(slave);
+                    break;
 
-                    if (write_blocking(slave.address, &packet_in, sizeof(PacketIn))) {
-                        PacketOut packet_out;
-                        if (read_blocking(slave.address, &packet_out, sizeof(PacketOut))) {
-                            gamepad.set_pad_out(packet_out.pad_out);
+                case Step::PAD_V2_READ:
+                    link_result(slave, success && V2::valid(_v2_reply, slave.seq));
+                    if (!success || !V2::valid(_v2_reply, slave.seq)) {
+                        //Can't tell what the slave applied
+                        slave.resync = true;
+                    } else {
+                        slave.status = _v2_reply.status;
+                        slave.status_time_us = time_us_32();
+                        if (slave.status == Status::READY) {
+                            slave.acked = slave.sent;
+                            slave.resync = false;
+                            slave.packet_out.pad_out = _v2_reply.pad_out;
+                            slave.new_packet_out = true;
+                        } else {
+                            slave.resync = true;
+                        }
+                    }
+                    ++slave.seq;
+                    break;
+
+                case Step::BURST_WRITE:
+                    if (!success) {
+                        //No slave ACKed the general call, they get their own PAD_V2 this lap
+                        for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                            if (_burst_reads & (1 << i)) {
+                                _slaves[i].resync = true;
+                            }
                         }
+                        _lap_pending |= _burst_reads;
+                        _burst_reads = 0;
                     }
+                    break;
+
+                case Step::BROADCAST_DISABLE_WRITE:
+                    for (auto& disable_slave : _slaves) {
+                        disable_slave.disable_sent = success && (disable_slave.disable_retries > 0);
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+            next_slave();
+        }
+
+        static bool rx_complete() {
+            //The last byte comes in right before STOP, give the DMA a moment to pop it
+            for (uint32_t i = 0; (i < 64) && dma_channel_is_busy(_dma_rx); ++i) {
+                tight_loop_contents();
+            }
+            if (dma_channel_is_busy(_dma_rx)) {
+                dma_channel_abort(_dma_rx);
+                return false;
+            }
+            return true;
+        }
+
+        static void i2c_irq_handler() {
+            i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+            const uint32_t intr_stat = hw->intr_stat;
+
+            if (intr_stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+                //NACK, the TX FIFO stays flushed until the abort is cleared
+                dma_channel_abort(_dma_tx);
+                dma_channel_abort(_dma_rx);
+                _transfer_failed = true;
+                (void)hw->clr_tx_abrt;
+            }
+            //Aborts end with a STOP as well
+            if (intr_stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+                (void)hw->clr_stop_det;
+                if (_step != Step::IDLE) {
+                    const bool success = !_transfer_failed && (!_transfer_read || rx_complete());
+                    transfer_done(success);
                 }
-                sleep_ms(1);
             }
         }
 
+        //Call with interrupts disabled
+        static void request_disable(Slave& slave) {
+            slave.enabled = false;
+            slave.status = Status::UNKNOWN;
+            slave.disable_retries = DISABLE_RETRIES;
+            slave.disable_sent = false;
+        }
+
+        static void process() {
+            for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                Slave& slave = _slaves[i];
+                if (!slave.enabled) {
+                    continue;
+                }
+
+                Gamepad& gamepad = _gamepads[i + 1];
+                PacketIn packet_in;
+                packet_in.pad_in = gamepad.get_pad_in();
+                packet_in.chatpad_in = gamepad.get_chatpad_in();
+
+                PacketOut packet_out;
+                uint32_t irq_state = save_and_disable_interrupts();
+                slave.packet_in = packet_in;
+                const bool new_packet_out = slave.new_packet_out;
+                if (new_packet_out) {
+                    packet_out = slave.packet_out;
+                    slave.new_packet_out = false;
+                }
+                restore_interrupts(irq_state);
+
+                if (new_packet_out) {
+                    gamepad.set_pad_out(packet_out.pad_out);
+                }
+            }
+
+            uint32_t irq_state = save_and_disable_interrupts();
+            if (_step == Step::IDLE) {
+                next_slave();
+            } else if ((time_us_32() - _transfer_start_us) > _transfer_timeout_us) {
+                //Lost STOP or a stuck slave, start the block over and move on
+                OGXM_TRACE_AT(I2C, WARN, "I2C: Transfer to 0x%02X timed out\n", _slaves[_slave_idx].address);
+                dma_channel_abort(_dma_tx);
+                dma_channel_abort(_dma_rx);
+                reset_bus();
+                transfer_done(false);
+            }
+            restore_interrupts(irq_state);
+        }
+
+        static void initialize() {
+            for (uint8_t i = 0; i < NUM_SLAVES; ++i) {
+                _slaves[i].address = i + 1;
+            }
+
+            i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+            _dma_tx = static_cast<uint>(dma_claim_unused_channel(true));
+            _dma_rx = static_cast<uint>(dma_claim_unused_channel(true));
+
+            dma_channel_config config = dma_channel_get_default_config(_dma_tx);
+            channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+            channel_config_set_read_increment(&config, true);
+            channel_config_set_write_increment(&config, false);
+            channel_config_set_dreq(&config, i2c_get_dreq(I2C_PORT, true));
+            dma_channel_configure(_dma_tx, &config, &hw->data_cmd, nullptr, 0, false);
+
+            config = dma_channel_get_default_config(_dma_rx);
+            channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+            channel_config_set_read_increment(&config, false);
+            channel_config_set_write_increment(&config, true);
+            channel_config_set_dreq(&config, i2c_get_dreq(I2C_PORT, false));
+            dma_channel_configure(_dma_rx, &config, nullptr, &hw->data_cmd, 0, false);
+
+            reset_bus();
+            const uint irq_num = I2C0_IRQ + i2c_get_index(I2C_PORT);
+            irq_set_exclusive_handler(irq_num, i2c_irq_handler);
+            irq_set_enabled(irq_num, true);
+        }
+
         static void xbox360w_connect(bool connected, uint8_t idx) {
             if (idx < 1 || idx >= MAX_GAMEPADS) {
                 return;
@@ -270,10 +1169,18 @@ namespace I2C {
             // so queue on core0 (i2c thread)
             TaskQueue::Core0::queue_task(
             [&slave = _slaves[idx - 1], connected]() {
-                slave.enabled = connected;
-                if (!connected) {
-                    notify_disable(slave.address);
+                uint32_t irq_state = save_and_disable_interrupts();
+                if (connected) {
+                    slave.enabled = true;
+                    slave.status = Status::UNKNOWN;
+                    slave.disable_retries = 0;
+                    slave.disable_sent = false;
+                    slave.version = 0;
+                    slave.resync = true;
+                } else {
+                    request_disable(slave);
                 }
+                restore_interrupts(irq_state);
             });
         }
 
@@ -285,10 +1192,12 @@ namespace I2C {
                 //Called from core1 so queue on core0
                 TaskQueue::Core0::queue_task(
                 []() {
+                    uint32_t irq_state = save_and_disable_interrupts();
                     for (auto& slave : _slaves) {
-                        slave.enabled = false;
-                        notify_disable(slave.address);
+                        request_disable(slave);
                     }
+                    _broadcast_disable = true;
+                    restore_interrupts(irq_state);
                 });
             }
         }
@@ -304,8 +1213,9 @@ namespace I2C {
         gpio_pull_up(SLAVE_ADDR_PIN_1);
         gpio_pull_up(SLAVE_ADDR_PIN_2);
 
+        //Both pins left pulled up is the master
         if (gpio_get(SLAVE_ADDR_PIN_1) && gpio_get(SLAVE_ADDR_PIN_2)) {
-            return 0x00;
+            return 0xFF;
         }
         else if (gpio_get(SLAVE_ADDR_PIN_1) && !gpio_get(SLAVE_ADDR_PIN_2)) {
             return 0x01;
@@ -321,7 +1231,7 @@ namespace I2C {
 
     void initialize() {
         uint8_t i2c_address = get_address();
-        _i2c_role = (i2c_address == 0xFF) ? Role::MASTER : _i2c_role = Role::SLAVE;
+        _i2c_role = (i2c_address == 0xFF) ? Role::MASTER : Role::SLAVE;
 
         i2c_init(I2C_PORT, I2C_BAUDRATE);
 
@@ -333,12 +1243,17 @@ namespace I2C {
         gpio_pull_up(I2C_SCL_PIN);
 
         if (_i2c_role == Role::SLAVE) {
+            //Slaves ACK general calls by default (IC_ACK_GENERAL_CALL), that's how bursts reach them
+            Slave::_address = i2c_address;
             i2c_slave_init(I2C_PORT, i2c_address, &Slave::slave_handler);
+        } else {
+            Master::initialize();
         }
     }
 } // namespace I2C
 
 void core1_task() {
+    flash_safe_execute_core_init(); //Lets core0 park this core while it writes settings
     HostManager& host_manager = HostManager::get_instance();
     host_manager.initialize(_gamepads);
 
@@ -353,15 +1268,10 @@ void core1_task() {
 
     tuh_init(BOARD_TUH_RHPORT);
 
-    uint32_t tid_feedback = TaskQueue::Core1::get_new_task_id();
-    TaskQueue::Core1::queue_delayed_task(tid_feedback, FEEDBACK_DELAY_MS, true, 
-    [&host_manager] {
-        host_manager.send_feedback();
-    });
-
     while (true) {
         TaskQueue::Core1::process_tasks();
         tuh_task();
+        host_manager.send_feedback();
     }
 }
 
@@ -417,9 +1327,7 @@ void four_ch_i2c::initialize() {
 
     board_api::init_board();
 
-    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-        _gamepads[i].set_profile(user_settings.get_profile_by_index(i));
-    }
+    user_settings.initialize_profiles(_gamepads);
 
     DeviceManager::get_instance().initialize_driver(user_settings.get_current_driver(), _gamepads);
 }
@@ -432,8 +1340,11 @@ void four_ch_i2c::run() {
 
     //Wait for something to call tud_init
     while (!tud_inited()) {
+        if (I2C::role() == I2C::Role::SLAVE) {
+            I2C::Slave::process();
+        }
         TaskQueue::Core0::process_tasks();
-        sleep_ms(100);
+        sleep_ms(I2C::role() == I2C::Role::SLAVE ? 1 : 100);
     }
 
     uint32_t tid_gp_check = TaskQueue::Core0::get_new_task_id();
@@ -447,13 +1358,16 @@ void four_ch_i2c::run() {
             I2C::Master::process();
             device_driver->process(0, _gamepads[0]);
             tud_task();
+            ogxm_log::flush_trace();
             sleep_ms(1);
         }
     } else {
         while (true) {
             TaskQueue::Core0::process_tasks();
+            I2C::Slave::process();
             device_driver->process(0, _gamepads[0]);
             tud_task();
+            ogxm_log::flush_trace();
             sleep_ms(1);
         }
     }
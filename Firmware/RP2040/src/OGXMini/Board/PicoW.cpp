@@ -4,6 +4,7 @@
 
 #include <hardware/clocks.h>
 #include <pico/multicore.h>
+#include <pico/flash.h>
 
 #include "tusb.h"
 #include "bsp/board_api.h"
@@ -11,6 +12,7 @@
 #include "USBDevice/DeviceManager.h"
 #include "UserSettings/UserSettings.h"
 #include "Board/board_api.h"
+#include "Board/ogxm_log.h"
 #include "Bluepad32/Bluepad32.h"
 #include "BLEServer/BLEServer.h"
 #include "Gamepad/Gamepad.h"
@@ -19,6 +21,7 @@
 Gamepad _gamepads[MAX_GAMEPADS];
 
 void core1_task() {
+    flash_safe_execute_core_init(); //Lets core0 park this core while it writes settings
     board_api::init_bluetooth();
     board_api::set_led(true);
     BLEServer::init_server(_gamepads);
@@ -43,9 +46,7 @@ void pico_w::initialize() {
     UserSettings& user_settings = UserSettings::get_instance();
     user_settings.initialize_flash();
 
-    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-        _gamepads[i].set_profile(user_settings.get_profile_by_index(i));
-    }
+    user_settings.initialize_profiles(_gamepads);
 
     DeviceManager& device_manager = DeviceManager::get_instance();
     device_manager.initialize_driver(user_settings.get_current_driver(), _gamepads);
@@ -65,10 +66,9 @@ void pico_w::run() {
     while (true) {
         TaskQueue::Core0::process_tasks();
 
-        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-            device_driver->process(i, _gamepads[i]);
-            tud_task();
-        }
+        device_driver->process_all(_gamepads);
+        tud_task();
+        ogxm_log::flush_trace();
         sleep_ms(1);
     }
 }
@@ -3,6 +3,7 @@
 #if ((OGXM_BOARD == PI_PICO) || (OGXM_BOARD == RP2040_ZERO) || (OGXM_BOARD == ADAFRUIT_FEATHER))
 
 #include <pico/multicore.h>
+#include <pico/flash.h>
 
 #include "tusb.h"
 #include "bsp/board_api.h"
@@ -16,7 +17,6 @@
 #include "Board/board_api.h"
 #include "Board/ogxm_log.h"
 
-constexpr uint32_t FEEDBACK_DELAY_MS = 200;
 constexpr uint32_t HOST_ATTACH_SETTLE_DELAY_MS = 300;
 constexpr uint32_t CLONE_ATTACH_RECOVERY_TIMEOUT_MS = 1200;
 
@@ -36,6 +36,7 @@ void wait_for_host_attach_settle() {
 }
 
 void core1_task() {
+    flash_safe_execute_core_init(); //Lets core0 park this core while it writes settings
     HostManager& host_manager = HostManager::get_instance();
     host_manager.initialize(_gamepads);
 
@@ -48,12 +49,6 @@ void core1_task() {
 
     tuh_init(BOARD_TUH_RHPORT);
 
-    uint32_t tid_feedback = TaskQueue::Core1::get_new_task_id();
-    TaskQueue::Core1::queue_delayed_task(tid_feedback, FEEDBACK_DELAY_MS, true, 
-    [&host_manager] {
-        host_manager.send_feedback();
-    });
-
     bool last_host_connected = board_api::usb::host_connected();
     uint32_t attach_started_ms = 0;
     bool attach_recovery_scheduled = false;
@@ -110,6 +105,7 @@ void core1_task() {
         last_host_connected = host_connected;
         TaskQueue::Core1::process_tasks();
         tuh_task();
+        host_manager.send_feedback();
     }
 }
 
@@ -160,9 +156,7 @@ void standard::initialize() {
     UserSettings& user_settings = UserSettings::get_instance();
     user_settings.initialize_flash();
 
-    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-        _gamepads[i].set_profile(user_settings.get_profile_by_index(i));
-    }
+    user_settings.initialize_profiles(_gamepads);
 
     DeviceManager::get_instance().initialize_driver(user_settings.get_current_driver(), _gamepads);
 }
@@ -192,10 +186,9 @@ void standard::run() {
     while (true) {
         TaskQueue::Core0::process_tasks();
 
-        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
-            device_driver->process(i, _gamepads[i]);
-        }
+        device_driver->process_all(_gamepads);
         tud_task();
+        ogxm_log::flush_trace();
         sleep_ms(1);
     }
 }
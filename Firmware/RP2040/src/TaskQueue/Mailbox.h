@@ -0,0 +1,62 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <cstdint>
+#include <array>
+#include <utility>
+#include <hardware/sync.h>
+
+/*  Latest value handoff between one writer and one reader, either of which can be an IRQ
+    or the other core. Triple buffered: the writer fills its own buffer and swaps it with
+    the middle one, the reader swaps the middle one out when it's new. Only the index swap
+    happens under the spin lock, so both sides do constant work and never wait on a copy.
+    The lock is one of the SDK's striped ones, they're meant to be shared like this. */
+
+template <typename Type>
+class Mailbox
+{
+public:
+    Mailbox()
+    {
+        lock_ = spin_lock_instance(next_striped_spin_lock_num());
+    }
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    void write(const Type& value)
+    {
+        buffers_[back_] = value;
+
+        uint32_t irq_state = spin_lock_blocking(lock_);
+        std::swap(back_, middle_);
+        fresh_ = true;
+        spin_unlock(lock_, irq_state);
+    }
+
+    //Copies the newest value into value, returns false if it was already read
+    bool read(Type& value)
+    {
+        uint32_t irq_state = spin_lock_blocking(lock_);
+        const bool fresh = fresh_;
+        if (fresh)
+        {
+            std::swap(front_, middle_);
+            fresh_ = false;
+        }
+        spin_unlock(lock_, irq_state);
+
+        value = buffers_[front_];
+        return fresh;
+    }
+
+private:
+    std::array<Type, 3> buffers_{};
+    uint8_t back_{0};   //Writer's
+    uint8_t middle_{1};
+    uint8_t front_{2};  //Reader's
+    bool fresh_{false};
+    spin_lock_t* lock_{nullptr};
+};
+
+#endif // MAILBOX_H
@@ -1,4 +1,5 @@
 #include "TaskQueue/TaskQueue.h"
+#include "Board/ogxm_log.h"
 
 TaskQueue::TaskQueue(CoreNum core_num) 
 {   
@@ -27,6 +28,7 @@ bool TaskQueue::queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool rep
         if (task.task_id == task_id)
         {
             spin_unlock(spinlock_delayed_, irq_state);
+            OGXM_TRACE_AT(TASK_QUEUE, DEBUG, "TaskQueue: Task %u already queued\n", task_id);
             return false;
         }
     }
@@ -61,6 +63,7 @@ bool TaskQueue::queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool rep
     }
 
     spin_unlock(spinlock_delayed_, irq_state);
+    OGXM_TRACE_AT(TASK_QUEUE, WARN, "TaskQueue: Delayed queue full, task %u dropped\n", task_id);
     return false;
 }
 
@@ -110,6 +113,8 @@ bool TaskQueue::queue_task(const std::function<void()>& function)
         }
     }
     spin_unlock(spinlock_queue_, irq_state);
+    //Also reached from the timer IRQ when a delayed task comes due, so trace only
+    OGXM_TRACE_AT(TASK_QUEUE, WARN, "TaskQueue: Queue on core %u full, task dropped\n", get_core_num());
     return false;
 }
 
@@ -221,6 +226,7 @@ void TaskQueue::suspend_delayed()
     suspended_time_ = get_time_64_us();
     suspended_ = true;
     spin_unlock(spinlock_delayed_, irq_state);
+    OGXM_TRACE_AT(TASK_QUEUE, INFO, "TaskQueue: Delayed tasks suspended on alarm %u\n", alarm_num_);
 }
 
 void TaskQueue::resume_delayed()
@@ -249,4 +255,5 @@ void TaskQueue::resume_delayed()
     }
     suspended_ = false;
     spin_unlock(spinlock_delayed_, irq_state);
+    OGXM_TRACE_AT(TASK_QUEUE, INFO, "TaskQueue: Delayed tasks resumed after %u us\n", static_cast<uint32_t>(elapsed_time));
 }
\ No newline at end of file
@@ -46,88 +46,20 @@ void DInputDevice::process(const uint8_t idx, Gamepad& gamepad)
 
     if (gamepad.new_pad_in())
     {
-        Gamepad::PadIn gp_in = gamepad.get_pad_in();
+        ReportMap::Writer<REPORT_MAP>::write(gamepad.get_pad_in(), gamepad.analog_enabled(), reinterpret_cast<uint8_t*>(&in_report));
+    }
 
-        switch (gp_in.dpad)
+    if (in_report_dirty(idx, &in_report, sizeof(DInput::InReport)))
+    {
+        if (tud_suspended())
         {
-            case Gamepad::DPAD_UP:
-                in_report.dpad = DInput::DPad::UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report.dpad = DInput::DPad::DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report.dpad = DInput::DPad::LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report.dpad = DInput::DPad::RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report.dpad = DInput::DPad::UP_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report.dpad = DInput::DPad::UP_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report.dpad = DInput::DPad::DOWN_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report.dpad = DInput::DPad::DOWN_RIGHT;
-                break;
-            default:
-                in_report.dpad = DInput::DPad::CENTER;
-                break;
+            tud_remote_wakeup();
         }
-
-        std::memset(in_report.buttons, 0, sizeof(in_report.buttons));
-
-        if (gp_in.buttons & Gamepad::BUTTON_A)   in_report.buttons[0] |= DInput::Buttons0::CROSS;
-        if (gp_in.buttons & Gamepad::BUTTON_B)   in_report.buttons[0] |= DInput::Buttons0::CIRCLE;
-        if (gp_in.buttons & Gamepad::BUTTON_X)   in_report.buttons[0] |= DInput::Buttons0::SQUARE;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)   in_report.buttons[0] |= DInput::Buttons0::TRIANGLE;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)  in_report.buttons[0] |= DInput::Buttons0::L1;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)  in_report.buttons[0] |= DInput::Buttons0::R1;
-
-        if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report.buttons[1] |= DInput::Buttons1::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report.buttons[1] |= DInput::Buttons1::R3;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report.buttons[1] |= DInput::Buttons1::SELECT;
-        if (gp_in.buttons & Gamepad::BUTTON_START) in_report.buttons[1] |= DInput::Buttons1::START;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report.buttons[1] |= DInput::Buttons1::SYS;
-        if (gp_in.buttons & Gamepad::BUTTON_MISC)  in_report.buttons[1] |= DInput::Buttons1::TP;
-
-        if (gamepad.analog_enabled())
+        if (tud_hid_n_ready(idx) &&
+            tud_hid_n_report(idx, 0, reinterpret_cast<void*>(&in_report), sizeof(DInput::InReport)))
         {
-            in_report.up_axis    = gp_in.analog[Gamepad::ANALOG_OFF_UP];
-            in_report.down_axis  = gp_in.analog[Gamepad::ANALOG_OFF_DOWN];
-            in_report.right_axis = gp_in.analog[Gamepad::ANALOG_OFF_RIGHT];
-            in_report.left_axis  = gp_in.analog[Gamepad::ANALOG_OFF_LEFT];
-
-            in_report.triangle_axis = gp_in.analog[Gamepad::ANALOG_OFF_Y];
-            in_report.circle_axis   = gp_in.analog[Gamepad::ANALOG_OFF_X];
-            in_report.cross_axis    = gp_in.analog[Gamepad::ANALOG_OFF_B];
-            in_report.square_axis   = gp_in.analog[Gamepad::ANALOG_OFF_A];
-
-            in_report.r1_axis = gp_in.analog[Gamepad::ANALOG_OFF_RB];
-            in_report.l1_axis = gp_in.analog[Gamepad::ANALOG_OFF_LB];
+            in_report_sent(idx, &in_report, sizeof(DInput::InReport));
         }
-
-        in_report.joystick_lx = Scale::int16_to_uint8(gp_in.joystick_lx);
-        in_report.joystick_ly = Scale::int16_to_uint8(gp_in.joystick_ly);
-        in_report.joystick_rx = Scale::int16_to_uint8(gp_in.joystick_rx);
-        in_report.joystick_ry = Scale::int16_to_uint8(gp_in.joystick_ry);
-
-        in_report.l2_axis = gp_in.trigger_l;
-        in_report.r2_axis = gp_in.trigger_r;
-    }
-
-    if (tud_suspended())
-    {
-        tud_remote_wakeup();
-    }
-
-    if (tud_hid_n_ready(idx))
-    {
-        tud_hid_n_report(idx, 0, reinterpret_cast<void*>(&in_report), sizeof(DInput::InReport));
     }
 }
 
@@ -1,12 +1,14 @@
 #ifndef _DINPUT_DEVICE_H_
 #define _DINPUT_DEVICE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
 
 #include "Board/Config.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/DInput.h"
+#include "Gamepad/ReportMap.h"
 
 class DInputDevice : public DeviceDriver 
 {
@@ -22,6 +24,47 @@ public:
     const uint8_t* get_descriptor_configuration_cb(uint8_t index) override;
     const uint8_t* get_descriptor_device_qualifier_cb() override;
 
+    static constexpr auto REPORT_MAP = ReportMap::make(
+        ReportMap::hat(offsetof(DInput::InReport, dpad),
+                       { DInput::DPad::UP,   DInput::DPad::UP_RIGHT,  DInput::DPad::RIGHT, DInput::DPad::DOWN_RIGHT,
+                         DInput::DPad::DOWN, DInput::DPad::DOWN_LEFT, DInput::DPad::LEFT,  DInput::DPad::UP_LEFT },
+                       DInput::DPad::CENTER),
+        {
+            ReportMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::CROSS,    Gamepad::BUTTON_A),
+            ReportMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::CIRCLE,   Gamepad::BUTTON_B),
+            ReportMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::SQUARE,   Gamepad::BUTTON_X),
+            ReportMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::TRIANGLE, Gamepad::BUTTON_Y),
+            ReportMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::L1,       Gamepad::BUTTON_LB),
+            ReportMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::R1,       Gamepad::BUTTON_RB),
+            ReportMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::L3,       Gamepad::BUTTON_L3),
+            ReportMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::R3,       Gamepad::BUTTON_R3),
+            ReportMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::SELECT,   Gamepad::BUTTON_BACK),
+            ReportMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::START,    Gamepad::BUTTON_START),
+            ReportMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::SYS,      Gamepad::BUTTON_SYS),
+            ReportMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::TP,       Gamepad::BUTTON_MISC)
+        },
+        {
+            ReportMap::axis(offsetof(DInput::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(DInput::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(DInput::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(DInput::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(DInput::InReport, l2_axis),     ReportMap::Source::TRIGGER_L,   ReportMap::Encoding::UINT8),
+            ReportMap::axis(offsetof(DInput::InReport, r2_axis),     ReportMap::Source::TRIGGER_R,   ReportMap::Encoding::UINT8)
+        },
+        //Pressure axes are only reported in analog mode
+        {
+            ReportMap::pressure(offsetof(DInput::InReport, up_axis),       Gamepad::ANALOG_OFF_UP,    0),
+            ReportMap::pressure(offsetof(DInput::InReport, down_axis),     Gamepad::ANALOG_OFF_DOWN,  0),
+            ReportMap::pressure(offsetof(DInput::InReport, right_axis),    Gamepad::ANALOG_OFF_RIGHT, 0),
+            ReportMap::pressure(offsetof(DInput::InReport, left_axis),     Gamepad::ANALOG_OFF_LEFT,  0),
+            ReportMap::pressure(offsetof(DInput::InReport, triangle_axis), Gamepad::ANALOG_OFF_Y,     0),
+            ReportMap::pressure(offsetof(DInput::InReport, circle_axis),   Gamepad::ANALOG_OFF_X,     0),
+            ReportMap::pressure(offsetof(DInput::InReport, cross_axis),    Gamepad::ANALOG_OFF_B,     0),
+            ReportMap::pressure(offsetof(DInput::InReport, square_axis),   Gamepad::ANALOG_OFF_A,     0),
+            ReportMap::pressure(offsetof(DInput::InReport, r1_axis),       Gamepad::ANALOG_OFF_RB,    0),
+            ReportMap::pressure(offsetof(DInput::InReport, l1_axis),       Gamepad::ANALOG_OFF_LB,    0)
+        });
+
 private:
     std::array<DInput::InReport, MAX_GAMEPADS> in_reports_;
 
@@ -12,134 +12,32 @@ void DS4Device::initialize() {
                    .control_xfer_cb = hidd_control_xfer_cb,
                    .xfer_cb = hidd_xfer_cb,
                    .sof = NULL};
+
+  std::memset(&report_in_, 0, sizeof(DS4::InReport));
+  report_in_.report_id = 0x01;
+  report_in_.battery_level = 0x0B; // Full battery, USB connected
 }
 
 void DS4Device::process(const uint8_t idx, Gamepad &gamepad) {
   if (gamepad.new_pad_in()) {
-    Gamepad::PadIn gp_in = gamepad.get_pad_in();
-
-    // Initialize report with zeros
-    std::memset(&report_in_, 0, sizeof(DS4::InReport));
-    report_in_.report_id = 0x01;
-
-    // === Joysticks ===
-    // DS4 uses 0x80 (128) as center, range 0-255
-    constexpr int16_t DEADZONE = 1640; // ~5% of 32768
-    constexpr uint8_t DS4_CENTER = 0x80;
-
-    auto joystick_to_ds4 = [](int16_t value, int16_t deadzone) -> uint8_t {
-      if (value > -deadzone && value < deadzone) {
-        return DS4_CENTER;
-      }
-      // Convert int16 (-32768 to +32767) to uint8 (0 to 255)
-      int32_t scaled = ((static_cast<int32_t>(value) + 32768) * 255) / 65535;
-      return static_cast<uint8_t>(scaled);
-    };
-
-    report_in_.joystick_lx = joystick_to_ds4(gp_in.joystick_lx, DEADZONE);
-    report_in_.joystick_ly = joystick_to_ds4(gp_in.joystick_ly, DEADZONE);
-    report_in_.joystick_rx = joystick_to_ds4(gp_in.joystick_rx, DEADZONE);
-    report_in_.joystick_ry = joystick_to_ds4(gp_in.joystick_ry, DEADZONE);
-
-    // === D-pad (HAT switch) ===
-    // Lower 4 bits of buttons0
-    switch (gp_in.dpad) {
-    case Gamepad::DPAD_UP:
-      report_in_.buttons0 = DS4::DPad::UP;
-      break;
-    case Gamepad::DPAD_UP_RIGHT:
-      report_in_.buttons0 = DS4::DPad::UP_RIGHT;
-      break;
-    case Gamepad::DPAD_RIGHT:
-      report_in_.buttons0 = DS4::DPad::RIGHT;
-      break;
-    case Gamepad::DPAD_DOWN_RIGHT:
-      report_in_.buttons0 = DS4::DPad::DOWN_RIGHT;
-      break;
-    case Gamepad::DPAD_DOWN:
-      report_in_.buttons0 = DS4::DPad::DOWN;
-      break;
-    case Gamepad::DPAD_DOWN_LEFT:
-      report_in_.buttons0 = DS4::DPad::DOWN_LEFT;
-      break;
-    case Gamepad::DPAD_LEFT:
-      report_in_.buttons0 = DS4::DPad::LEFT;
-      break;
-    case Gamepad::DPAD_UP_LEFT:
-      report_in_.buttons0 = DS4::DPad::UP_LEFT;
-      break;
-    default:
-      report_in_.buttons0 = DS4::DPad::CENTER;
-      break;
-    }
-
-    // === Face buttons (upper nibble of buttons0) ===
-    // Square, Cross, Circle, Triangle
-    if (gp_in.buttons & Gamepad::BUTTON_X)
-      report_in_.buttons0 |= DS4::Buttons0::SQUARE;
-    if (gp_in.buttons & Gamepad::BUTTON_A)
-      report_in_.buttons0 |= DS4::Buttons0::CROSS;
-    if (gp_in.buttons & Gamepad::BUTTON_B)
-      report_in_.buttons0 |= DS4::Buttons0::CIRCLE;
-    if (gp_in.buttons & Gamepad::BUTTON_Y)
-      report_in_.buttons0 |= DS4::Buttons0::TRIANGLE;
-
-    // === Shoulder and menu buttons (buttons1) ===
-    // L1, R1, L2(digital), R2(digital), Share, Options, L3, R3
-    if (gp_in.buttons & Gamepad::BUTTON_LB)
-      report_in_.buttons1 |= DS4::Buttons1::L1;
-    if (gp_in.buttons & Gamepad::BUTTON_RB)
-      report_in_.buttons1 |= DS4::Buttons1::R1;
-
-    // L2/R2 digital bits - set when trigger is pressed at all
-    if (gp_in.trigger_l > 0)
-      report_in_.buttons1 |= DS4::Buttons1::L2;
-    if (gp_in.trigger_r > 0)
-      report_in_.buttons1 |= DS4::Buttons1::R2;
-
-    // Share = BACK/SELECT button (CRITICAL for PS3!)
-    if (gp_in.buttons & Gamepad::BUTTON_BACK)
-      report_in_.buttons1 |= DS4::Buttons1::SHARE;
-    // Options = START button
-    if (gp_in.buttons & Gamepad::BUTTON_START)
-      report_in_.buttons1 |= DS4::Buttons1::OPTIONS;
-
-    // Stick clicks
-    if (gp_in.buttons & Gamepad::BUTTON_L3)
-      report_in_.buttons1 |= DS4::Buttons1::L3;
-    if (gp_in.buttons & Gamepad::BUTTON_R3)
-      report_in_.buttons1 |= DS4::Buttons1::R3;
-
-    // === System buttons (buttons2) ===
-    // PS button, Touchpad click, and 6-bit counter
-    if (gp_in.buttons & Gamepad::BUTTON_SYS)
-      report_in_.buttons2 |= DS4::Buttons2::PS;
-    if (gp_in.buttons & Gamepad::BUTTON_MISC)
-      report_in_.buttons2 |= DS4::Buttons2::TP;
+    // Only the mapped bytes change, the rest is set up once in initialize()
+    ReportMap::Writer<REPORT_MAP>::write(gamepad.get_pad_in(), false,
+                                         reinterpret_cast<uint8_t *>(&report_in_));
 
     // Counter (6 bits, bits 2-7) - increments each report
     report_in_.buttons2 |= ((report_counter_++ & 0x3F) << 2);
-
-    // === Analog triggers (CRITICAL for PS3 games!) ===
-    // These are the analog values (0-255) that racing games need
-    report_in_.trigger_l = gp_in.trigger_l;
-    report_in_.trigger_r = gp_in.trigger_r;
-
-    // === Sensor data (can be zeroed for basic functionality) ===
-    // Some games may expect valid sensor data
-    report_in_.timestamp = 0;
-    report_in_.battery = 0x00;
-    report_in_.battery_level = 0x0B; // Full battery, USB connected
   }
 
-  if (tud_suspended()) {
-    tud_remote_wakeup();
-  }
-
-  if (tud_hid_ready()) {
+  if (in_report_dirty(idx, &report_in_, sizeof(DS4::InReport))) {
+    if (tud_suspended()) {
+      tud_remote_wakeup();
+    }
     // Send full 64-byte report including report_id
-    tud_hid_report(0, reinterpret_cast<uint8_t *>(&report_in_),
-                   sizeof(DS4::InReport));
+    if (tud_hid_ready() &&
+        tud_hid_report(0, reinterpret_cast<uint8_t *>(&report_in_),
+                       sizeof(DS4::InReport))) {
+      in_report_sent(idx, &report_in_, sizeof(DS4::InReport));
+    }
   }
 
   if (new_report_out_) {
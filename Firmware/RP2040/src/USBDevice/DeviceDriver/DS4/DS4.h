@@ -1,9 +1,11 @@
 #ifndef _DS4_DEVICE_H_
 #define _DS4_DEVICE_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/DS4.h"
+#include "Gamepad/ReportMap.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 
 // DualShock 4 Device Driver
@@ -29,6 +31,38 @@ public:
   const uint8_t *get_descriptor_configuration_cb(uint8_t index) override;
   const uint8_t *get_descriptor_device_qualifier_cb() override;
 
+  static constexpr auto REPORT_MAP = ReportMap::make(
+      ReportMap::hat(
+          offsetof(DS4::InReport, buttons0),
+          {DS4::DPad::UP, DS4::DPad::UP_RIGHT, DS4::DPad::RIGHT,
+           DS4::DPad::DOWN_RIGHT, DS4::DPad::DOWN, DS4::DPad::DOWN_LEFT,
+           DS4::DPad::LEFT, DS4::DPad::UP_LEFT},
+          DS4::DPad::CENTER),
+      {
+          ReportMap::button(offsetof(DS4::InReport, buttons0), DS4::Buttons0::SQUARE, Gamepad::BUTTON_X),
+          ReportMap::button(offsetof(DS4::InReport, buttons0), DS4::Buttons0::CROSS, Gamepad::BUTTON_A),
+          ReportMap::button(offsetof(DS4::InReport, buttons0), DS4::Buttons0::CIRCLE, Gamepad::BUTTON_B),
+          ReportMap::button(offsetof(DS4::InReport, buttons0), DS4::Buttons0::TRIANGLE, Gamepad::BUTTON_Y),
+          ReportMap::button(offsetof(DS4::InReport, buttons1), DS4::Buttons1::L1, Gamepad::BUTTON_LB),
+          ReportMap::button(offsetof(DS4::InReport, buttons1), DS4::Buttons1::R1, Gamepad::BUTTON_RB),
+          ReportMap::trigger(offsetof(DS4::InReport, buttons1), DS4::Buttons1::L2, ReportMap::Source::TRIGGER_L),
+          ReportMap::trigger(offsetof(DS4::InReport, buttons1), DS4::Buttons1::R2, ReportMap::Source::TRIGGER_R),
+          ReportMap::button(offsetof(DS4::InReport, buttons1), DS4::Buttons1::SHARE, Gamepad::BUTTON_BACK),
+          ReportMap::button(offsetof(DS4::InReport, buttons1), DS4::Buttons1::OPTIONS, Gamepad::BUTTON_START),
+          ReportMap::button(offsetof(DS4::InReport, buttons1), DS4::Buttons1::L3, Gamepad::BUTTON_L3),
+          ReportMap::button(offsetof(DS4::InReport, buttons1), DS4::Buttons1::R3, Gamepad::BUTTON_R3),
+          ReportMap::button(offsetof(DS4::InReport, buttons2), DS4::Buttons2::PS, Gamepad::BUTTON_SYS),
+          ReportMap::button(offsetof(DS4::InReport, buttons2), DS4::Buttons2::TP, Gamepad::BUTTON_MISC),
+      },
+      {
+          ReportMap::axis(offsetof(DS4::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(DS4::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(DS4::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(DS4::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(DS4::InReport, trigger_l), ReportMap::Source::TRIGGER_L, ReportMap::Encoding::UINT8),
+          ReportMap::axis(offsetof(DS4::InReport, trigger_r), ReportMap::Source::TRIGGER_R, ReportMap::Encoding::UINT8),
+      });
+
 private:
   DS4::InReport report_in_;
   DS4::OutReport report_out_;
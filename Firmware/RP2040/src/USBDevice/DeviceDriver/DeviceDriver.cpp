@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <cstring>
+#include <hardware/timer.h>
+
 #include "class/cdc/cdc_device.h"
 #include "bsp/board_api.h"
+#include "Board/board_api.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 
 uint16_t* DeviceDriver::get_string_descriptor(const char* value, uint8_t index)
@@ -26,4 +31,60 @@ uint16_t* DeviceDriver::get_string_descriptor(const char* value, uint8_t index)
 
     string_desc_buffer[0] = static_cast<uint16_t>((0x03 << 8) | (2 * static_cast<uint8_t>(char_count) + 2));
     return string_desc_buffer;
-}
\ No newline at end of file
+}
+
+void DeviceDriver::process_all(Gamepad(&gamepads)[MAX_GAMEPADS])
+{
+#if defined(CONFIG_OGXM_DEBUG)
+    pass_start_us_ = time_us_32();
+#endif
+
+    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+    {
+        process(i, gamepads[i]);
+    }
+
+#if defined(CONFIG_OGXM_DEBUG)
+    if (board_api::ms_since_boot() - latency_log_ms_ >= LATENCY_LOG_INTERVAL_MS)
+    {
+        latency_log_ms_ = board_api::ms_since_boot();
+        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+        {
+            OGXM_LOG("Pad %d IN report queued <= %lu us into pass\n", i, static_cast<unsigned long>(max_latency_us_[i]));
+        }
+        max_latency_us_.fill(0);
+    }
+#endif
+}
+
+bool DeviceDriver::in_report_dirty(uint8_t idx, const void* report, uint16_t len) const
+{
+    if (idx >= sent_reports_.size() || len > MAX_TRACKED_REPORT_SIZE || in_report_keepalive_ms_ == 0)
+    {
+        return true;
+    }
+
+    const SentReport& sent = sent_reports_[idx];
+    if (sent.len != len || std::memcmp(sent.data.data(), report, len) != 0)
+    {
+        return true;
+    }
+    return (board_api::ms_since_boot() - sent.time_ms) >= in_report_keepalive_ms_;
+}
+
+void DeviceDriver::in_report_sent(uint8_t idx, const void* report, uint16_t len)
+{
+    if (idx >= sent_reports_.size() || len > MAX_TRACKED_REPORT_SIZE)
+    {
+        return;
+    }
+
+    SentReport& sent = sent_reports_[idx];
+    std::memcpy(sent.data.data(), report, len);
+    sent.len = len;
+    sent.time_ms = board_api::ms_since_boot();
+
+#if defined(CONFIG_OGXM_DEBUG)
+    max_latency_us_[idx] = std::max(max_latency_us_[idx], time_us_32() - pass_start_us_);
+#endif
+}
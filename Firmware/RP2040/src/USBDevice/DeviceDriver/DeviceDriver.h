@@ -1,12 +1,14 @@
 #ifndef _DEVICE_DRIVER_H_
 #define _DEVICE_DRIVER_H_
 
+#include <array>
 #include <cstdint>
 
 #include "tusb.h"
 #include "class/hid/hid.h"
 #include "device/usbd_pvt.h"
 
+#include "Board/Config.h"
 #include "Gamepad/Gamepad.h"
 
 #if CFG_TUSB_DEBUG >= CFG_TUD_LOG_LEVEL
@@ -31,10 +33,41 @@ public:
     
     const usbd_class_driver_t* get_class_driver() { return &class_driver_; };
 
+    //Builds and queues every pad's report in one pass, call tud_task() once afterwards
+    //so all players see the same latency
+    void process_all(Gamepad(&gamepads)[MAX_GAMEPADS]);
+
 protected:
     usbd_class_driver_t class_driver_;
+    uint32_t in_report_keepalive_ms_{IN_REPORT_KEEPALIVE_MS};
 
     uint16_t* get_string_descriptor(const char* value, uint8_t index);
+
+    //True if the report differs from the last one sent for this pad or the keep-alive interval has passed
+    bool in_report_dirty(uint8_t idx, const void* report, uint16_t len) const;
+    //Call once the report has actually been queued on the endpoint
+    void in_report_sent(uint8_t idx, const void* report, uint16_t len);
+
+private:
+    static constexpr uint16_t MAX_TRACKED_REPORT_SIZE = 64;
+
+    struct SentReport
+    {
+        std::array<uint8_t, MAX_TRACKED_REPORT_SIZE> data{0};
+        uint16_t len{0}; //0 = nothing sent yet
+        uint32_t time_ms{0};
+    };
+
+    std::array<SentReport, MAX_GAMEPADS> sent_reports_{};
+
+#if defined(CONFIG_OGXM_DEBUG)
+    //Worst case time from the start of a pass to each pad's report being queued
+    static constexpr uint32_t LATENCY_LOG_INTERVAL_MS = 5000;
+
+    uint32_t pass_start_us_{0};
+    uint32_t latency_log_ms_{0};
+    std::array<uint32_t, MAX_GAMEPADS> max_latency_us_{0};
+#endif
 };
 
 #endif // _DEVICE_DRIVER_H_
\ No newline at end of file
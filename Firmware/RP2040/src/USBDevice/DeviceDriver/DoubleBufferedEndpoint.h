@@ -0,0 +1,132 @@
+#ifndef _DOUBLE_BUFFERED_ENDPOINT_H_
+#define _DOUBLE_BUFFERED_ENDPOINT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <algorithm>
+
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+
+/*  Ping-pong buffers for an interrupt IN endpoint.
+
+    The caller fills back_buffer() in place (or copies into it with send()) and commits.
+    If the endpoint is idle the buffer is armed right away, otherwise it waits and
+    xfer_complete() arms it as soon as the previous transfer finishes, so the newest
+    committed report always goes out on the next IN token. Committing again before that
+    simply replaces the waiting report.
+
+    commit() and xfer_complete() both run from the device task (process loop and
+    class driver xfer_cb), so no locking is needed between them. */
+
+template <uint16_t SIZE>
+class DoubleBufferedEndpoint
+{
+public:
+    DoubleBufferedEndpoint()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& buffer : buffers_)
+        {
+            buffer.fill(0);
+        }
+        ep_addr_ = 0xFF;
+        ep_size_ = SIZE;
+        back_ = 0;
+        pending_len_ = 0;
+        pending_ = false;
+        in_flight_ = false;
+    }
+
+    void open(uint8_t ep_addr, uint16_t ep_size)
+    {
+        ep_addr_ = ep_addr;
+        ep_size_ = std::min(ep_size, SIZE);
+    }
+
+    inline bool is_open() const
+    {
+        return (ep_addr_ != 0xFF);
+    }
+
+    inline uint8_t ep_addr() const
+    {
+        return ep_addr_;
+    }
+
+    inline uint16_t ep_size() const
+    {
+        return ep_size_;
+    }
+
+    //Never the buffer being transferred, holds the report from two commits ago so rewrite all of it
+    inline uint8_t* back_buffer()
+    {
+        return buffers_[back_].data();
+    }
+
+    //Last report armed on the endpoint
+    inline const uint8_t* front_buffer() const
+    {
+        return buffers_[back_ ^ 1].data();
+    }
+
+    bool commit(uint16_t len)
+    {
+        if (!tud_ready() || !is_open())
+        {
+            return false;
+        }
+        pending_len_ = std::min(len, ep_size_);
+        pending_ = true;
+        if (!in_flight_)
+        {
+            arm();
+        }
+        return true;
+    }
+
+    bool send(const uint8_t* report, uint16_t len)
+    {
+        std::memcpy(back_buffer(), report, std::min(len, ep_size_));
+        return commit(len);
+    }
+
+    //Call from the class driver's xfer_cb for this endpoint
+    void xfer_complete()
+    {
+        in_flight_ = false;
+        arm();
+    }
+
+private:
+    std::array<std::array<uint8_t, SIZE>, 2> buffers_;
+    uint8_t ep_addr_;
+    uint16_t ep_size_;
+    uint8_t back_;
+    uint16_t pending_len_;
+    bool pending_;
+    bool in_flight_;
+
+    void arm()
+    {
+        if (!pending_ || !usbd_edpt_claim(BOARD_TUD_RHPORT, ep_addr_))
+        {
+            return;
+        }
+        if (usbd_edpt_xfer(BOARD_TUD_RHPORT, ep_addr_, buffers_[back_].data(), pending_len_))
+        {
+            in_flight_ = true;
+            pending_ = false;
+            back_ ^= 1;
+        }
+        usbd_edpt_release(BOARD_TUD_RHPORT, ep_addr_);
+    }
+};
+
+#endif // _DOUBLE_BUFFERED_ENDPOINT_H_
@@ -12,6 +12,9 @@ void PS3Device::initialize() {
                    .control_xfer_cb = hidd_control_xfer_cb,
                    .xfer_cb = hidd_xfer_cb,
                    .sof = NULL};
+
+  // PS3 seems to start using stale data if a report isn't sent every frame
+  in_report_keepalive_ms_ = 0;
 }
 
 void PS3Device::process(const uint8_t idx, Gamepad &gamepad) {
@@ -19,135 +22,19 @@ void PS3Device::process(const uint8_t idx, Gamepad &gamepad) {
     Gamepad::PadIn gp_in = gamepad.get_pad_in();
     report_in_ = PS3::InReport();
 
-    // D-pad processing - usar input direto (sem filtro)
-    switch (gp_in.dpad) {
-    case Gamepad::DPAD_UP:
-      report_in_.buttons[0] = PS3::Buttons0::DPAD_UP;
-      break;
-    case Gamepad::DPAD_DOWN:
-      report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN;
-      break;
-    case Gamepad::DPAD_LEFT:
-      report_in_.buttons[0] = PS3::Buttons0::DPAD_LEFT;
-      break;
-    case Gamepad::DPAD_RIGHT:
-      report_in_.buttons[0] = PS3::Buttons0::DPAD_RIGHT;
-      break;
-    case Gamepad::DPAD_UP_LEFT:
-      report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_LEFT;
-      break;
-    case Gamepad::DPAD_UP_RIGHT:
-      report_in_.buttons[0] =
-          PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_RIGHT;
-      break;
-    case Gamepad::DPAD_DOWN_LEFT:
-      report_in_.buttons[0] =
-          PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_LEFT;
-      break;
-    case Gamepad::DPAD_DOWN_RIGHT:
-      report_in_.buttons[0] =
-          PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_RIGHT;
-      break;
-    default:
-      break;
-    }
-
-    if (gp_in.buttons & Gamepad::BUTTON_X)
-      report_in_.buttons[1] |= PS3::Buttons1::SQUARE;
-    if (gp_in.buttons & Gamepad::BUTTON_A)
-      report_in_.buttons[1] |= PS3::Buttons1::CROSS;
-    if (gp_in.buttons & Gamepad::BUTTON_Y)
-      report_in_.buttons[1] |= PS3::Buttons1::TRIANGLE;
-    if (gp_in.buttons & Gamepad::BUTTON_B)
-      report_in_.buttons[1] |= PS3::Buttons1::CIRCLE;
-    if (gp_in.buttons & Gamepad::BUTTON_LB)
-      report_in_.buttons[1] |= PS3::Buttons1::L1;
-    if (gp_in.buttons & Gamepad::BUTTON_RB)
-      report_in_.buttons[1] |= PS3::Buttons1::R1;
-    if (gp_in.buttons & Gamepad::BUTTON_BACK)
-      report_in_.buttons[0] |= PS3::Buttons0::SELECT;
-    if (gp_in.buttons & Gamepad::BUTTON_START)
-      report_in_.buttons[0] |= PS3::Buttons0::START;
-    if (gp_in.buttons & Gamepad::BUTTON_L3)
-      report_in_.buttons[0] |= PS3::Buttons0::L3;
-    if (gp_in.buttons & Gamepad::BUTTON_R3)
-      report_in_.buttons[0] |= PS3::Buttons0::R3;
-    if (gp_in.buttons & Gamepad::BUTTON_SYS)
-      report_in_.buttons[2] |= PS3::Buttons2::SYS;
-    if (gp_in.buttons & Gamepad::BUTTON_MISC)
-      report_in_.buttons[2] |= PS3::Buttons2::TP;
-
-    if (gp_in.trigger_l)
-      report_in_.buttons[1] |= PS3::Buttons1::L2;
-    if (gp_in.trigger_r)
-      report_in_.buttons[1] |= PS3::Buttons1::R2;
-
-    // Valores analógicos dos triggers (CRÍTICO para jogos de PS3!)
-    report_in_.l2_axis = gp_in.trigger_l;
-    report_in_.r2_axis = gp_in.trigger_r;
-
-    // ============ JOYSTICKS COM DEADZONE ============
-    // PS3 usa 0x7F (127) como centro do joystick, não 0x80 (128)
-    // Ambos analógicos: 5% deadzone
-    constexpr int16_t DEADZONE_LEFT = 1640;  // ~5% de 32768
-    constexpr int16_t DEADZONE_RIGHT = 1640; // ~5% de 32768
-    constexpr uint8_t PS3_CENTER = 0x7F;     // 127
-
-    auto joystick_to_ps3 = [](int16_t value, int16_t deadzone) -> uint8_t {
-      // Se dentro da deadzone, retorna exatamente o centro do PS3
-      if (value > -deadzone && value < deadzone) {
-        return PS3_CENTER;
-      }
-      // Converter int16 (-32768 a +32767) para uint8 (0 a 254)
-      // Nota: usamos 254 como máximo para que o centro seja 127
-      int32_t scaled = ((static_cast<int32_t>(value) + 32768) * 254) / 65535;
-      return static_cast<uint8_t>(scaled);
-    };
-
-    // Converter joysticks com deadzones diferenciadas
-    report_in_.joystick_lx = joystick_to_ps3(gp_in.joystick_lx, DEADZONE_LEFT);
-    report_in_.joystick_ly = joystick_to_ps3(gp_in.joystick_ly, DEADZONE_LEFT);
-    report_in_.joystick_rx = joystick_to_ps3(gp_in.joystick_rx, DEADZONE_RIGHT);
-    report_in_.joystick_ry = joystick_to_ps3(gp_in.joystick_ry, DEADZONE_RIGHT);
-
-    if (gamepad.analog_enabled()) {
-      // Para botões face/shoulder, usar valores analógicos do controle
-      report_in_.triangle_axis = gp_in.analog[Gamepad::ANALOG_OFF_Y];
-      report_in_.circle_axis = gp_in.analog[Gamepad::ANALOG_OFF_B];
-      report_in_.cross_axis = gp_in.analog[Gamepad::ANALOG_OFF_A];
-      report_in_.square_axis = gp_in.analog[Gamepad::ANALOG_OFF_X];
-      report_in_.r1_axis = gp_in.analog[Gamepad::ANALOG_OFF_RB];
-      report_in_.l1_axis = gp_in.analog[Gamepad::ANALOG_OFF_LB];
-
-      // Para D-pad, usar valor digital convertido
-      report_in_.up_axis = (gp_in.dpad & Gamepad::DPAD_UP) ? 0xFF : 0;
-      report_in_.down_axis = (gp_in.dpad & Gamepad::DPAD_DOWN) ? 0xFF : 0;
-      report_in_.right_axis = (gp_in.dpad & Gamepad::DPAD_RIGHT) ? 0xFF : 0;
-      report_in_.left_axis = (gp_in.dpad & Gamepad::DPAD_LEFT) ? 0xFF : 0;
-    } else {
-      report_in_.up_axis = (gp_in.dpad & Gamepad::DPAD_UP) ? 0xFF : 0;
-      report_in_.down_axis = (gp_in.dpad & Gamepad::DPAD_DOWN) ? 0xFF : 0;
-      report_in_.right_axis = (gp_in.dpad & Gamepad::DPAD_RIGHT) ? 0xFF : 0;
-      report_in_.left_axis = (gp_in.dpad & Gamepad::DPAD_LEFT) ? 0xFF : 0;
-
-      report_in_.triangle_axis = (gp_in.buttons & Gamepad::BUTTON_Y) ? 0xFF : 0;
-      report_in_.circle_axis = (gp_in.buttons & Gamepad::BUTTON_B) ? 0xFF : 0;
-      report_in_.cross_axis = (gp_in.buttons & Gamepad::BUTTON_A) ? 0xFF : 0;
-      report_in_.square_axis = (gp_in.buttons & Gamepad::BUTTON_X) ? 0xFF : 0;
-
-      report_in_.r1_axis = (gp_in.buttons & Gamepad::BUTTON_RB) ? 0xFF : 0;
-      report_in_.l1_axis = (gp_in.buttons & Gamepad::BUTTON_LB) ? 0xFF : 0;
-    }
-  }
-
-  if (tud_suspended()) {
-    tud_remote_wakeup();
+    ReportMap::Writer<REPORT_MAP>::write(gp_in, gamepad.analog_enabled(),
+                                         reinterpret_cast<uint8_t *>(&report_in_));
   }
 
-  if (tud_hid_ready()) {
-    // PS3 seems to start using stale data if a report isn't sent every frame
-    tud_hid_report(0, reinterpret_cast<uint8_t *>(&report_in_),
-                   sizeof(PS3::InReport));
+  if (in_report_dirty(idx, &report_in_, sizeof(PS3::InReport))) {
+    if (tud_suspended()) {
+      tud_remote_wakeup();
+    }
+    if (tud_hid_ready() &&
+        tud_hid_report(0, reinterpret_cast<uint8_t *>(&report_in_),
+                       sizeof(PS3::InReport))) {
+      in_report_sent(idx, &report_in_, sizeof(PS3::InReport));
+    }
   }
 
   if (new_report_out_) {
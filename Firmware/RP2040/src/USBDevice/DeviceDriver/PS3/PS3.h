@@ -2,9 +2,11 @@
 #define _PS3_DEVICE_H_
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/PS3.h"
+#include "Gamepad/ReportMap.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 
 class PS3Device : public DeviceDriver {
@@ -26,6 +28,49 @@ public:
   const uint8_t *get_descriptor_configuration_cb(uint8_t index) override;
   const uint8_t *get_descriptor_device_qualifier_cb() override;
 
+  static constexpr auto REPORT_MAP = ReportMap::make(
+      ReportMap::dpad_bits(offsetof(PS3::InReport, buttons[0]),
+                           PS3::Buttons0::DPAD_UP, PS3::Buttons0::DPAD_DOWN,
+                           PS3::Buttons0::DPAD_LEFT, PS3::Buttons0::DPAD_RIGHT),
+      {
+          ReportMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::SELECT, Gamepad::BUTTON_BACK),
+          ReportMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::START, Gamepad::BUTTON_START),
+          ReportMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::L3, Gamepad::BUTTON_L3),
+          ReportMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::R3, Gamepad::BUTTON_R3),
+          ReportMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::SQUARE, Gamepad::BUTTON_X),
+          ReportMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::CROSS, Gamepad::BUTTON_A),
+          ReportMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::TRIANGLE, Gamepad::BUTTON_Y),
+          ReportMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::CIRCLE, Gamepad::BUTTON_B),
+          ReportMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::L1, Gamepad::BUTTON_LB),
+          ReportMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::R1, Gamepad::BUTTON_RB),
+          ReportMap::trigger(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::L2, ReportMap::Source::TRIGGER_L),
+          ReportMap::trigger(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::R2, ReportMap::Source::TRIGGER_R),
+          ReportMap::button(offsetof(PS3::InReport, buttons[2]), PS3::Buttons2::SYS, Gamepad::BUTTON_SYS),
+          ReportMap::button(offsetof(PS3::InReport, buttons[2]), PS3::Buttons2::TP, Gamepad::BUTTON_MISC),
+      },
+      // PS3 usa 0x7F (127) como centro do joystick, não 0x80 (128)
+      {
+          ReportMap::axis(offsetof(PS3::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::UINT8_DEADZONE_7F),
+          ReportMap::axis(offsetof(PS3::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::UINT8_DEADZONE_7F),
+          ReportMap::axis(offsetof(PS3::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::UINT8_DEADZONE_7F),
+          ReportMap::axis(offsetof(PS3::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::UINT8_DEADZONE_7F),
+          ReportMap::axis(offsetof(PS3::InReport, l2_axis), ReportMap::Source::TRIGGER_L, ReportMap::Encoding::UINT8),
+          ReportMap::axis(offsetof(PS3::InReport, r2_axis), ReportMap::Source::TRIGGER_R, ReportMap::Encoding::UINT8),
+      },
+      // D-pad sempre digital, botões face/shoulder usam valores analógicos quando disponíveis
+      {
+          ReportMap::pressure_dpad(offsetof(PS3::InReport, up_axis), ReportMap::NO_ANALOG, Gamepad::DPAD_UP),
+          ReportMap::pressure_dpad(offsetof(PS3::InReport, down_axis), ReportMap::NO_ANALOG, Gamepad::DPAD_DOWN),
+          ReportMap::pressure_dpad(offsetof(PS3::InReport, right_axis), ReportMap::NO_ANALOG, Gamepad::DPAD_RIGHT),
+          ReportMap::pressure_dpad(offsetof(PS3::InReport, left_axis), ReportMap::NO_ANALOG, Gamepad::DPAD_LEFT),
+          ReportMap::pressure(offsetof(PS3::InReport, triangle_axis), Gamepad::ANALOG_OFF_Y, Gamepad::BUTTON_Y),
+          ReportMap::pressure(offsetof(PS3::InReport, circle_axis), Gamepad::ANALOG_OFF_B, Gamepad::BUTTON_B),
+          ReportMap::pressure(offsetof(PS3::InReport, cross_axis), Gamepad::ANALOG_OFF_A, Gamepad::BUTTON_A),
+          ReportMap::pressure(offsetof(PS3::InReport, square_axis), Gamepad::ANALOG_OFF_X, Gamepad::BUTTON_X),
+          ReportMap::pressure(offsetof(PS3::InReport, r1_axis), Gamepad::ANALOG_OFF_RB, Gamepad::BUTTON_RB),
+          ReportMap::pressure(offsetof(PS3::InReport, l1_axis), Gamepad::ANALOG_OFF_LB, Gamepad::BUTTON_LB),
+      });
+
 private:
   PS3::InReport report_in_;
   PS3::OutReport report_out_;
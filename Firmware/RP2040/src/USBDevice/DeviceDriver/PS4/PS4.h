@@ -1,9 +1,11 @@
 #ifndef _PS4_DEVICE_H_
 #define _PS4_DEVICE_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/PS4.h"
+#include "Gamepad/ReportMap.h"
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 
 class PS4Device : public DeviceDriver {
@@ -25,6 +27,39 @@ public:
   const uint8_t *get_descriptor_configuration_cb(uint8_t index) override;
   const uint8_t *get_descriptor_device_qualifier_cb() override;
 
+  static constexpr auto REPORT_MAP = ReportMap::make(
+      ReportMap::hat(
+          offsetof(PS4::InReport, buttons0),
+          {PS4::Buttons0::DPAD_UP, PS4::Buttons0::DPAD_UP_RIGHT,
+           PS4::Buttons0::DPAD_RIGHT, PS4::Buttons0::DPAD_RIGHT_DOWN,
+           PS4::Buttons0::DPAD_DOWN, PS4::Buttons0::DPAD_DOWN_LEFT,
+           PS4::Buttons0::DPAD_LEFT, PS4::Buttons0::DPAD_LEFT_UP},
+          PS4::Buttons0::DPAD_CENTER),
+      {
+          ReportMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::SQUARE, Gamepad::BUTTON_X),
+          ReportMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::CROSS, Gamepad::BUTTON_A),
+          ReportMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::CIRCLE, Gamepad::BUTTON_B),
+          ReportMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::TRIANGLE, Gamepad::BUTTON_Y),
+          ReportMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::L1, Gamepad::BUTTON_LB),
+          ReportMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::R1, Gamepad::BUTTON_RB),
+          ReportMap::trigger(offsetof(PS4::InReport, buttons1), PS4::Buttons1::L2, ReportMap::Source::TRIGGER_L),
+          ReportMap::trigger(offsetof(PS4::InReport, buttons1), PS4::Buttons1::R2, ReportMap::Source::TRIGGER_R),
+          ReportMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::SHARE, Gamepad::BUTTON_BACK),
+          ReportMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::OPTIONS, Gamepad::BUTTON_START),
+          ReportMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::L3, Gamepad::BUTTON_L3),
+          ReportMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::R3, Gamepad::BUTTON_R3),
+          ReportMap::button(offsetof(PS4::InReport, buttons2), PS4::Buttons2::PS, Gamepad::BUTTON_SYS),
+          ReportMap::button(offsetof(PS4::InReport, buttons2), PS4::Buttons2::TP, Gamepad::BUTTON_MISC),
+      },
+      {
+          ReportMap::axis(offsetof(PS4::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(PS4::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(PS4::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(PS4::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::UINT8_DEADZONE),
+          ReportMap::axis(offsetof(PS4::InReport, trigger_l), ReportMap::Source::TRIGGER_L, ReportMap::Encoding::UINT8),
+          ReportMap::axis(offsetof(PS4::InReport, trigger_r), ReportMap::Source::TRIGGER_R, ReportMap::Encoding::UINT8),
+      });
+
 private:
   PS4::InReport report_in_;
   PS4::OutReport report_out_;
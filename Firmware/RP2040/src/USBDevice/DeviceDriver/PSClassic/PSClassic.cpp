@@ -110,13 +110,17 @@ void PSClassicDevice::process(const uint8_t idx, Gamepad& gamepad)
         if (gp_in.trigger_r) in_report_.buttons |= PSClassic::Buttons::R2;
     }
 
-    if (tud_suspended())
+    if (in_report_dirty(idx, &in_report_, sizeof(PSClassic::InReport)))
     {
-        tud_remote_wakeup();
-    }
-    if (tud_hid_n_ready(idx))
-    {
-        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(PSClassic::InReport));
+        if (tud_suspended())
+        {
+            tud_remote_wakeup();
+        }
+        if (tud_hid_n_ready(idx) &&
+            tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(PSClassic::InReport)))
+        {
+            in_report_sent(idx, &in_report_, sizeof(PSClassic::InReport));
+        }
     }
 }
 
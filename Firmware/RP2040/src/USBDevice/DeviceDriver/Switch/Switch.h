@@ -1,11 +1,13 @@
 #ifndef _SWITCH_DEVICE_H_
 #define _SWITCH_DEVICE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
 
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/SwitchWired.h"
+#include "Gamepad/ReportMap.h"
 
 class SwitchDevice : public DeviceDriver 
 {
@@ -21,6 +23,34 @@ public:
     const uint8_t* get_descriptor_configuration_cb(uint8_t index) override;
     const uint8_t* get_descriptor_device_qualifier_cb() override;
 
+    static constexpr auto REPORT_MAP = ReportMap::make(
+        ReportMap::hat(offsetof(SwitchWired::InReport, dpad),
+                       { SwitchWired::DPad::UP,   SwitchWired::DPad::UP_RIGHT,  SwitchWired::DPad::RIGHT, SwitchWired::DPad::DOWN_RIGHT,
+                         SwitchWired::DPad::DOWN, SwitchWired::DPad::DOWN_LEFT, SwitchWired::DPad::LEFT,  SwitchWired::DPad::UP_LEFT },
+                       SwitchWired::DPad::CENTER),
+        {
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::Y,       Gamepad::BUTTON_X),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::B,       Gamepad::BUTTON_A),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::X,       Gamepad::BUTTON_Y),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::A,       Gamepad::BUTTON_B),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::L,       Gamepad::BUTTON_LB),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::R,       Gamepad::BUTTON_RB),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::MINUS,   Gamepad::BUTTON_BACK),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::PLUS,    Gamepad::BUTTON_START),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::L3,      Gamepad::BUTTON_L3),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::R3,      Gamepad::BUTTON_R3),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::HOME,    Gamepad::BUTTON_SYS),
+            ReportMap::button(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::CAPTURE, Gamepad::BUTTON_MISC),
+            ReportMap::trigger(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::ZL,     ReportMap::Source::TRIGGER_L),
+            ReportMap::trigger(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::ZR,     ReportMap::Source::TRIGGER_R)
+        },
+        {
+            ReportMap::axis(offsetof(SwitchWired::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(SwitchWired::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(SwitchWired::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::UINT8_CENTERED),
+            ReportMap::axis(offsetof(SwitchWired::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::UINT8_CENTERED)
+        });
+
 private:
     std::array<SwitchWired::InReport, MAX_GAMEPADS> in_report_;
 };
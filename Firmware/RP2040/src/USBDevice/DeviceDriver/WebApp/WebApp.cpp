@@ -252,6 +252,23 @@ bool WebAppDevice::write_log_packet()
     return try_write_packet(packet_in);
 }
 
+//One level byte per ogxm_log::Module
+bool WebAppDevice::write_log_levels()
+{
+    Packet packet_in;
+    packet_in.header.packet_id = PacketID::LOG_LEVEL;
+    packet_in.header.max_gamepads = MAX_GAMEPADS;
+    packet_in.header.chunks_total = 1;
+    packet_in.header.chunk_idx = 0;
+    packet_in.header.chunk_len = static_cast<uint8_t>(ogxm_log::Module::COUNT);
+
+    for (uint8_t i = 0; i < static_cast<uint8_t>(ogxm_log::Module::COUNT); ++i)
+    {
+        packet_in.data[i] = static_cast<uint8_t>(ogxm_log::get_level(static_cast<ogxm_log::Module>(i)));
+    }
+    return write_packet(packet_in);
+}
+
 void WebAppDevice::write_error()
 {
     Packet packet_in;
@@ -334,6 +351,22 @@ void WebAppDevice::process(const uint8_t idx, Gamepad& gamepad)
                 }
                 break;
 
+            //data[0] = module (Module::COUNT for all), data[1] = level, chunk_len 0 only reads the levels back
+            case PacketID::LOG_LEVEL:
+                if (packet_out.header.chunk_len >= 2 &&
+                    !ogxm_log::set_level(static_cast<ogxm_log::Module>(packet_out.data[0]),
+                                         static_cast<ogxm_log::Level>(packet_out.data[1])))
+                {
+                    write_error();
+                    return;
+                }
+                if (!write_log_levels())
+                {
+                    write_error();
+                    return;
+                }
+                break;
+
             default:
                 // write_response(PacketID::RESP_ERROR);
                 return;
@@ -32,6 +32,7 @@ private:
         SET_GP_IN = 0x80,
         SET_GP_OUT = 0x81,
         LOG_STREAM = 0x90,
+        LOG_LEVEL = 0x91,
         RESP_ERROR = 0xFF
     };
     
@@ -68,6 +69,7 @@ private:
     bool write_serial(const void* buffer, size_t len);
     bool write_packet(const Packet& packet);
     bool write_log_packet();
+    bool write_log_levels();
     bool write_profile(uint8_t index, const UserProfile& profile, PacketID packet_id);
     bool write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in);
     void write_error();  
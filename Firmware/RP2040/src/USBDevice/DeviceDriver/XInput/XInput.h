@@ -1,8 +1,11 @@
 #ifndef _XINPUT_DEVICE_H_
 #define _XINPUT_DEVICE_H_
 
+#include <cstddef>
+
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/XInput.h"
+#include "Gamepad/ReportMap.h"
 
 class XInputDevice : public DeviceDriver 
 {
@@ -18,6 +21,32 @@ public:
     const uint8_t* get_descriptor_configuration_cb(uint8_t index) override;
     const uint8_t* get_descriptor_device_qualifier_cb() override;
 
+    static constexpr auto REPORT_MAP = ReportMap::make(
+        ReportMap::dpad_bits(offsetof(XInput::InReport, buttons[0]),
+                             XInput::Buttons0::DPAD_UP, XInput::Buttons0::DPAD_DOWN,
+                             XInput::Buttons0::DPAD_LEFT, XInput::Buttons0::DPAD_RIGHT),
+        {
+            ReportMap::button(offsetof(XInput::InReport, buttons[0]), XInput::Buttons0::BACK,  Gamepad::BUTTON_BACK),
+            ReportMap::button(offsetof(XInput::InReport, buttons[0]), XInput::Buttons0::START, Gamepad::BUTTON_START),
+            ReportMap::button(offsetof(XInput::InReport, buttons[0]), XInput::Buttons0::L3,    Gamepad::BUTTON_L3),
+            ReportMap::button(offsetof(XInput::InReport, buttons[0]), XInput::Buttons0::R3,    Gamepad::BUTTON_R3),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::X,     Gamepad::BUTTON_X),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::A,     Gamepad::BUTTON_A),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::Y,     Gamepad::BUTTON_Y),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::B,     Gamepad::BUTTON_B),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::LB,    Gamepad::BUTTON_LB),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::RB,    Gamepad::BUTTON_RB),
+            ReportMap::button(offsetof(XInput::InReport, buttons[1]), XInput::Buttons1::HOME,  Gamepad::BUTTON_SYS)
+        },
+        {
+            ReportMap::axis(offsetof(XInput::InReport, trigger_l),   ReportMap::Source::TRIGGER_L,   ReportMap::Encoding::UINT8),
+            ReportMap::axis(offsetof(XInput::InReport, trigger_r),   ReportMap::Source::TRIGGER_R,   ReportMap::Encoding::UINT8),
+            ReportMap::axis(offsetof(XInput::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::INT16),
+            ReportMap::axis(offsetof(XInput::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::INT16_INVERTED),
+            ReportMap::axis(offsetof(XInput::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::INT16),
+            ReportMap::axis(offsetof(XInput::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::INT16_INVERTED)
+        });
+
 private:
     XInput::InReport in_report_;
     XInput::OutReport out_report_;
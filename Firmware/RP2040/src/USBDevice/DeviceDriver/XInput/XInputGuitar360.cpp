@@ -97,13 +97,16 @@ void XInputGuitar360Device::process(const uint8_t idx, Gamepad &gamepad) {
       in_report_.joystick_rx = 0;
     }
     in_report_.joystick_ry = Range::invert(gp_in.joystick_ry);
+  }
 
+  if (in_report_dirty(idx, &in_report_, sizeof(XInputGuitar360::InReport))) {
     if (tud_suspended()) {
       tud_remote_wakeup();
     }
-
-    tud_xinput::send_report((uint8_t *)&in_report_,
-                            sizeof(XInputGuitar360::InReport));
+    if (tud_xinput::send_report((uint8_t *)&in_report_,
+                                sizeof(XInputGuitar360::InReport))) {
+      in_report_sent(idx, &in_report_, sizeof(XInputGuitar360::InReport));
+    }
   }
 
   if (tud_xinput::receive_report(reinterpret_cast<uint8_t *>(&out_report_),
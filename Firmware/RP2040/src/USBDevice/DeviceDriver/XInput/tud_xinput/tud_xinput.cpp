@@ -8,25 +8,24 @@
 #include "device/usbd_pvt.h"
 
 #include "Descriptors/XInput.h"
+#include "USBDevice/DeviceDriver/DoubleBufferedEndpoint.h"
 #include "USBDevice/DeviceDriver/XInput/tud_xinput/tud_xinput.h"
 
 namespace tud_xinput {
 
 static constexpr uint16_t ENDPOINT_SIZE = 32;
 
-uint8_t endpoint_in_ = 0xFF;
+DoubleBufferedEndpoint<ENDPOINT_SIZE> endpoint_in_;
 uint8_t endpoint_out_ = 0xFF;
-uint8_t ep_in_buffer_[ENDPOINT_SIZE];
 uint8_t ep_out_buffer_[ENDPOINT_SIZE];
 
 //Class Driver 
 
 static void init(void)
 {
-    endpoint_in_ = 0xFF;
+    endpoint_in_.reset();
     endpoint_out_ = 0xFF;
     std::memset(ep_out_buffer_, 0, ENDPOINT_SIZE);
-    std::memset(ep_in_buffer_, 0, ENDPOINT_SIZE);
 }
 
 static bool deinit(void)
@@ -57,7 +56,7 @@ static uint16_t open(uint8_t rhport, tusb_desc_interface_t const *itf_descriptor
 
 			if (tu_edpt_dir(endpoint_descriptor->bEndpointAddress) == TUSB_DIR_IN)
             {
-				endpoint_in_ = endpoint_descriptor->bEndpointAddress;
+				endpoint_in_.open(endpoint_descriptor->bEndpointAddress, endpoint_descriptor->wMaxPacketSize);
             }
 			else
             {
@@ -82,6 +81,10 @@ static bool xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint3
 	if (ep_addr == endpoint_out_) 
     {
         usbd_edpt_xfer(BOARD_TUD_RHPORT, endpoint_out_, ep_out_buffer_, ENDPOINT_SIZE);
+    }
+    else if (ep_addr == endpoint_in_.ep_addr())
+    {
+        endpoint_in_.xfer_complete();
     }
 	return true;
 }
@@ -110,13 +113,7 @@ const usbd_class_driver_t* class_driver()
 
 bool send_report_ready()
 {
-    if (tud_ready() && 
-        (endpoint_in_ != 0xFF) && 
-        (!usbd_edpt_busy(BOARD_TUD_RHPORT, endpoint_in_)))
-    {
-        return true;
-    }
-    return false;
+    return (tud_ready() && endpoint_in_.is_open());
 }
 
 bool receive_report_ready()
@@ -132,15 +129,17 @@ bool receive_report_ready()
 
 bool send_report(const uint8_t *report, uint16_t len)
 {
-    if (send_report_ready())
-    {
-        std::memcpy(ep_in_buffer_, report, std::min(len, ENDPOINT_SIZE));
-        usbd_edpt_claim(BOARD_TUD_RHPORT, endpoint_in_);
-        usbd_edpt_xfer(BOARD_TUD_RHPORT, endpoint_in_, ep_in_buffer_, sizeof(XInput::InReport));
-        usbd_edpt_release(BOARD_TUD_RHPORT, endpoint_in_);
-        return true;
-    }
-    return false;
+    return endpoint_in_.send(report, len);
+}
+
+uint8_t* report_buffer()
+{
+    return endpoint_in_.back_buffer();
+}
+
+bool commit_report(uint16_t len)
+{
+    return endpoint_in_.commit(len);
 }
 
 bool receive_report(uint8_t *report, uint16_t len)
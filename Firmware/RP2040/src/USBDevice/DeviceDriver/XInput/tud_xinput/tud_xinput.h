@@ -8,8 +8,14 @@
 
 namespace tud_xinput 
 {
+    //True once the IN endpoint is open and will accept a report, even while a transfer is in flight
     bool send_report_ready();
+    //Copies into the back buffer and commits it
     bool send_report(const uint8_t *report, uint16_t len);
+    //Back buffer of the double buffered IN endpoint, fill it in place then commit_report()
+    uint8_t* report_buffer();
+    //Queues the back buffer, it's armed now or as soon as the current transfer completes
+    bool commit_report(uint16_t len);
     bool receive_report(uint8_t *report, uint16_t len);
     const usbd_class_driver_t* class_driver();
     
@@ -1,10 +1,12 @@
 #ifndef _XBOXGOG_DEVICE_H_
 #define _XBOXGOG_DEVICE_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/XboxOG.h"
+#include "Gamepad/ReportMap.h"
 
 class XboxOGDevice : public DeviceDriver 
 {
@@ -20,6 +22,33 @@ public:
     const uint8_t* get_descriptor_configuration_cb(uint8_t index) override;
     const uint8_t* get_descriptor_device_qualifier_cb() override;
 
+    static constexpr auto REPORT_MAP = ReportMap::make(
+        ReportMap::dpad_bits(offsetof(XboxOG::GP::InReport, buttons),
+                             XboxOG::GP::Buttons::DPAD_UP, XboxOG::GP::Buttons::DPAD_DOWN,
+                             XboxOG::GP::Buttons::DPAD_LEFT, XboxOG::GP::Buttons::DPAD_RIGHT),
+        {
+            ReportMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::BACK,  Gamepad::BUTTON_BACK),
+            ReportMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::START, Gamepad::BUTTON_START),
+            ReportMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::L3,    Gamepad::BUTTON_L3),
+            ReportMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::R3,    Gamepad::BUTTON_R3)
+        },
+        {
+            ReportMap::axis(offsetof(XboxOG::GP::InReport, trigger_l),   ReportMap::Source::TRIGGER_L,   ReportMap::Encoding::UINT8),
+            ReportMap::axis(offsetof(XboxOG::GP::InReport, trigger_r),   ReportMap::Source::TRIGGER_R,   ReportMap::Encoding::UINT8),
+            ReportMap::axis(offsetof(XboxOG::GP::InReport, joystick_lx), ReportMap::Source::JOYSTICK_LX, ReportMap::Encoding::INT16),
+            ReportMap::axis(offsetof(XboxOG::GP::InReport, joystick_ly), ReportMap::Source::JOYSTICK_LY, ReportMap::Encoding::INT16_INVERTED),
+            ReportMap::axis(offsetof(XboxOG::GP::InReport, joystick_rx), ReportMap::Source::JOYSTICK_RX, ReportMap::Encoding::INT16),
+            ReportMap::axis(offsetof(XboxOG::GP::InReport, joystick_ry), ReportMap::Source::JOYSTICK_RY, ReportMap::Encoding::INT16_INVERTED)
+        },
+        {
+            ReportMap::pressure(offsetof(XboxOG::GP::InReport, a),     Gamepad::ANALOG_OFF_A,  Gamepad::BUTTON_A),
+            ReportMap::pressure(offsetof(XboxOG::GP::InReport, b),     Gamepad::ANALOG_OFF_B,  Gamepad::BUTTON_B),
+            ReportMap::pressure(offsetof(XboxOG::GP::InReport, x),     Gamepad::ANALOG_OFF_X,  Gamepad::BUTTON_X),
+            ReportMap::pressure(offsetof(XboxOG::GP::InReport, y),     Gamepad::ANALOG_OFF_Y,  Gamepad::BUTTON_Y),
+            ReportMap::pressure(offsetof(XboxOG::GP::InReport, white), Gamepad::ANALOG_OFF_LB, Gamepad::BUTTON_LB),
+            ReportMap::pressure(offsetof(XboxOG::GP::InReport, black), Gamepad::ANALOG_OFF_RB, Gamepad::BUTTON_RB)
+        });
+
 private:
     XboxOG::GP::InReport in_report_;
     XboxOG::GP::OutReport out_report_;
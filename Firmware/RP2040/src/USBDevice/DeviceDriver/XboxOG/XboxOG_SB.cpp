@@ -81,14 +81,21 @@ void XboxOGSBDevice::initialize()
     std::memset(&in_report_, 0, sizeof(XboxOG::SB::InReport));
     in_report_.bLength = sizeof(XboxOG::SB::InReport);
     in_report_.gearLever = XboxOG::SB::Gear::N;
-
-    prev_in_report_ = in_report_;
 }
 
 void XboxOGSBDevice::process(const uint8_t idx, Gamepad& gamepad) 
 {
-    Gamepad::PadIn gp_in = gamepad.get_pad_in();
-    Gamepad::ChatpadIn gp_in_chatpad = gamepad.get_chatpad_in();
+    //The aim and toggle state advance every pass, only refresh the inputs when they change
+    if (gamepad.new_pad_in())
+    {
+        gp_in_ = gamepad.get_pad_in();
+    }
+    if (gamepad.new_chatpad_in())
+    {
+        gp_in_chatpad_ = gamepad.get_chatpad_in();
+    }
+    const Gamepad::PadIn& gp_in = gp_in_;
+    const Gamepad::ChatpadIn& gp_in_chatpad = gp_in_chatpad_;
 
     in_report_.dButtons[0] = 0;
     in_report_.dButtons[1] = 0;
@@ -273,15 +280,17 @@ void XboxOGSBDevice::process(const uint8_t idx, Gamepad& gamepad)
     in_report_.aimingX = static_cast<uint16_t>(vmouse_x_);
     in_report_.aimingY = static_cast<uint16_t>(vmouse_y_);
 
-    if (tud_suspended())
+    if (in_report_dirty(idx, &in_report_, sizeof(XboxOG::SB::InReport)))
     {
-        tud_remote_wakeup();
-    }
-    if (tud_xid::send_report_ready(0) &&
-        std::memcmp(&prev_in_report_, &in_report_, sizeof(XboxOG::SB::InReport)) &&
-        tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::SB::InReport)))
-    {
-        std::memcpy(&prev_in_report_, &in_report_, sizeof(XboxOG::SB::InReport));
+        if (tud_suspended())
+        {
+            tud_remote_wakeup();
+        }
+        if (tud_xid::send_report_ready(0) &&
+            tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::SB::InReport)))
+        {
+            in_report_sent(idx, &in_report_, sizeof(XboxOG::SB::InReport));
+        }
     }
 
     if (chatpad_pressed(gp_in_chatpad, XInput::Chatpad::CODE_ORANGE))
@@ -39,8 +39,10 @@ private:
     bool dpad_reset_ = true;
     
 
+    Gamepad::PadIn gp_in_{};
+    Gamepad::ChatpadIn gp_in_chatpad_{};
+
     XboxOG::SB::InReport in_report_;
-    XboxOG::SB::InReport prev_in_report_;
     XboxOG::SB::OutReport out_report_;
 
     static inline bool chatpad_pressed(const Gamepad::ChatpadIn& chatpad, const uint16_t keycode)
@@ -3,6 +3,7 @@
 
 #include <cstring>
 
+#include "USBDevice/DeviceDriver/DoubleBufferedEndpoint.h"
 #include "USBDevice/DeviceDriver/XboxOG/tud_xid/tud_xid.h"
 #include "Descriptors/XboxOG.h"
 
@@ -28,19 +29,16 @@ struct Interface
 
     uint8_t itf_num{0xFF};
     
-    uint8_t ep_in{0xFF};
+    DoubleBufferedEndpoint<ENDPOINT_SIZE> ep_in;
     uint8_t ep_out{0xFF};
 
-    uint16_t ep_in_size{ENDPOINT_SIZE};
     uint16_t ep_out_size{ENDPOINT_SIZE};
 
-    std::array<uint8_t, ENDPOINT_SIZE> ep_in_buffer;
     std::array<uint8_t, ENDPOINT_SIZE> ep_out_buffer;
 
     Interface()
     {
         ep_out_buffer.fill(0);
-        ep_in_buffer.fill(0);
     }
 };
 
@@ -98,7 +96,7 @@ static inline uint8_t get_idx_by_edpt(uint8_t edpt)
 {
     for (uint8_t i = 0; i < interfaces_.size(); i++)
     {
-        if (interfaces_[i].ep_in == edpt || interfaces_[i].ep_out == edpt)
+        if (interfaces_[i].ep_in.ep_addr() == edpt || interfaces_[i].ep_out == edpt)
         {
             return i;
         }
@@ -210,8 +208,7 @@ static uint16_t xid_open(uint8_t rhport, tusb_desc_interface_t const *itf_desc,
 
         if (tu_edpt_dir(ep_desc->bEndpointAddress) == TUSB_DIR_IN)
         {
-            interface->ep_in  = ep_desc->bEndpointAddress;
-            interface->ep_in_size = ep_desc->wMaxPacketSize;
+            interface->ep_in.open(ep_desc->bEndpointAddress, ep_desc->wMaxPacketSize);
         }
         else
         {
@@ -231,12 +228,14 @@ static uint16_t xid_open(uint8_t rhport, tusb_desc_interface_t const *itf_desc,
 
 static bool xid_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
 {
-    // uint8_t index = get_idx_by_edpt(ep_addr);
-
-    // TU_VERIFY(result == XFER_RESULT_SUCCESS, true);
-    // TU_VERIFY(index != 0xFF, true);
-    // TU_VERIFY(xferred_bytes < ENDPOINT_SIZE, true);
+    uint8_t index = get_idx_by_edpt(ep_addr);
+    TU_VERIFY(index != 0xFF, true);
 
+    if (ep_addr == interfaces_[index].ep_in.ep_addr())
+    {
+        //Arm the newest committed report right away
+        interfaces_[index].ep_in.xfer_complete();
+    }
     return true;
 }
 
@@ -294,7 +293,7 @@ bool xid_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t c
         if (stage == CONTROL_STAGE_SETUP)
         {
             TU_LOG1("Sending HID report on control pipe for index %02x\n", request->wIndex);
-            tud_control_xfer(rhport, request, interface.ep_in_buffer.data(), std::min(request->wLength, interface.ep_in_size));
+            tud_control_xfer(rhport, request, const_cast<uint8_t*>(interface.ep_in.front_buffer()), std::min(request->wLength, interface.ep_in.ep_size()));
         }
         return true;
     }
@@ -375,8 +374,7 @@ const usbd_class_driver_t* class_driver()
 bool send_report_ready(uint8_t index)
 {
     TU_VERIFY(index < interfaces_.size(), false);
-    TU_VERIFY(interfaces_[index].ep_in != 0xFF, false);
-    return (tud_ready() && !usbd_edpt_busy(BOARD_TUD_RHPORT, interfaces_[index].ep_in));
+    return (tud_ready() && interfaces_[index].ep_in.is_open());
 }
 
 bool send_report(uint8_t index, const uint8_t* report, uint16_t len)
@@ -389,11 +387,26 @@ bool send_report(uint8_t index, const uint8_t* report, uint16_t len)
         tud_remote_wakeup();
     }
 
-    uint16_t size = std::min(len, interfaces_[index].ep_in_size);
+    return interfaces_[index].ep_in.send(report, len);
+}
+
+uint8_t* report_buffer(uint8_t index)
+{
+    TU_VERIFY(index < interfaces_.size(), nullptr);
+    return interfaces_[index].ep_in.back_buffer();
+}
 
-    std::memcpy(interfaces_[index].ep_in_buffer.data(), report, size);
+bool commit_report(uint8_t index, uint16_t len)
+{
+    TU_VERIFY(len < ENDPOINT_SIZE, false);
+    TU_VERIFY(send_report_ready(index), false);
+
+    if (tud_suspended())
+    {
+        tud_remote_wakeup();
+    }
 
-    return usbd_edpt_xfer(BOARD_TUD_RHPORT, interfaces_[index].ep_in, interfaces_[index].ep_in_buffer.data(), size);
+    return interfaces_[index].ep_in.commit(len);
 }
 
 bool receive_report(uint8_t index, uint8_t *report, uint16_t len)
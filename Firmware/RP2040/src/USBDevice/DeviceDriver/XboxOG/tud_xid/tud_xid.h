@@ -46,8 +46,14 @@ namespace tud_xid
 
     uint8_t get_index_by_type(uint8_t type_index, tud_xid::Type xid_type);
     bool receive_report(uint8_t idx, uint8_t* buffer, uint16_t len);
+    //Copies into the back buffer of the double buffered IN endpoint and commits it
     bool send_report(uint8_t idx, const uint8_t* buffer, uint16_t len);
+    //True once the IN endpoint is open and will accept a report, even while a transfer is in flight
     bool send_report_ready(uint8_t idx);
+    //Back buffer to fill in place, then commit_report()
+    uint8_t* report_buffer(uint8_t idx);
+    //Queues the back buffer, it's armed now or as soon as the current transfer completes
+    bool commit_report(uint8_t idx, uint16_t len);
     bool xremote_rom_available();
 
 } // namespace TUDXID
@@ -22,48 +22,7 @@ void DInputHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
 
     Gamepad::PadIn gp_in;
 
-    switch (in_report->dpad & DInput::DPAD_MASK)
-    {
-        case DInput::DPad::UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
-            break;
-        case DInput::DPad::DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-            break;
-        case DInput::DPad::LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-            break;
-        case DInput::DPad::RIGHT: 
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-            break;
-        case DInput::DPad::UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
-            break;
-        case DInput::DPad::DOWN_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
-            break;
-        case DInput::DPad::DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
-            break;
-        case DInput::DPad::UP_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
-            break;
-        default:
-            break;
-    }
-
-    if (in_report->buttons[0] & DInput::Buttons0::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[0] & DInput::Buttons0::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & DInput::Buttons0::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & DInput::Buttons0::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[0] & DInput::Buttons0::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[0] & DInput::Buttons0::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & DInput::Buttons1::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[1] & DInput::Buttons1::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3; 
-    if (in_report->buttons[1] & DInput::Buttons1::SELECT)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & DInput::Buttons1::START)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[1] & DInput::Buttons1::SYS)      gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & DInput::Buttons1::TP)       gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    button_map_.translate(gamepad, report, gp_in);
 
     if (gamepad.analog_enabled())
     {
@@ -105,7 +64,7 @@ void DInputHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
     std::memcpy(&prev_in_report_, in_report, sizeof(DInput::InReport));
 }
 
-bool DInputHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback DInputHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
-    return true;
+    return Feedback::NONE;
 }
\ No newline at end of file
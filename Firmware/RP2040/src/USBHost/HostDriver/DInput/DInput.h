@@ -1,9 +1,11 @@
 #ifndef _DINPUT_HOST_H_
 #define _DINPUT_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/DInput.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class DInputHost : public HostDriver
@@ -14,9 +16,26 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::hat(offsetof(DInput::InReport, dpad), DInput::DPAD_MASK),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::SQUARE,   Gamepad::BUTTON_X),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::CROSS,    Gamepad::BUTTON_A),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::CIRCLE,   Gamepad::BUTTON_B),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::TRIANGLE, Gamepad::BUTTON_Y),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::L1,       Gamepad::BUTTON_LB),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[0]), DInput::Buttons0::R1,       Gamepad::BUTTON_RB),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::L3,       Gamepad::BUTTON_L3),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::R3,       Gamepad::BUTTON_R3),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::SELECT,   Gamepad::BUTTON_BACK),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::START,    Gamepad::BUTTON_START),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::SYS,      Gamepad::BUTTON_SYS),
+        ButtonMap::button(offsetof(DInput::InReport, buttons[1]), DInput::Buttons1::TP,       Gamepad::BUTTON_MISC)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     DInput::InReport prev_in_report_{};
 };
 
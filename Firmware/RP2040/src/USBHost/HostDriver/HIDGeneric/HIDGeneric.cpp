@@ -40,71 +40,20 @@ void HIDHost::process_report(Gamepad &gamepad, uint8_t address,
 
   Gamepad::PadIn gp_in;
 
-  switch (hid_joystick_data_.hat_switch) {
-  case HIDJoystickHatSwitch::UP:
-    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    break;
-  case HIDJoystickHatSwitch::UP_RIGHT:
-    gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
-    break;
-  case HIDJoystickHatSwitch::RIGHT:
-    gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-    break;
-  case HIDJoystickHatSwitch::DOWN_RIGHT:
-    gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
-    break;
-  case HIDJoystickHatSwitch::DOWN:
-    gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    break;
-  case HIDJoystickHatSwitch::DOWN_LEFT:
-    gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
-    break;
-  case HIDJoystickHatSwitch::LEFT:
-    gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    break;
-  case HIDJoystickHatSwitch::UP_LEFT:
-    gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
-    break;
-  default:
-    break;
-  }
+  const uint8_t hat_switch =
+      static_cast<uint8_t>(hid_joystick_data_.hat_switch);
+  hat_map_.translate(gamepad, &hat_switch, gp_in);
+  button_map_.translate(gamepad, hid_joystick_data_.buttons, gp_in);
 
   std::tie(gp_in.joystick_lx, gp_in.joystick_ly) =
       gamepad.scale_joystick_l(hid_joystick_data_.X, hid_joystick_data_.Y);
   std::tie(gp_in.joystick_rx, gp_in.joystick_ry) =
       gamepad.scale_joystick_r(hid_joystick_data_.Z, hid_joystick_data_.Rz);
 
-  // PlayStation button layout fix: Invert from Nintendo layout to PS layout
-  // Nintendo: Y-X / B-A   ->   PlayStation: X-Y / A-B
-  // HID button order for PS2->PS3 adapter needs inversion
-  if (hid_joystick_data_.buttons[1])
-    gp_in.buttons |= gamepad.MAP_BUTTON_Y; // Was showing as X, now Y (Triangle)
-  if (hid_joystick_data_.buttons[2])
-    gp_in.buttons |= gamepad.MAP_BUTTON_B; // Was showing as A, now B (Circle)
-  if (hid_joystick_data_.buttons[3])
-    gp_in.buttons |= gamepad.MAP_BUTTON_A; // Was showing as B, now A (Cross)
-  if (hid_joystick_data_.buttons[4])
-    gp_in.buttons |= gamepad.MAP_BUTTON_X; // Was showing as Y, now X (Square)
-  if (hid_joystick_data_.buttons[5])
-    gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-  if (hid_joystick_data_.buttons[6])
-    gp_in.buttons |= gamepad.MAP_BUTTON_RB;
   if (hid_joystick_data_.buttons[7])
     gp_in.trigger_l = Range::MAX<uint8_t>;
   if (hid_joystick_data_.buttons[8])
     gp_in.trigger_r = Range::MAX<uint8_t>;
-  if (hid_joystick_data_.buttons[9])
-    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-  if (hid_joystick_data_.buttons[10])
-    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-  if (hid_joystick_data_.buttons[11])
-    gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-  if (hid_joystick_data_.buttons[12])
-    gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-  if (hid_joystick_data_.buttons[13])
-    gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-  if (hid_joystick_data_.buttons[14])
-    gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
 
   // Note: accel_x field was removed from PadIn to fix PS3 controller issues.
   // PS3 Guitar tilt sensor is not currently supported in HIDHost.
@@ -114,7 +63,7 @@ void HIDHost::process_report(Gamepad &gamepad, uint8_t address,
   tuh_hid_receive_report(address, instance);
 }
 
-bool HIDHost::send_feedback(Gamepad &gamepad, uint8_t address,
-                            uint8_t instance) {
-  return true;
+HostDriver::Feedback HIDHost::send_feedback(Gamepad &gamepad, uint8_t address,
+                                            uint8_t instance) {
+  return Feedback::NONE;
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "tusb_option.h"
 
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HIDParser/HIDJoystick.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
@@ -18,9 +19,30 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, uint8_t const* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    static constexpr auto HAT_MAP = ButtonMap::make(ButtonMap::hat(0, 0xFF));
+
+    //Offsets relative to HIDJoystickData::buttons, one byte per button.
+    //PlayStation layout fix: HID order for PS2->PS3 adapters is Nintendo style (Y-X / B-A)
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::button(1,  0xFF, Gamepad::BUTTON_Y),
+        ButtonMap::button(2,  0xFF, Gamepad::BUTTON_B),
+        ButtonMap::button(3,  0xFF, Gamepad::BUTTON_A),
+        ButtonMap::button(4,  0xFF, Gamepad::BUTTON_X),
+        ButtonMap::button(5,  0xFF, Gamepad::BUTTON_LB),
+        ButtonMap::button(6,  0xFF, Gamepad::BUTTON_RB),
+        ButtonMap::button(9,  0xFF, Gamepad::BUTTON_BACK),
+        ButtonMap::button(10, 0xFF, Gamepad::BUTTON_START),
+        ButtonMap::button(11, 0xFF, Gamepad::BUTTON_L3),
+        ButtonMap::button(12, 0xFF, Gamepad::BUTTON_R3),
+        ButtonMap::button(13, 0xFF, Gamepad::BUTTON_SYS),
+        ButtonMap::button(14, 0xFF, Gamepad::BUTTON_MISC)
+    );
+
+    ButtonMap::Translator<HAT_MAP> hat_map_;
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     std::array<uint8_t, 0x100> report_desc_buffer_;
     uint16_t report_desc_len_{0};
     std::array<uint8_t, CFG_TUH_HID_EPIN_BUFSIZE> prev_report_in_{0};
@@ -12,6 +12,14 @@
 class HostDriver
 {
 public:
+    //What send_feedback did with the gamepad's pad out
+    enum class Feedback
+    {
+        SENT,   //Queued, done with this pad out
+        BUSY,   //Couldn't queue it yet, HostManager keeps it pending and calls again
+        NONE    //Nothing to send for it (no rumble, not ready), HostManager drops it
+    };
+
     HostDriver(uint8_t idx)
         : idx_(idx) {}
 
@@ -19,7 +27,7 @@ public:
 
     virtual void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, uint8_t const* report_desc, uint16_t desc_len) = 0;
     virtual void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) = 0;
-    virtual bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) = 0;
+    virtual Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) = 0;
     virtual void report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) {};
     virtual void get_report_complete_cb(Gamepad& gamepad, uint8_t address, uint8_t instance,
                                         uint8_t report_id, uint8_t report_type, uint16_t len) {};
@@ -21,41 +21,7 @@ void N64Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
     Gamepad::PadIn gp_in;   
 
-    switch (in_report->buttons & N64::DPAD_MASK)
-    {
-        case N64::Buttons::DPAD_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
-            break;
-        case N64::Buttons::DPAD_UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
-            break;
-        case N64::Buttons::DPAD_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;  
-            break;
-        case N64::Buttons::DPAD_RIGHT_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
-            break;
-        case N64::Buttons::DPAD_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-            break;
-        case N64::Buttons::DPAD_DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
-            break;
-        case N64::Buttons::DPAD_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-            break;
-        case N64::Buttons::DPAD_LEFT_UP:    
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
-            break;  
-        default:
-            break;
-    }
-
-    if (in_report->buttons & N64::Buttons::A) gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons & N64::Buttons::B) gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons & N64::Buttons::L) gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons & N64::Buttons::R) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons & N64::Buttons::START) gp_in.buttons |= gamepad.MAP_BUTTON_START;
+    button_map_.translate(gamepad, report, gp_in);
 
     uint8_t joy_ry = N64::JOY_MID;
     uint8_t joy_rx = N64::JOY_MID;
@@ -105,7 +71,7 @@ void N64Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::memcpy(&prev_in_report_, in_report, sizeof(N64::InReport));
 }
 
-bool N64Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback N64Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
-    return true;
+    return Feedback::NONE;
 }
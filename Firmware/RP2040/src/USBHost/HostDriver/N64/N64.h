@@ -1,9 +1,11 @@
 #ifndef _N64_HOST_H_
 #define _N64_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/N64.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class N64Host : public HostDriver
@@ -14,9 +16,19 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::hat(offsetof(N64::InReport, buttons), N64::DPAD_MASK),
+        ButtonMap::button16(offsetof(N64::InReport, buttons), N64::Buttons::A,     Gamepad::BUTTON_A),
+        ButtonMap::button16(offsetof(N64::InReport, buttons), N64::Buttons::B,     Gamepad::BUTTON_B),
+        ButtonMap::button16(offsetof(N64::InReport, buttons), N64::Buttons::L,     Gamepad::BUTTON_LB),
+        ButtonMap::button16(offsetof(N64::InReport, buttons), N64::Buttons::R,     Gamepad::BUTTON_RB),
+        ButtonMap::button16(offsetof(N64::InReport, buttons), N64::Buttons::START, Gamepad::BUTTON_START)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     N64::InReport prev_in_report_{};
 };
 
@@ -106,22 +106,7 @@ void PS3Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
     Gamepad::PadIn gp_in;   
 
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (in_report->buttons[0] & PS3::Buttons0::SELECT)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[0] & PS3::Buttons0::START)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[0] & PS3::Buttons0::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[0] & PS3::Buttons0::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & PS3::Buttons1::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[1] & PS3::Buttons1::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & PS3::Buttons1::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[1] & PS3::Buttons1::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[1] & PS3::Buttons1::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[1] & PS3::Buttons1::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[2] & PS3::Buttons2::SYS)      gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
+    button_map_.translate(gamepad, report, gp_in);
 
     if (gamepad.analog_enabled())
     {
@@ -149,15 +134,19 @@ void PS3Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::memcpy(&prev_in_report_, in_report, sizeof(PS3::InReport));
 }
 
-bool PS3Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback PS3Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
     static uint32_t last_rumble_ms = 0;
 
+    if (!init_state_.reports_enabled)
+    {
+        return Feedback::NONE;
+    }
+
     uint32_t current_ms = time_us_32() / 1000;
     
     //Spamming set_report doesn't work, limit the rate
-    if (init_state_.reports_enabled &&
-        current_ms - last_rumble_ms >= 300)
+    if (current_ms - last_rumble_ms >= 300)
     {
         Gamepad::PadOut gp_out = gamepad.get_pad_out();
 
@@ -169,7 +158,8 @@ bool PS3Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 
         last_rumble_ms = current_ms;
 
-        return send_control_xfer(address, &PS3Host::RUMBLE_REQUEST, reinterpret_cast<uint8_t*>(&out_report_), nullptr, 0);
+        return send_control_xfer(address, &PS3Host::RUMBLE_REQUEST, reinterpret_cast<uint8_t*>(&out_report_), nullptr, 0)
+               ? Feedback::SENT : Feedback::BUSY;
     }
-    return true;
+    return Feedback::BUSY; //Rate limited, HostManager retries it
 }
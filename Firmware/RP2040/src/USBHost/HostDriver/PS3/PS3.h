@@ -1,12 +1,14 @@
 #ifndef _PS3_HOST_H_
 #define _PS3_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
 
 #include "tusb.h"
 
 #include "Descriptors/PS3.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class PS3Host : public HostDriver
@@ -17,7 +19,7 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
     enum class InitStage { RESP1, RESP2, RESP3, DONE };
@@ -33,6 +35,25 @@ private:
 
     static const tusb_control_request_t RUMBLE_REQUEST;
 
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::dpad(offsetof(PS3::InReport, buttons[0]),   PS3::Buttons0::DPAD_UP,    Gamepad::DPAD_UP),
+        ButtonMap::dpad(offsetof(PS3::InReport, buttons[0]),   PS3::Buttons0::DPAD_DOWN,  Gamepad::DPAD_DOWN),
+        ButtonMap::dpad(offsetof(PS3::InReport, buttons[0]),   PS3::Buttons0::DPAD_LEFT,  Gamepad::DPAD_LEFT),
+        ButtonMap::dpad(offsetof(PS3::InReport, buttons[0]),   PS3::Buttons0::DPAD_RIGHT, Gamepad::DPAD_RIGHT),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::SELECT,     Gamepad::BUTTON_BACK),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::START,      Gamepad::BUTTON_START),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::L3,         Gamepad::BUTTON_L3),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[0]), PS3::Buttons0::R3,         Gamepad::BUTTON_R3),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::L1,         Gamepad::BUTTON_LB),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::R1,         Gamepad::BUTTON_RB),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::TRIANGLE,   Gamepad::BUTTON_Y),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::CIRCLE,     Gamepad::BUTTON_B),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::CROSS,      Gamepad::BUTTON_A),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[1]), PS3::Buttons1::SQUARE,     Gamepad::BUTTON_X),
+        ButtonMap::button(offsetof(PS3::InReport, buttons[2]), PS3::Buttons2::SYS,        Gamepad::BUTTON_SYS)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     PS3::InReport prev_in_report_;
     PS3::OutReport out_report_;
     InitState init_state_;
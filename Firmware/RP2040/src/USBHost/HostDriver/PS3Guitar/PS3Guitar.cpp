@@ -150,9 +150,10 @@ void PS3GuitarHost::process_report(Gamepad &gamepad, uint8_t address,
   tuh_hid_receive_report(address, instance);
 }
 
-bool PS3GuitarHost::send_feedback(Gamepad &gamepad, uint8_t address,
-                                  uint8_t instance) {
+HostDriver::Feedback PS3GuitarHost::send_feedback(Gamepad &gamepad,
+                                                  uint8_t address,
+                                                  uint8_t instance) {
   // Guitar Hero guitars don't typically have rumble
   // But we could implement LED control here if needed
-  return true;
+  return Feedback::NONE;
 }
@@ -18,8 +18,8 @@ public:
                   const uint8_t *report_desc, uint16_t desc_len) override;
   void process_report(Gamepad &gamepad, uint8_t address, uint8_t instance,
                       const uint8_t *report, uint16_t len) override;
-  bool send_feedback(Gamepad &gamepad, uint8_t address,
-                     uint8_t instance) override;
+  Feedback send_feedback(Gamepad &gamepad, uint8_t address,
+                         uint8_t instance) override;
 
 private:
   enum class InitStage { ENABLE_REPORT, DONE };
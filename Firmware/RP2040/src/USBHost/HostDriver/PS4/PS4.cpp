@@ -26,48 +26,7 @@ void PS4Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
     Gamepad::PadIn gp_in;   
 
-    switch (in_report_.buttons0 & PS4::DPAD_MASK)
-    {
-        case PS4::Buttons0::DPAD_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
-            break;
-        case PS4::Buttons0::DPAD_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;    
-            break;
-        case PS4::Buttons0::DPAD_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT; 
-            break;
-        case PS4::Buttons0::DPAD_RIGHT: 
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-            break;
-        case PS4::Buttons0::DPAD_UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
-            break;
-        case PS4::Buttons0::DPAD_RIGHT_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
-            break;
-        case PS4::Buttons0::DPAD_DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
-            break;
-        case PS4::Buttons0::DPAD_LEFT_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
-            break;
-        default:
-            break;
-    }
-
-    if (in_report_.buttons0 & PS4::Buttons0::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report_.buttons0 & PS4::Buttons0::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report_.buttons0 & PS4::Buttons0::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report_.buttons0 & PS4::Buttons0::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y; 
-    if (in_report_.buttons1 & PS4::Buttons1::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report_.buttons1 & PS4::Buttons1::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report_.buttons1 & PS4::Buttons1::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report_.buttons1 & PS4::Buttons1::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report_.buttons1 & PS4::Buttons1::SHARE)    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report_.buttons1 & PS4::Buttons1::OPTIONS)  gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report_.buttons2 & PS4::Buttons2::PS)       gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report_.buttons2 & PS4::Buttons2::TP)       gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    button_map_.translate(gamepad, reinterpret_cast<const uint8_t*>(&in_report_), gp_in);
 
     gp_in.trigger_l = gamepad.scale_trigger_l(in_report_.trigger_l);
     gp_in.trigger_r = gamepad.scale_trigger_r(in_report_.trigger_r);
@@ -81,7 +40,7 @@ void PS4Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::memcpy(&prev_in_report_, &in_report_, sizeof(PS4::InReport));
 }
 
-bool PS4Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback PS4Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
     Gamepad::PadOut gp_out = gamepad.get_pad_out();
     out_report_.motor_left = gp_out.rumble_l;
@@ -91,7 +50,7 @@ bool PS4Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
     if (tuh_hid_send_report(address, instance, 0, reinterpret_cast<const uint8_t*>(&out_report_), sizeof(PS4::OutReport)))
     {
         manage_rumble(gamepad);
-        return true;
+        return Feedback::SENT;
     }
-    return false;
+    return Feedback::BUSY;
 }
\ No newline at end of file
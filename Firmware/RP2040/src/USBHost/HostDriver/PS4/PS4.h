@@ -1,9 +1,11 @@
 #ifndef _PS4_HOST_H_
 #define _PS4_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/PS4.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class PS4Host : public HostDriver
@@ -14,9 +16,26 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::hat(offsetof(PS4::InReport, buttons0), PS4::DPAD_MASK),
+        ButtonMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::SQUARE,   Gamepad::BUTTON_X),
+        ButtonMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::CROSS,    Gamepad::BUTTON_A),
+        ButtonMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::CIRCLE,   Gamepad::BUTTON_B),
+        ButtonMap::button(offsetof(PS4::InReport, buttons0), PS4::Buttons0::TRIANGLE, Gamepad::BUTTON_Y),
+        ButtonMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::L1,       Gamepad::BUTTON_LB),
+        ButtonMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::R1,       Gamepad::BUTTON_RB),
+        ButtonMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::L3,       Gamepad::BUTTON_L3),
+        ButtonMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::R3,       Gamepad::BUTTON_R3),
+        ButtonMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::SHARE,    Gamepad::BUTTON_BACK),
+        ButtonMap::button(offsetof(PS4::InReport, buttons1), PS4::Buttons1::OPTIONS,  Gamepad::BUTTON_START),
+        ButtonMap::button(offsetof(PS4::InReport, buttons2), PS4::Buttons2::PS,       Gamepad::BUTTON_SYS),
+        ButtonMap::button(offsetof(PS4::InReport, buttons2), PS4::Buttons2::TP,       Gamepad::BUTTON_MISC)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     PS4::InReport in_report_{};
     PS4::InReport prev_in_report_{};
     PS4::OutReport out_report_{};
@@ -7,19 +7,8 @@
 
 void PS5Host::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) 
 {
-    out_report_.report_id = PS5::OutReportID::CONTROL;
-    out_report_.control_flag[0] = 2;
-    out_report_.control_flag[1] = 2;
-    out_report_.led_control_flag = 0x01 | 0x02;
-    out_report_.pulse_option = 1;
-    out_report_.led_brightness = 0xFF;
-    out_report_.player_number = idx_ + 1;
-    out_report_.lightbar_blue = 0xFF;
-
-    while (!tuh_hid_send_report(address, instance, 0, &out_report_, sizeof(PS5::OutReport)))
-    {
-        tuh_task();
-    }
+    //If the endpoint's busy the LED report is retried from the report callbacks, nothing waits here
+    led_pending_ = !send_led_report(address, instance);
 
     out_report_ = PS5::OutReport();
     out_report_.report_id = PS5::OutReportID::RUMBLE;
@@ -30,8 +19,36 @@ void PS5Host::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, co
     tuh_hid_receive_report(address, instance);
 }
 
+bool PS5Host::send_led_report(uint8_t address, uint8_t instance)
+{
+    PS5::OutReport led_report;
+    led_report.report_id = PS5::OutReportID::CONTROL;
+    led_report.control_flag[0] = 2;
+    led_report.control_flag[1] = 2;
+    led_report.led_control_flag = 0x01 | 0x02;
+    led_report.pulse_option = 1;
+    led_report.led_brightness = 0xFF;
+    led_report.player_number = idx_ + 1;
+    led_report.lightbar_blue = 0xFF;
+
+    return tuh_hid_send_report(address, instance, 0, &led_report, sizeof(PS5::OutReport));
+}
+
+void PS5Host::report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
+{
+    if (led_pending_)
+    {
+        led_pending_ = !send_led_report(address, instance);
+    }
+}
+
 void PS5Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 {
+    if (led_pending_)
+    {
+        led_pending_ = !send_led_report(address, instance);
+    }
+
     const PS5::InReport* in_report = reinterpret_cast<const PS5::InReport*>(report);
 
     if (std::memcmp(&prev_in_report_.joystick_lx, &in_report->joystick_lx, sizeof(uint8_t) * 6) == 0 &&
@@ -43,48 +60,7 @@ void PS5Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
     Gamepad::PadIn gp_in;   
 
-    switch (in_report->buttons[0] & PS5::DPAD_MASK)
-    {
-        case PS5::Buttons0::DPAD_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
-            break;
-        case PS5::Buttons0::DPAD_UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
-            break;
-        case PS5::Buttons0::DPAD_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-            break;
-        case PS5::Buttons0::DPAD_RIGHT_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
-            break;
-        case PS5::Buttons0::DPAD_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-            break;
-        case PS5::Buttons0::DPAD_DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
-            break;
-        case PS5::Buttons0::DPAD_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-            break;
-        case PS5::Buttons0::DPAD_LEFT_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
-            break;
-        default:
-            break;
-    }
-
-    if (in_report->buttons[0] & PS5::Buttons0::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[0] & PS5::Buttons0::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & PS5::Buttons0::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & PS5::Buttons0::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[1] & PS5::Buttons1::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[1] & PS5::Buttons1::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & PS5::Buttons1::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[1] & PS5::Buttons1::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & PS5::Buttons1::SHARE)    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & PS5::Buttons1::OPTIONS)  gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[2] & PS5::Buttons2::PS)       gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[2] & PS5::Buttons2::MUTE)     gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    button_map_.translate(gamepad, report, gp_in);
 
     gp_in.trigger_l = gamepad.scale_trigger_l(in_report->trigger_l);
     gp_in.trigger_r = gamepad.scale_trigger_r(in_report->trigger_r);
@@ -98,8 +74,13 @@ void PS5Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::memcpy(&prev_in_report_, in_report, sizeof(PS5::InReport));
 }
 
-bool PS5Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback PS5Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
+    if (led_pending_)
+    {
+        return Feedback::BUSY; //LED goes first, HostManager keeps this pending
+    }
+
     Gamepad::PadOut gp_out = gamepad.get_pad_out();
     out_report_.motor_left = gp_out.rumble_l;
     out_report_.motor_right = gp_out.rumble_r;
@@ -107,7 +88,7 @@ bool PS5Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
     if (tuh_hid_send_report(address, instance, 0, &out_report_, sizeof(PS5::OutReport)))
     {
         manage_rumble(gamepad);
-        return true;
+        return Feedback::SENT;
     }
-    return false;
+    return Feedback::BUSY;
 }
\ No newline at end of file
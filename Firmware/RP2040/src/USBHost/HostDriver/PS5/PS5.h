@@ -1,9 +1,11 @@
 #ifndef _PS5_HOST_H_
 #define _PS5_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/PS5.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class PS5Host : public HostDriver
@@ -14,11 +16,32 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    void report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
 
 private:
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::hat(offsetof(PS5::InReport, buttons[0]), PS5::DPAD_MASK),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[0]), PS5::Buttons0::SQUARE,   Gamepad::BUTTON_X),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[0]), PS5::Buttons0::CROSS,    Gamepad::BUTTON_A),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[0]), PS5::Buttons0::CIRCLE,   Gamepad::BUTTON_B),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[0]), PS5::Buttons0::TRIANGLE, Gamepad::BUTTON_Y),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[1]), PS5::Buttons1::L1,       Gamepad::BUTTON_LB),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[1]), PS5::Buttons1::R1,       Gamepad::BUTTON_RB),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[1]), PS5::Buttons1::L3,       Gamepad::BUTTON_L3),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[1]), PS5::Buttons1::R3,       Gamepad::BUTTON_R3),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[1]), PS5::Buttons1::SHARE,    Gamepad::BUTTON_BACK),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[1]), PS5::Buttons1::OPTIONS,  Gamepad::BUTTON_START),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[2]), PS5::Buttons2::PS,       Gamepad::BUTTON_SYS),
+        ButtonMap::button(offsetof(PS5::InReport, buttons[2]), PS5::Buttons2::MUTE,     Gamepad::BUTTON_MISC)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     PS5::InReport prev_in_report_{};
     PS5::OutReport out_report_{};
+    bool led_pending_{false};
+
+    bool send_led_report(uint8_t address, uint8_t instance);
 };
 
 #endif // _PS5_HOST_H_
\ No newline at end of file
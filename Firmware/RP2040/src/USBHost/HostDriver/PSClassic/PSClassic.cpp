@@ -21,44 +21,7 @@ void PSClassicHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
 
     Gamepad::PadIn gp_in;
 
-    switch (in_report->buttons & PSClassic::DPAD_MASK)
-    {
-        case PSClassic::Buttons::UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
-            break;
-        case PSClassic::Buttons::DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-            break;
-        case PSClassic::Buttons::LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-            break;
-        case PSClassic::Buttons::RIGHT: 
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-            break;
-        case PSClassic::Buttons::UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
-            break;
-        case PSClassic::Buttons::DOWN_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
-            break;
-        case PSClassic::Buttons::DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
-            break;
-        case PSClassic::Buttons::UP_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
-            break;
-        default:
-            break;
-    }
-
-    if (in_report->buttons & PSClassic::Buttons::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons & PSClassic::Buttons::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons & PSClassic::Buttons::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons & PSClassic::Buttons::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons & PSClassic::Buttons::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons & PSClassic::Buttons::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons & PSClassic::Buttons::SELECT)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons & PSClassic::Buttons::START)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
+    button_map_.translate(gamepad, report, gp_in);
 
     gp_in.trigger_l = (in_report->buttons & PSClassic::Buttons::L2) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
     gp_in.trigger_r = (in_report->buttons & PSClassic::Buttons::R2) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
@@ -69,7 +32,7 @@ void PSClassicHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
     std::memcpy(&prev_in_report_, &in_report, sizeof(PSClassic::InReport));
 }
 
-bool PSClassicHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback PSClassicHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
-    return true;
+    return Feedback::NONE;
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #ifndef _PSCLASSIC_HOST_H_
 #define _PSCLASSIC_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/PSClassic.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class PSClassicHost : public HostDriver
@@ -14,9 +16,26 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::hat16(offsetof(PSClassic::InReport, buttons), PSClassic::DPAD_MASK,
+        {
+            PSClassic::Buttons::UP,   PSClassic::Buttons::UP_RIGHT,  PSClassic::Buttons::RIGHT, PSClassic::Buttons::DOWN_RIGHT,
+            PSClassic::Buttons::DOWN, PSClassic::Buttons::DOWN_LEFT, PSClassic::Buttons::LEFT,  PSClassic::Buttons::UP_LEFT
+        }),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::SQUARE,   Gamepad::BUTTON_X),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::CROSS,    Gamepad::BUTTON_A),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::CIRCLE,   Gamepad::BUTTON_B),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::TRIANGLE, Gamepad::BUTTON_Y),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::L1,       Gamepad::BUTTON_LB),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::R1,       Gamepad::BUTTON_RB),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::SELECT,   Gamepad::BUTTON_BACK),
+        ButtonMap::button16(offsetof(PSClassic::InReport, buttons), PSClassic::Buttons::START,    Gamepad::BUTTON_START)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     PSClassic::InReport prev_in_report_{};
 };
 
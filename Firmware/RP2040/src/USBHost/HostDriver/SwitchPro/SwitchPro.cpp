@@ -66,11 +66,11 @@ void SwitchProHost::set_init_state(InitState state, const char* reason)
 {
     if (init_state_ != state)
     {
-        OGXM_LOG("SwitchProHost[%u]: state %s -> %s (%s)\n",
-                 idx_,
-                 init_state_name(init_state_),
-                 init_state_name(state),
-                 (reason != nullptr) ? reason : "no reason");
+        OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: state %s -> %s (%s)\n",
+                    idx_,
+                    init_state_name(init_state_),
+                    init_state_name(state),
+                    (reason != nullptr) ? reason : "no reason");
     }
     init_state_ = state;
 }
@@ -84,8 +84,8 @@ void SwitchProHost::activate_parallel_clone_path(const char* reason)
 
     clone_init_path_active_ = true;
     SwitchProCloneRecovery::mark_clone_profile_detected();
-    OGXM_LOG("SwitchProHost[%u]: activating ParallelClone init path (%s)\n",
-             idx_, (reason != nullptr) ? reason : "no reason");
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: activating ParallelClone init path (%s)\n",
+                idx_, (reason != nullptr) ? reason : "no reason");
 }
 
 bool SwitchProHost::is_clone_vendor_status_signature(const uint8_t* report, uint16_t len) const
@@ -109,8 +109,8 @@ void SwitchProHost::schedule_clone_init_reentry(uint8_t address, uint8_t instanc
             HostManager::get_instance().report_sent_cb(address, instance, nullptr, 0);
         });
 
-    OGXM_LOG("SwitchProHost[%u]: scheduled clone init re-entry delay=%u ms queued=%u\n",
-             idx_, delay_ms, queued ? 1 : 0);
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: scheduled clone init re-entry delay=%u ms queued=%u\n",
+                idx_, delay_ms, queued ? 1 : 0);
 }
 
 void SwitchProHost::cancel_clone_init_reentry()
@@ -127,8 +127,8 @@ void SwitchProHost::schedule_clone_full_report_settle_delay(uint8_t address, uin
     clone_full_report_ready_at_ms_ = board_api::ms_since_boot() + CLONE_FULL_REPORT_SETTLE_DELAY_MS;
     clone_full_report_delay_logged_ = false;
     schedule_clone_init_reentry(address, instance, CLONE_FULL_REPORT_SETTLE_DELAY_MS);
-    OGXM_LOG("SwitchProHost[%u]: scheduling MODE 0x03 settle delay=%u ms (%s)\n",
-             idx_, CLONE_FULL_REPORT_SETTLE_DELAY_MS, (reason != nullptr) ? reason : "clone 0x81 hint");
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: scheduling MODE 0x03 settle delay=%u ms (%s)\n",
+                idx_, CLONE_FULL_REPORT_SETTLE_DELAY_MS, (reason != nullptr) ? reason : "clone 0x81 hint");
 }
 
 bool SwitchProHost::should_prioritize_clone_reports() const
@@ -149,8 +149,8 @@ void SwitchProHost::initialize(Gamepad& gamepad, uint8_t address, uint8_t instan
     (void)report_desc;
     (void)desc_len;
 
-    OGXM_LOG("SwitchProHost[%u]: initialize addr=%u inst=%u desc_len=%u\n",
-             idx_, address, instance, desc_len);
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: initialize addr=%u inst=%u desc_len=%u\n",
+                idx_, address, instance, desc_len);
     reset_state();
     init_switch_host(address, instance);
     tuh_hid_receive_report(address, instance);
@@ -178,8 +178,6 @@ void SwitchProHost::reset_state()
     control_fallback_active_ = false;
     get_report_probe_attempted_ = false;
     get_report_probe_active_ = false;
-    debug_input_report_logs_ = 0;
-    vendor_status_report_logs_ = 0;
     ready_keepalive_budget_ = 0;
     clone_pre_full_report_hint_ready_at_ms_ = 0;
     clone_full_report_ready_at_ms_ = 0;
@@ -194,7 +192,7 @@ void SwitchProHost::reset_state()
     std::memset(&control_out_report_, 0, sizeof(control_out_report_));
     control_get_report_buffer_.fill(0);
 
-    OGXM_LOG("SwitchProHost[%u]: reset_state -> %s\n", idx_, init_state_name(init_state_));
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: reset_state -> %s\n", idx_, init_state_name(init_state_));
 }
 
 bool SwitchProHost::is_ready() const
@@ -225,8 +223,8 @@ bool SwitchProHost::send_hid_command(uint8_t address, uint8_t instance, uint8_t
     };
 
     const bool ok = tuh_hid_send_report(address, instance, 0, &hid_command, sizeof(hid_command));
-    OGXM_LOG("SwitchProHost[%u]: send_hid_command addr=%u inst=%u cmd=0x%02X ok=%u\n",
-             idx_, address, instance, command, ok ? 1 : 0);
+    OGXM_TRACE_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_hid_command addr=%u inst=%u cmd=0x%02X ok=%u\n",
+                  idx_, address, instance, command, ok ? 1 : 0);
     return ok;
 }
 
@@ -252,8 +250,8 @@ bool SwitchProHost::send_subcommand(uint8_t address, uint8_t instance, uint8_t s
 
     const uint8_t report_size = static_cast<uint8_t>(11 + data_len);
     const bool ok = tuh_hid_send_report(address, instance, 0, &out_report_, report_size);
-    OGXM_LOG("SwitchProHost[%u]: send_subcommand addr=%u inst=%u subcmd=0x%02X seq=%u len=%u ok=%u\n",
-             idx_, address, instance, sub_command, out_report_.sequence_counter, report_size, ok ? 1 : 0);
+    OGXM_TRACE_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_subcommand addr=%u inst=%u subcmd=0x%02X seq=%u len=%u ok=%u\n",
+                  idx_, address, instance, sub_command, out_report_.sequence_counter, report_size, ok ? 1 : 0);
     return ok;
 }
 
@@ -261,8 +259,8 @@ bool SwitchProHost::send_keepalive_rumble(uint8_t address, uint8_t instance, con
 {
     if (!rumble_capable_)
     {
-        OGXM_LOG("SwitchProHost[%u]: keepalive skipped, rumble unavailable state=%s reason=%s\n",
-                 idx_, init_state_name(init_state_), (reason != nullptr) ? reason : "n/a");
+        OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: keepalive skipped, rumble unavailable state=%s reason=%s\n",
+                    idx_, init_state_name(init_state_), (reason != nullptr) ? reason : "n/a");
         return false;
     }
 
@@ -273,9 +271,9 @@ bool SwitchProHost::send_keepalive_rumble(uint8_t address, uint8_t instance, con
     SwitchProRumble::fill_neutral(out_report_.rumble_r);
 
     const bool ok = tuh_hid_send_report(address, instance, 0, &out_report_, 10);
-    OGXM_LOG("SwitchProHost[%u]: keepalive send addr=%u inst=%u seq=%u budget=%u ok=%u reason=%s\n",
-             idx_, address, instance, out_report_.sequence_counter, ready_keepalive_budget_,
-             ok ? 1 : 0, (reason != nullptr) ? reason : "n/a");
+    OGXM_TRACE_AT(SWITCH_PRO, VERBOSE, "SwitchProHost[%u]: keepalive send addr=%u inst=%u seq=%u budget=%u ok=%u reason=%s\n",
+                  idx_, address, instance, out_report_.sequence_counter, ready_keepalive_budget_,
+                  ok ? 1 : 0, (reason != nullptr) ? reason : "n/a");
     return ok;
 }
 
@@ -286,8 +284,8 @@ bool SwitchProHost::send_control_hid_command(uint8_t address, uint8_t instance,
 
     const bool ok = tuh_hid_set_report(address, instance, SwitchPro::REPORT::OUTPUT_HID,
                                        HID_REPORT_TYPE_OUTPUT, &control_hid_command_.command, 1);
-    OGXM_LOG("SwitchProHost[%u]: send_control_hid_command addr=%u inst=%u cmd=0x%02X ok=%u\n",
-             idx_, address, instance, command, ok ? 1 : 0);
+    OGXM_TRACE_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_control_hid_command addr=%u inst=%u cmd=0x%02X ok=%u\n",
+                  idx_, address, instance, command, ok ? 1 : 0);
     return ok;
 }
 
@@ -315,9 +313,9 @@ bool SwitchProHost::send_control_subcommand(uint8_t address, uint8_t instance, u
     const bool ok = tuh_hid_set_report(address, instance, SwitchPro::REPORT::OUTPUT_SUBCMD,
                                        HID_REPORT_TYPE_OUTPUT, &control_out_report_.sequence_counter,
                                        payload_size);
-    OGXM_LOG("SwitchProHost[%u]: send_control_subcommand addr=%u inst=%u subcmd=0x%02X seq=%u len=%u ok=%u\n",
-             idx_, address, instance, sub_command, control_out_report_.sequence_counter,
-             payload_size, ok ? 1 : 0);
+    OGXM_TRACE_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_control_subcommand addr=%u inst=%u subcmd=0x%02X seq=%u len=%u ok=%u\n",
+                  idx_, address, instance, sub_command, control_out_report_.sequence_counter,
+                  payload_size, ok ? 1 : 0);
     return ok;
 }
 
@@ -333,8 +331,8 @@ bool SwitchProHost::send_control_get_report(uint8_t address, uint8_t instance, u
 
     const bool ok = tuh_hid_get_report(address, instance, report_id, report_type,
                                        control_get_report_buffer_.data(), len);
-    OGXM_LOG("SwitchProHost[%u]: send_control_get_report addr=%u inst=%u report=0x%02X type=%u len=%u ok=%u\n",
-             idx_, address, instance, report_id, report_type, len, ok ? 1 : 0);
+    OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_control_get_report addr=%u inst=%u report=0x%02X type=%u len=%u ok=%u\n",
+                idx_, address, instance, report_id, report_type, len, ok ? 1 : 0);
     return ok;
 }
 
@@ -387,8 +385,8 @@ void SwitchProHost::init_switch_host(uint8_t address, uint8_t instance)
                 {
                     if (!clone_full_report_delay_logged_)
                     {
-                        OGXM_LOG("SwitchProHost[%u]: clone path delaying MODE 0x03 for settle window remaining=%u ms\n",
-                                 idx_, clone_full_report_ready_at_ms_ - now_ms);
+                        OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: clone path delaying MODE 0x03 for settle window remaining=%u ms\n",
+                                    idx_, clone_full_report_ready_at_ms_ - now_ms);
                         clone_full_report_delay_logged_ = true;
                     }
                     break;
@@ -411,8 +409,8 @@ void SwitchProHost::init_switch_host(uint8_t address, uint8_t instance)
                 clone_pre_full_report_hint_ready_at_ms_ =
                     now_ms + CLONE_PRE_FULL_REPORT_HINT_WINDOW_MS;
                 schedule_clone_init_reentry(address, instance, CLONE_PRE_FULL_REPORT_HINT_WINDOW_MS);
-                OGXM_LOG("SwitchProHost[%u]: waiting %u ms for clone 0x81 hint before first MODE 0x03\n",
-                         idx_, CLONE_PRE_FULL_REPORT_HINT_WINDOW_MS);
+                OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: waiting %u ms for clone 0x81 hint before first MODE 0x03\n",
+                            idx_, CLONE_PRE_FULL_REPORT_HINT_WINDOW_MS);
                 break;
             }
 
@@ -574,29 +572,10 @@ void SwitchProHost::observe_vendor_status_report(uint8_t address, uint8_t instan
         schedule_clone_full_report_settle_delay(address, instance, delay_reason);
     }
 
-    if (vendor_status_report_logs_ >= MAX_VENDOR_STATUS_REPORT_LOGS)
-    {
-        return;
-    }
-
-    const uint8_t b0 = (len > 0) ? report[0] : 0;
-    const uint8_t b1 = (len > 1) ? report[1] : 0;
-    const uint8_t b2 = (len > 2) ? report[2] : 0;
-    const uint8_t b3 = (len > 3) ? report[3] : 0;
-    const uint8_t b4 = (len > 4) ? report[4] : 0;
-    const uint8_t b5 = (len > 5) ? report[5] : 0;
-    const uint8_t b6 = (len > 6) ? report[6] : 0;
-    const uint8_t b7 = (len > 7) ? report[7] : 0;
-
-    OGXM_LOG("SwitchProHost[%u]: vendor_status_0x81 addr=%u inst=%u len=%u state=%s bytes=%02X %02X %02X %02X %02X %02X %02X %02X\n",
-             idx_, address, instance, len, init_state_name(init_state_),
-             b0, b1, b2, b3, b4, b5, b6, b7);
-
-    ++vendor_status_report_logs_;
-    if (vendor_status_report_logs_ == MAX_VENDOR_STATUS_REPORT_LOGS)
-    {
-        OGXM_LOG("SwitchProHost[%u]: suppressing further 0x81 vendor-status logs\n", idx_);
-    }
+    OGXM_LOG_AT(SWITCH_PRO, VERBOSE, "SwitchProHost[%u]: vendor_status_0x81 addr=%u inst=%u len=%u state=%s bytes=%02X %02X %02X %02X %02X %02X %02X %02X\n",
+                idx_, address, instance, len, init_state_name(init_state_),
+                report[0], (len > 1) ? report[1] : 0, (len > 2) ? report[2] : 0, (len > 3) ? report[3] : 0,
+                (len > 4) ? report[4] : 0, (len > 5) ? report[5] : 0, (len > 6) ? report[6] : 0, (len > 7) ? report[7] : 0);
 }
 
 void SwitchProHost::mark_input_stream_seen(uint8_t report_id)
@@ -615,8 +594,8 @@ void SwitchProHost::mark_input_stream_seen(uint8_t report_id)
     control_fallback_active_ = false;
     get_report_probe_active_ = false;
     get_report_probe_started_at_ms_ = 0;
-    OGXM_LOG("SwitchProHost[%u]: input stream detected report=0x%02X, stopping fallback probes\n",
-             idx_, report_id);
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: input stream detected report=0x%02X, stopping fallback probes\n",
+                idx_, report_id);
 }
 
 bool SwitchProHost::maybe_send_clone_post_ready_mode_retry(uint8_t address, uint8_t instance, const char* reason)
@@ -635,8 +614,8 @@ bool SwitchProHost::maybe_send_clone_post_ready_mode_retry(uint8_t address, uint
     clone_ready_mode_retry_wait_logged_ = false;
     clone_ready_mode_retry_at_ms_ = board_api::ms_since_boot() + CLONE_READY_MODE_RETRY_DELAY_MS;
 
-    OGXM_LOG("SwitchProHost[%u]: clone path sending immediate post-ready MODE 0x03 retry (%s), wait=%u ms\n",
-             idx_, (reason != nullptr) ? reason : "no reason", CLONE_READY_MODE_RETRY_DELAY_MS);
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: clone path sending immediate post-ready MODE 0x03 retry (%s), wait=%u ms\n",
+                idx_, (reason != nullptr) ? reason : "no reason", CLONE_READY_MODE_RETRY_DELAY_MS);
 
     if (!send_subcommand(address, instance, SwitchPro::CMD::MODE,
                          full_report_mode, sizeof(full_report_mode)))
@@ -644,7 +623,7 @@ bool SwitchProHost::maybe_send_clone_post_ready_mode_retry(uint8_t address, uint
         clone_ready_mode_retry_attempted_ = false;
         clone_ready_mode_retry_wait_logged_ = false;
         clone_ready_mode_retry_at_ms_ = 0;
-        OGXM_LOG("SwitchProHost[%u]: clone path immediate post-ready MODE 0x03 retry failed to queue\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: clone path immediate post-ready MODE 0x03 retry failed to queue\n", idx_);
         return false;
     }
 
@@ -664,8 +643,8 @@ bool SwitchProHost::maybe_advance_clone_post_ready_recovery(uint8_t address, uin
     {
         if (!clone_ready_mode_retry_wait_logged_)
         {
-            OGXM_LOG("SwitchProHost[%u]: waiting for immediate post-ready MODE 0x03 retry result (%s)\n",
-                     idx_, (reason != nullptr) ? reason : "n/a");
+            OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: waiting for immediate post-ready MODE 0x03 retry result (%s)\n",
+                        idx_, (reason != nullptr) ? reason : "n/a");
             clone_ready_mode_retry_wait_logged_ = true;
         }
         return true;
@@ -702,8 +681,8 @@ bool SwitchProHost::maybe_start_clone_post_ready_reinit(uint8_t address, uint8_t
     clone_post_ready_reinit_attempted_ = true;
     schedule_clone_full_report_settle_delay(address, instance, "controlled post-ready reinit");
 
-    OGXM_LOG("SwitchProHost[%u]: clone path starting controlled post-ready reinit (%s)\n",
-             idx_, (reason != nullptr) ? reason : "no reason");
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: clone path starting controlled post-ready reinit (%s)\n",
+                idx_, (reason != nullptr) ? reason : "no reason");
     init_switch_host(address, instance);
     return true;
 }
@@ -770,8 +749,8 @@ void SwitchProHost::maybe_start_control_fallback(uint8_t address, uint8_t instan
 
     if (waiting_for_clone_post_ready_mode_retry_result())
     {
-        OGXM_LOG("SwitchProHost[%u]: delaying control fallback while awaiting clone MODE 0x03 retry result\n",
-                 idx_);
+        OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: delaying control fallback while awaiting clone MODE 0x03 retry result\n",
+                    idx_);
         return;
     }
 
@@ -789,15 +768,15 @@ void SwitchProHost::maybe_start_control_fallback(uint8_t address, uint8_t instan
     control_fallback_active_ = true;
     control_fallback_state_ = ControlFallbackState::HANDSHAKE;
 
-    OGXM_LOG("SwitchProHost[%u]: starting control fallback via SET_REPORT state=%s reason=%s\n",
-             idx_, control_fallback_state_name(control_fallback_state_),
-             (reason != nullptr) ? reason : "n/a");
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: starting control fallback via SET_REPORT state=%s reason=%s\n",
+                idx_, control_fallback_state_name(control_fallback_state_),
+                (reason != nullptr) ? reason : "n/a");
 
     if (!queue_control_fallback_step(address, instance))
     {
         control_fallback_active_ = false;
         control_fallback_state_ = ControlFallbackState::FAILED;
-        OGXM_LOG("SwitchProHost[%u]: control fallback failed to queue initial step\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: control fallback failed to queue initial step\n", idx_);
     }
 }
 
@@ -814,16 +793,16 @@ void SwitchProHost::maybe_start_get_report_probe(uint8_t address, uint8_t instan
     get_report_probe_active_ = true;
     get_report_probe_state_ = prioritize_clone_reports ? GetReportProbeState::INPUT_0x81
                                                        : GetReportProbeState::INPUT_0x30;
-    OGXM_LOG("SwitchProHost[%u]: starting get-report probe state=%s reason=%s\n",
-             idx_, get_report_probe_state_name(get_report_probe_state_),
-             (reason != nullptr) ? reason : "n/a");
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: starting get-report probe state=%s reason=%s\n",
+                idx_, get_report_probe_state_name(get_report_probe_state_),
+                (reason != nullptr) ? reason : "n/a");
 
     if (!queue_get_report_probe_step(address, instance))
     {
         get_report_probe_active_ = false;
         get_report_probe_started_at_ms_ = 0;
         get_report_probe_state_ = GetReportProbeState::FAILED;
-        OGXM_LOG("SwitchProHost[%u]: get-report probe failed to queue initial step\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: get-report probe failed to queue initial step\n", idx_);
         return;
     }
 
@@ -840,14 +819,14 @@ void SwitchProHost::advance_control_fallback(uint8_t address, uint8_t instance,
         return;
     }
 
-    OGXM_LOG("SwitchProHost[%u]: control fallback complete state=%s report=0x%02X len=%u success=%u\n",
-             idx_, control_fallback_state_name(control_fallback_state_), report_id, len, success ? 1 : 0);
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: control fallback complete state=%s report=0x%02X len=%u success=%u\n",
+                idx_, control_fallback_state_name(control_fallback_state_), report_id, len, success ? 1 : 0);
 
     if (!success)
     {
         control_fallback_active_ = false;
         control_fallback_state_ = ControlFallbackState::FAILED;
-        OGXM_LOG("SwitchProHost[%u]: control fallback aborted after failed SET_REPORT\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: control fallback aborted after failed SET_REPORT\n", idx_);
         return;
     }
 
@@ -863,24 +842,24 @@ void SwitchProHost::advance_control_fallback(uint8_t address, uint8_t instance,
             control_fallback_state_ = ControlFallbackState::DONE;
             control_fallback_active_ = false;
             ready_keepalive_budget_ = READY_KEEPALIVE_BURST;
-            OGXM_LOG("SwitchProHost[%u]: control fallback finished after MODE set-report\n", idx_);
+            OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: control fallback finished after MODE set-report\n", idx_);
             if (saw_vendor_status_report_)
             {
-                OGXM_LOG("SwitchProHost[%u]: starting automatic get-report probe after 0x81 vendor-status observation\n",
-                         idx_);
+                OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: starting automatic get-report probe after 0x81 vendor-status observation\n",
+                            idx_);
                 maybe_start_get_report_probe(address, instance, "post-control-fallback-after-0x81");
             }
             else
             {
-                OGXM_LOG("SwitchProHost[%u]: starting automatic get-report probe without additional clone observations\n",
-                         idx_);
+                OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: starting automatic get-report probe without additional clone observations\n",
+                            idx_);
                 maybe_start_get_report_probe(address, instance, "post-control-fallback-no-vendor-status");
             }
             return;
         default:
             control_fallback_active_ = false;
             control_fallback_state_ = ControlFallbackState::FAILED;
-            OGXM_LOG("SwitchProHost[%u]: control fallback entered invalid state\n", idx_);
+            OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: control fallback entered invalid state\n", idx_);
             return;
     }
 
@@ -888,8 +867,8 @@ void SwitchProHost::advance_control_fallback(uint8_t address, uint8_t instance,
     {
         control_fallback_active_ = false;
         control_fallback_state_ = ControlFallbackState::FAILED;
-        OGXM_LOG("SwitchProHost[%u]: control fallback failed to queue next step=%s\n",
-                 idx_, control_fallback_state_name(control_fallback_state_));
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: control fallback failed to queue next step=%s\n",
+                    idx_, control_fallback_state_name(control_fallback_state_));
     }
 }
 
@@ -908,9 +887,9 @@ void SwitchProHost::advance_get_report_probe(uint8_t address, uint8_t instance,
     const uint8_t b3 = (len > 3) ? control_get_report_buffer_[3] : 0;
     get_report_probe_started_at_ms_ = 0;
 
-    OGXM_LOG("SwitchProHost[%u]: get-report complete state=%s report=0x%02X type=%u len=%u success=%u bytes=%02X %02X %02X %02X\n",
-             idx_, get_report_probe_state_name(get_report_probe_state_), report_id, report_type, len,
-             success ? 1 : 0, b0, b1, b2, b3);
+    OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: get-report complete state=%s report=0x%02X type=%u len=%u success=%u bytes=%02X %02X %02X %02X\n",
+                idx_, get_report_probe_state_name(get_report_probe_state_), report_id, report_type, len,
+                success ? 1 : 0, b0, b1, b2, b3);
 
     switch (get_report_probe_state_)
     {
@@ -920,8 +899,8 @@ void SwitchProHost::advance_get_report_probe(uint8_t address, uint8_t instance,
             {
                 get_report_probe_active_ = false;
                 get_report_probe_state_ = GetReportProbeState::FAILED;
-                OGXM_LOG("SwitchProHost[%u]: get-report probe failed to queue next step=%s\n",
-                         idx_, get_report_probe_state_name(get_report_probe_state_));
+                OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: get-report probe failed to queue next step=%s\n",
+                            idx_, get_report_probe_state_name(get_report_probe_state_));
                 return;
             }
             schedule_clone_init_reentry(address, instance, GET_REPORT_PROBE_TIMEOUT_MS);
@@ -933,8 +912,8 @@ void SwitchProHost::advance_get_report_probe(uint8_t address, uint8_t instance,
             {
                 get_report_probe_active_ = false;
                 get_report_probe_state_ = GetReportProbeState::FAILED;
-                OGXM_LOG("SwitchProHost[%u]: get-report probe failed to queue next step=%s\n",
-                         idx_, get_report_probe_state_name(get_report_probe_state_));
+                OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: get-report probe failed to queue next step=%s\n",
+                            idx_, get_report_probe_state_name(get_report_probe_state_));
                 return;
             }
             schedule_clone_init_reentry(address, instance, GET_REPORT_PROBE_TIMEOUT_MS);
@@ -945,20 +924,20 @@ void SwitchProHost::advance_get_report_probe(uint8_t address, uint8_t instance,
             {
                 get_report_probe_state_ = GetReportProbeState::DONE;
                 get_report_probe_active_ = false;
-                OGXM_LOG("SwitchProHost[%u]: clone-prioritized get-report probe finished without interrupt input stream\n",
-                         idx_);
+                OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: clone-prioritized get-report probe finished without interrupt input stream\n",
+                            idx_);
                 return;
             }
 
             get_report_probe_state_ = GetReportProbeState::DONE;
             get_report_probe_active_ = false;
-            OGXM_LOG("SwitchProHost[%u]: get-report probe finished without interrupt input stream\n", idx_);
+            OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: get-report probe finished without interrupt input stream\n", idx_);
             return;
 
         default:
             get_report_probe_active_ = false;
             get_report_probe_state_ = GetReportProbeState::FAILED;
-            OGXM_LOG("SwitchProHost[%u]: get-report probe entered invalid state\n", idx_);
+            OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: get-report probe entered invalid state\n", idx_);
             return;
     }
 }
@@ -977,13 +956,13 @@ void SwitchProHost::handle_timeout()
             {
                 if (using_compat_fallback_)
                 {
-                    OGXM_LOG("SwitchProHost: Full report setup timed out after compatibility reports, trying vibration enable in compatibility mode.\n");
+                    OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost: Full report setup timed out after compatibility reports, trying vibration enable in compatibility mode.\n");
                     init_timeout_count_ = 0;
                     set_init_state(InitState::ENABLE_VIBRATION, "full report timeout after compat report");
                 }
                 else
                 {
-                    OGXM_LOG("SwitchProHost: Full report setup timed out, falling back to input-only compatibility.\n");
+                    OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost: Full report setup timed out, falling back to input-only compatibility.\n");
                     using_compat_fallback_ = true;
                     rumble_capable_ = false;
                     set_init_state(InitState::READY_COMPAT_INPUT, "full report timeout");
@@ -992,26 +971,26 @@ void SwitchProHost::handle_timeout()
             break;
 
         case InitState::WAIT_VIBRATION:
-            OGXM_LOG("SwitchProHost: Vibration enable timed out, continuing without rumble.\n");
+            OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost: Vibration enable timed out, continuing without rumble.\n");
             rumble_capable_ = false;
             init_timeout_count_ = 0;
             set_init_state(InitState::ENABLE_IMU, "vibration timeout");
             break;
 
         case InitState::WAIT_IMU:
-            OGXM_LOG("SwitchProHost: IMU setup timed out, continuing without IMU.\n");
+            OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost: IMU setup timed out, continuing without IMU.\n");
             init_timeout_count_ = 0;
             set_init_state(InitState::SET_LED, "imu timeout");
             break;
 
         case InitState::WAIT_LED:
-            OGXM_LOG("SwitchProHost: Player LED setup timed out, continuing.\n");
+            OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost: Player LED setup timed out, continuing.\n");
             init_timeout_count_ = 0;
             set_init_state(InitState::SET_HOME_LED, "player led timeout");
             break;
 
         case InitState::WAIT_HOME_LED:
-            OGXM_LOG("SwitchProHost: Home LED setup timed out, finalizing rumble-compatible mode.\n");
+            OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost: Home LED setup timed out, finalizing rumble-compatible mode.\n");
             init_timeout_count_ = 0;
             set_init_state(rumble_capable_ ? InitState::READY_COMPAT_RUMBLE : InitState::READY_COMPAT_INPUT,
                            "home led timeout");
@@ -1035,8 +1014,8 @@ bool SwitchProHost::handle_get_report_probe_timeout(uint8_t address, uint8_t ins
     }
 
     ++get_report_probe_timeout_count_;
-    OGXM_LOG("SwitchProHost[%u]: get-report probe timeout state=%s count=%u\n",
-             idx_, get_report_probe_state_name(get_report_probe_state_), get_report_probe_timeout_count_);
+    OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: get-report probe timeout state=%s count=%u\n",
+                idx_, get_report_probe_state_name(get_report_probe_state_), get_report_probe_timeout_count_);
     get_report_probe_started_at_ms_ = 0;
 
     if (get_report_probe_state_ == GetReportProbeState::INPUT_0x30)
@@ -1066,11 +1045,11 @@ bool SwitchProHost::handle_get_report_probe_timeout(uint8_t address, uint8_t ins
     if (get_report_probe_timeout_count_ < MAX_GET_REPORT_PROBE_TIMEOUTS)
     {
         get_report_probe_attempted_ = false;
-        OGXM_LOG("SwitchProHost[%u]: get-report probe timed out, allowing retry\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: get-report probe timed out, allowing retry\n", idx_);
     }
     else
     {
-        OGXM_LOG("SwitchProHost[%u]: get-report probe timed out, retries exhausted\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, WARN, "SwitchProHost[%u]: get-report probe timed out, retries exhausted\n", idx_);
     }
 
     return true;
@@ -1100,27 +1079,16 @@ void SwitchProHost::update_init_state(uint8_t address, uint8_t instance, const u
         return;
     }
 
-    if (debug_input_report_logs_ < MAX_DEBUG_INPUT_REPORT_LOGS)
-    {
-        const uint8_t b0 = (len > 0) ? report[0] : 0;
-        const uint8_t b1 = (len > 1) ? report[1] : 0;
-        const uint8_t b2 = (len > 2) ? report[2] : 0;
-        const uint8_t b3 = (len > 3) ? report[3] : 0;
-        OGXM_LOG("SwitchProHost[%u]: recv addr=%u inst=%u len=%u id=0x%02X state=%s bytes=%02X %02X %02X %02X\n",
-                 idx_, address, instance, len, b0, init_state_name(init_state_), b0, b1, b2, b3);
-        ++debug_input_report_logs_;
-        if (debug_input_report_logs_ == MAX_DEBUG_INPUT_REPORT_LOGS)
-        {
-            OGXM_LOG("SwitchProHost[%u]: suppressing further input report debug logs\n", idx_);
-        }
-    }
+    OGXM_LOG_AT(SWITCH_PRO, VERBOSE, "SwitchProHost[%u]: recv addr=%u inst=%u len=%u id=0x%02X state=%s bytes=%02X %02X %02X %02X\n",
+                idx_, address, instance, len, (len > 0) ? report[0] : 0, init_state_name(init_state_),
+                (len > 0) ? report[0] : 0, (len > 1) ? report[1] : 0, (len > 2) ? report[2] : 0, (len > 3) ? report[3] : 0);
 
     if (len == sizeof(SwitchWired::InReport) || len == 8 || report[0] == SwitchPro::REPORT::INPUT_BUTTON_EVENT)
     {
         if (!using_compat_fallback_)
         {
-            OGXM_LOG("SwitchProHost[%u]: compatibility report detected len=%u id=0x%02X\n",
-                     idx_, len, report[0]);
+            OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: compatibility report detected len=%u id=0x%02X\n",
+                        idx_, len, report[0]);
         }
         using_compat_fallback_ = true;
     }
@@ -1146,8 +1114,8 @@ void SwitchProHost::update_init_state(uint8_t address, uint8_t instance, const u
         const auto* reply = reinterpret_cast<const SwitchPro::SubcommandReply*>(report);
         const bool success = (reply->ack & SwitchPro::CMD::ACK_SUCCESS) != 0;
 
-        OGXM_LOG("SwitchProHost[%u]: subcmd_reply ack=0x%02X subcmd=0x%02X success=%u state=%s\n",
-                 idx_, reply->ack, reply->sub_command, success ? 1 : 0, init_state_name(init_state_));
+        OGXM_TRACE_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: subcmd_reply ack=0x%02X subcmd=0x%02X success=%u state=%s\n",
+                      idx_, reply->ack, reply->sub_command, success ? 1 : 0, init_state_name(init_state_));
 
         switch (reply->sub_command)
         {
@@ -1259,31 +1227,7 @@ bool SwitchProHost::parse_switch_wired_report(Gamepad& gamepad, const uint8_t* r
     const auto* wired_report = reinterpret_cast<const SwitchWired::InReport*>(report);
     Gamepad::PadIn gp_in;
 
-    switch (wired_report->dpad)
-    {
-        case SwitchWired::DPad::UP:         gp_in.dpad |= gamepad.MAP_DPAD_UP; break;
-        case SwitchWired::DPad::DOWN:       gp_in.dpad |= gamepad.MAP_DPAD_DOWN; break;
-        case SwitchWired::DPad::LEFT:       gp_in.dpad |= gamepad.MAP_DPAD_LEFT; break;
-        case SwitchWired::DPad::RIGHT:      gp_in.dpad |= gamepad.MAP_DPAD_RIGHT; break;
-        case SwitchWired::DPad::UP_RIGHT:   gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT; break;
-        case SwitchWired::DPad::DOWN_RIGHT: gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT; break;
-        case SwitchWired::DPad::DOWN_LEFT:  gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT; break;
-        case SwitchWired::DPad::UP_LEFT:    gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT; break;
-        default: break;
-    }
-
-    if (wired_report->buttons & SwitchWired::Buttons::Y)       gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (wired_report->buttons & SwitchWired::Buttons::B)       gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (wired_report->buttons & SwitchWired::Buttons::A)       gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (wired_report->buttons & SwitchWired::Buttons::X)       gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (wired_report->buttons & SwitchWired::Buttons::L)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (wired_report->buttons & SwitchWired::Buttons::R)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (wired_report->buttons & SwitchWired::Buttons::MINUS)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (wired_report->buttons & SwitchWired::Buttons::PLUS)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (wired_report->buttons & SwitchWired::Buttons::HOME)    gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (wired_report->buttons & SwitchWired::Buttons::CAPTURE) gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
-    if (wired_report->buttons & SwitchWired::Buttons::L3)      gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (wired_report->buttons & SwitchWired::Buttons::R3)      gp_in.buttons |= gamepad.MAP_BUTTON_R3;
+    wired_button_map_.translate(gamepad, report, gp_in);
 
     gp_in.trigger_l = (wired_report->buttons & SwitchWired::Buttons::ZL) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
     gp_in.trigger_r = (wired_report->buttons & SwitchWired::Buttons::ZR) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
@@ -1304,35 +1248,11 @@ bool SwitchProHost::parse_switch_button_report(Gamepad& gamepad, const uint8_t*
 
     Gamepad::PadIn gp_in;
 
-    if (report[1] & 0x01) gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (report[1] & 0x02) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (report[1] & 0x04) gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (report[1] & 0x08) gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (report[1] & 0x40) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (report[1] & 0x80) gp_in.trigger_r = Range::MAX<uint8_t>;
+    button_event_map_.translate(gamepad, report, gp_in);
 
-    if (report[2] & 0x01) gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (report[2] & 0x02) gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (report[2] & 0x04) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (report[2] & 0x08) gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (report[2] & 0x10) gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (report[2] & 0x20) gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
-    if (report[2] & 0x40) gp_in.buttons |= gamepad.MAP_BUTTON_LB;
+    if (report[1] & 0x80) gp_in.trigger_r = Range::MAX<uint8_t>;
     if (report[2] & 0x80) gp_in.trigger_l = Range::MAX<uint8_t>;
 
-    switch (report[3])
-    {
-        case 0: gp_in.dpad |= gamepad.MAP_DPAD_UP; break;
-        case 1: gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT; break;
-        case 2: gp_in.dpad |= gamepad.MAP_DPAD_RIGHT; break;
-        case 3: gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT; break;
-        case 4: gp_in.dpad |= gamepad.MAP_DPAD_DOWN; break;
-        case 5: gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT; break;
-        case 6: gp_in.dpad |= gamepad.MAP_DPAD_LEFT; break;
-        case 7: gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT; break;
-        default: break;
-    }
-
     const uint16_t joy_lx = report[4] | ((report[5] & 0x0F) << 8);
     const uint16_t joy_ly = (report[5] >> 4) | (report[6] << 4);
     const uint16_t joy_rx = report[7] | ((report[8] & 0x0F) << 8);
@@ -1362,23 +1282,10 @@ bool SwitchProHost::parse_switch_full_report(Gamepad& gamepad, const uint8_t* re
     const uint8_t l3_mask = clone_init_path_active_ ? SwitchPro::Buttons1::R3 : SwitchPro::Buttons1::L3;
     const uint8_t r3_mask = clone_init_path_active_ ? SwitchPro::Buttons1::L3 : SwitchPro::Buttons1::R3;
 
-    if (in_report->buttons[0] & SwitchPro::Buttons0::Y)  gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::B)  gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::A)  gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::X)  gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::L)  gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::R)  gp_in.buttons |= gamepad.MAP_BUTTON_RB;
+    full_report_map_.translate(gamepad, in_report->buttons, gp_in);
+
     if (in_report->buttons[1] & l3_mask) gp_in.buttons |= gamepad.MAP_BUTTON_L3;
     if (in_report->buttons[1] & r3_mask) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::MINUS)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::PLUS)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::HOME)    gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::CAPTURE) gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
-
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
 
     gp_in.trigger_l = (in_report->buttons[2] & SwitchPro::Buttons2::ZL) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
     gp_in.trigger_r = (in_report->buttons[0] & SwitchPro::Buttons0::ZR) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
@@ -1416,8 +1323,8 @@ void SwitchProHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
     if (!parsed)
     {
         const uint8_t report_id = (report != nullptr && len > 0) ? report[0] : 0;
-        OGXM_LOG("SwitchProHost[%u]: unparsed report len=%u id=0x%02X state=%s\n",
-                 idx_, len, report_id, init_state_name(init_state_));
+        OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: unparsed report len=%u id=0x%02X state=%s\n",
+                    idx_, len, report_id, init_state_name(init_state_));
     }
 
     if (!is_ready())
@@ -1449,31 +1356,34 @@ void SwitchProHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
     tuh_hid_receive_report(address, instance);
 }
 
-bool SwitchProHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback SwitchProHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
+    // Only rumble goes out from here. The handshake is driven by process_report,
+    // report_sent_cb and the reentry timer, never by HostManager's feedback retry.
     if (!is_ready())
     {
-        OGXM_LOG("SwitchProHost[%u]: send_feedback while not ready, state=%s\n",
-                 idx_, init_state_name(init_state_));
-        init_switch_host(address, instance);
-        return false;
+        OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_feedback while not ready, state=%s\n",
+                    idx_, init_state_name(init_state_));
+        return Feedback::NONE;
     }
 
+    // Rumble is dropped until the pad streams input. A console rumble still nudges a
+    // stalled clone one step, once per pad out change.
     if (!input_stream_seen_)
     {
         if (maybe_send_clone_post_ready_mode_retry(address, instance, "send-feedback-no-input"))
         {
-            return false;
+            return Feedback::NONE;
         }
 
         if (maybe_advance_clone_post_ready_recovery(address, instance, "send-feedback-no-input"))
         {
-            return false;
+            return Feedback::NONE;
         }
 
         if (handle_get_report_probe_timeout(address, instance))
         {
-            return false;
+            return Feedback::NONE;
         }
 
         if (ready_keepalive_budget_ > 0 &&
@@ -1482,7 +1392,7 @@ bool SwitchProHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t ins
         {
             --ready_keepalive_budget_;
             send_keepalive_rumble(address, instance, "awaiting-input-stream");
-            return false;
+            return Feedback::NONE;
         }
 
         if (control_fallback_attempted_ &&
@@ -1490,20 +1400,20 @@ bool SwitchProHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t ins
             !get_report_probe_active_)
         {
             maybe_start_get_report_probe(address, instance, "send-feedback-no-input-after-fallback");
-            return false;
+            return Feedback::NONE;
         }
 
         const Gamepad::PadOut dropped_out = gamepad.get_pad_out();
-        OGXM_LOG("SwitchProHost[%u]: send_feedback suppressed before input stream rumble_l=%u rumble_r=%u\n",
-                 idx_, dropped_out.rumble_l, dropped_out.rumble_r);
-        return false;
+        OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_feedback suppressed before input stream rumble_l=%u rumble_r=%u\n",
+                    idx_, dropped_out.rumble_l, dropped_out.rumble_r);
+        return Feedback::NONE;
     }
 
     if (!rumble_capable_)
     {
-        OGXM_LOG("SwitchProHost[%u]: send_feedback ignored, rumble not available in state=%s\n",
-                 idx_, init_state_name(init_state_));
-        return false;
+        OGXM_LOG_AT(SWITCH_PRO, DEBUG, "SwitchProHost[%u]: send_feedback ignored, rumble not available in state=%s\n",
+                    idx_, init_state_name(init_state_));
+        return Feedback::NONE;
     }
 
     std::memset(&out_report_, 0, sizeof(out_report_));
@@ -1515,9 +1425,9 @@ bool SwitchProHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t ins
     SwitchProRumble::encode(out_report_.rumble_r, gp_out.rumble_r);
 
     const bool ok = tuh_hid_send_report(address, instance, 0, &out_report_, 10);
-    OGXM_LOG("SwitchProHost[%u]: send_feedback rumble seq=%u ok=%u\n",
-             idx_, out_report_.sequence_counter, ok ? 1 : 0);
-    return ok;
+    OGXM_TRACE_AT(SWITCH_PRO, VERBOSE, "SwitchProHost[%u]: send_feedback rumble seq=%u ok=%u\n",
+                  idx_, out_report_.sequence_counter, ok ? 1 : 0);
+    return ok ? Feedback::SENT : Feedback::BUSY;
 }
 
 void SwitchProHost::set_report_complete_cb(Gamepad& gamepad, uint8_t address, uint8_t instance,
@@ -1545,7 +1455,7 @@ void SwitchProHost::disconnect_cb(Gamepad& gamepad, uint8_t address, uint8_t ins
     if (SwitchProCloneRecovery::clone_profile_detected())
     {
         SwitchProCloneRecovery::arm_next_attach_recovery();
-        OGXM_LOG("SwitchProHost[%u]: clone recovery armed for next attach after disconnect\n", idx_);
+        OGXM_LOG_AT(SWITCH_PRO, INFO, "SwitchProHost[%u]: clone recovery armed for next attach after disconnect\n", idx_);
     }
 }
 
@@ -1554,8 +1464,8 @@ void SwitchProHost::report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t in
     (void)gamepad;
 
     const uint8_t report_id = (report != nullptr && len > 0) ? report[0] : 0;
-    OGXM_LOG("SwitchProHost[%u]: report_sent_cb addr=%u inst=%u len=%u id=0x%02X state=%s\n",
-             idx_, address, instance, len, report_id, init_state_name(init_state_));
+    OGXM_TRACE_AT(SWITCH_PRO, VERBOSE, "SwitchProHost[%u]: report_sent_cb addr=%u inst=%u len=%u id=0x%02X state=%s\n",
+                  idx_, address, instance, len, report_id, init_state_name(init_state_));
 
     // Some Switch-compatible pads stay silent until the initial USB handshake
     // sequence has been fully transmitted. Advance the early init stages on
@@ -2,11 +2,14 @@
 #define _SWITCH_PRO_HOST_H_
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 #include "Board/ogxm_log.h"
 #include "Descriptors/SwitchPro.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
+#include "USBHost/HostDriver/SwitchWired/SwitchWired.h"
 
 class SwitchProHost : public HostDriver
 {
@@ -16,7 +19,7 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
     void report_sent_cb(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     void disconnect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
     void get_report_complete_cb(Gamepad& gamepad, uint8_t address, uint8_t instance,
@@ -72,8 +75,6 @@ private:
     static constexpr uint32_t CLONE_READY_RECOVERY_KICK_DELAY_MS = 16;
     static constexpr uint32_t CLONE_READY_MODE_RETRY_DELAY_MS = 120;
     static constexpr uint32_t GET_REPORT_PROBE_TIMEOUT_MS = 180;
-    static constexpr uint8_t MAX_DEBUG_INPUT_REPORT_LOGS = 24;
-    static constexpr uint8_t MAX_VENDOR_STATUS_REPORT_LOGS = 12;
     static constexpr uint8_t MAX_GET_REPORT_PROBE_TIMEOUTS = 3;
     static constexpr uint8_t READY_KEEPALIVE_BURST = 8;
     static constexpr uint8_t CLONE_VENDOR_STATUS_SIGNATURE[8] = {
@@ -99,8 +100,6 @@ private:
     bool control_fallback_active_{false};
     bool get_report_probe_attempted_{false};
     bool get_report_probe_active_{false};
-    uint8_t debug_input_report_logs_{0};
-    uint8_t vendor_status_report_logs_{0};
     uint8_t ready_keepalive_budget_{0};
     uint32_t clone_pre_full_report_hint_ready_at_ms_{0};
     uint32_t clone_full_report_ready_at_ms_{0};
@@ -111,6 +110,46 @@ private:
     ControlFallbackState control_fallback_state_{ControlFallbackState::IDLE};
     GetReportProbeState get_report_probe_state_{GetReportProbeState::IDLE};
 
+    //0x3F button event report, offsets relative to the report ID byte
+    static constexpr auto BUTTON_EVENT_MAP = ButtonMap::make(
+        ButtonMap::hat(3, 0xFF),
+        ButtonMap::button(1, 0x01, Gamepad::BUTTON_X),
+        ButtonMap::button(1, 0x02, Gamepad::BUTTON_Y),
+        ButtonMap::button(1, 0x04, Gamepad::BUTTON_A),
+        ButtonMap::button(1, 0x08, Gamepad::BUTTON_B),
+        ButtonMap::button(1, 0x40, Gamepad::BUTTON_RB),
+        ButtonMap::button(2, 0x01, Gamepad::BUTTON_BACK),
+        ButtonMap::button(2, 0x02, Gamepad::BUTTON_START),
+        ButtonMap::button(2, 0x04, Gamepad::BUTTON_R3),
+        ButtonMap::button(2, 0x08, Gamepad::BUTTON_L3),
+        ButtonMap::button(2, 0x10, Gamepad::BUTTON_SYS),
+        ButtonMap::button(2, 0x20, Gamepad::BUTTON_MISC),
+        ButtonMap::button(2, 0x40, Gamepad::BUTTON_LB)
+    );
+
+    //Full report, offsets relative to InReport::buttons.
+    //L3/R3 are handled separately since some clones swap them.
+    static constexpr auto FULL_REPORT_MAP = ButtonMap::make(
+        ButtonMap::button(0, SwitchPro::Buttons0::Y,          Gamepad::BUTTON_X),
+        ButtonMap::button(0, SwitchPro::Buttons0::B,          Gamepad::BUTTON_A),
+        ButtonMap::button(0, SwitchPro::Buttons0::A,          Gamepad::BUTTON_B),
+        ButtonMap::button(0, SwitchPro::Buttons0::X,          Gamepad::BUTTON_Y),
+        ButtonMap::button(0, SwitchPro::Buttons0::R,          Gamepad::BUTTON_RB),
+        ButtonMap::button(1, SwitchPro::Buttons1::MINUS,      Gamepad::BUTTON_BACK),
+        ButtonMap::button(1, SwitchPro::Buttons1::PLUS,       Gamepad::BUTTON_START),
+        ButtonMap::button(1, SwitchPro::Buttons1::HOME,       Gamepad::BUTTON_SYS),
+        ButtonMap::button(1, SwitchPro::Buttons1::CAPTURE,    Gamepad::BUTTON_MISC),
+        ButtonMap::button(2, SwitchPro::Buttons2::L,          Gamepad::BUTTON_LB),
+        ButtonMap::dpad  (2, SwitchPro::Buttons2::DPAD_UP,    Gamepad::DPAD_UP),
+        ButtonMap::dpad  (2, SwitchPro::Buttons2::DPAD_DOWN,  Gamepad::DPAD_DOWN),
+        ButtonMap::dpad  (2, SwitchPro::Buttons2::DPAD_LEFT,  Gamepad::DPAD_LEFT),
+        ButtonMap::dpad  (2, SwitchPro::Buttons2::DPAD_RIGHT, Gamepad::DPAD_RIGHT)
+    );
+
+    ButtonMap::Translator<SwitchWiredHost::BUTTON_MAP> wired_button_map_;
+    ButtonMap::Translator<BUTTON_EVENT_MAP> button_event_map_;
+    ButtonMap::Translator<FULL_REPORT_MAP> full_report_map_;
+
     SwitchPro::InReport prev_in_report_{};
     SwitchPro::OutReport out_report_{};
     SwitchPro::HidCommand control_hid_command_{};
@@ -1,9 +1,11 @@
 #ifndef _SWITCH_WIRED_HOST_H_
 #define _SWITCH_WIRED_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/SwitchWired.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class SwitchWiredHost : public HostDriver
@@ -14,9 +16,27 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+
+    //Shared with SwitchProHost, which also accepts wired style reports
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::hat(offsetof(SwitchWired::InReport, dpad), 0xFF),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::Y,       Gamepad::BUTTON_X),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::B,       Gamepad::BUTTON_A),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::A,       Gamepad::BUTTON_B),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::X,       Gamepad::BUTTON_Y),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::L,       Gamepad::BUTTON_LB),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::R,       Gamepad::BUTTON_RB),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::MINUS,   Gamepad::BUTTON_BACK),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::PLUS,    Gamepad::BUTTON_START),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::HOME,    Gamepad::BUTTON_SYS),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::CAPTURE, Gamepad::BUTTON_MISC),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::L3,      Gamepad::BUTTON_L3),
+        ButtonMap::button16(offsetof(SwitchWired::InReport, buttons), SwitchWired::Buttons::R3,      Gamepad::BUTTON_R3)
+    );
 
 private:
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     SwitchWired::InReport prev_in_report_{};
 };
 
@@ -1,9 +1,11 @@
 #ifndef _XBOX360_WIRED_HOST_H_
 #define _XBOX360_WIRED_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/XInput.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class Xbox360Host : public HostDriver
@@ -14,9 +16,29 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+
+    //Offsets relative to InReport::buttons, shared with Xbox360WHost
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::dpad(0, XInput::Buttons0::DPAD_UP,    Gamepad::DPAD_UP),
+        ButtonMap::dpad(0, XInput::Buttons0::DPAD_DOWN,  Gamepad::DPAD_DOWN),
+        ButtonMap::dpad(0, XInput::Buttons0::DPAD_LEFT,  Gamepad::DPAD_LEFT),
+        ButtonMap::dpad(0, XInput::Buttons0::DPAD_RIGHT, Gamepad::DPAD_RIGHT),
+        ButtonMap::button(0, XInput::Buttons0::START,    Gamepad::BUTTON_START),
+        ButtonMap::button(0, XInput::Buttons0::BACK,     Gamepad::BUTTON_BACK),
+        ButtonMap::button(0, XInput::Buttons0::L3,       Gamepad::BUTTON_L3),
+        ButtonMap::button(0, XInput::Buttons0::R3,       Gamepad::BUTTON_R3),
+        ButtonMap::button(1, XInput::Buttons1::LB,       Gamepad::BUTTON_LB),
+        ButtonMap::button(1, XInput::Buttons1::RB,       Gamepad::BUTTON_RB),
+        ButtonMap::button(1, XInput::Buttons1::HOME,     Gamepad::BUTTON_SYS),
+        ButtonMap::button(1, XInput::Buttons1::A,        Gamepad::BUTTON_A),
+        ButtonMap::button(1, XInput::Buttons1::B,        Gamepad::BUTTON_B),
+        ButtonMap::button(1, XInput::Buttons1::X,        Gamepad::BUTTON_X),
+        ButtonMap::button(1, XInput::Buttons1::Y,        Gamepad::BUTTON_Y)
+    );
 
 private:
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     XInput::InReport prev_in_report_;
 };
 
@@ -54,22 +54,7 @@ void Xbox360WHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t ins
 
     Gamepad::PadIn gp_in;
 
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[0] & XInput::Buttons0::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (in_report->buttons[0] & XInput::Buttons0::START)  gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[0] & XInput::Buttons0::BACK)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[0] & XInput::Buttons0::L3)     gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[0] & XInput::Buttons0::R3)     gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & XInput::Buttons1::LB)     gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[1] & XInput::Buttons1::RB)     gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & XInput::Buttons1::HOME)   gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & XInput::Buttons1::A)      gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[1] & XInput::Buttons1::B)      gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[1] & XInput::Buttons1::X)      gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[1] & XInput::Buttons1::Y)      gp_in.buttons |= gamepad.MAP_BUTTON_Y;
+    button_map_.translate(gamepad, in_report->buttons, gp_in);
 
     gp_in.trigger_l = gamepad.scale_trigger_l(in_report->trigger_l);
     gp_in.trigger_r = gamepad.scale_trigger_r(in_report->trigger_r);
@@ -83,10 +68,10 @@ void Xbox360WHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t ins
     prev_in_report_ = *in_report;
 }
 
-bool Xbox360WHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback Xbox360WHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
     Gamepad::PadOut gp_out = gamepad.get_pad_out(); 
-    return tuh_xinput::set_rumble(address, instance, gp_out.rumble_l, gp_out.rumble_r, false);
+    return tuh_xinput::set_rumble(address, instance, gp_out.rumble_l, gp_out.rumble_r, false) ? Feedback::SENT : Feedback::BUSY;
 }
 
 void Xbox360WHost::connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance)
@@ -103,7 +88,7 @@ void Xbox360WHost::connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instanc
         TaskQueue::Core1::queue_delayed_task(tid_chatpad_keepalive_, tuh_xinput::KEEPALIVE_MS, true, 
         [address, instance]
         {
-            OGXM_LOG("XInput Chatpad Keepalive\r\n");
+            OGXM_LOG_AT(XINPUT, DEBUG, "XInput Chatpad Keepalive\r\n");
             tuh_xinput::xbox360_chatpad_keepalive(address, instance);
         });
     });
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "Descriptors/XInput.h"
+#include "USBHost/HostDriver/XInput/Xbox360.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class Xbox360WHost : public HostDriver
@@ -16,12 +17,13 @@ public:
     
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
     void connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
     void disconnect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    ButtonMap::Translator<Xbox360Host::BUTTON_MAP> button_map_;
     uint32_t tid_chatpad_keepalive_{0};
     XInput::InReportWireless prev_in_report_;
 };
@@ -23,22 +23,7 @@ void XboxOGHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
 
     Gamepad::PadIn gp_in;
 
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (in_report->a) gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->b) gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->x) gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->y) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->black) gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->white) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-
-    if (in_report->buttons & XboxOG::GP::Buttons::START)   gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons & XboxOG::GP::Buttons::BACK)    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons & XboxOG::GP::Buttons::L3)      gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons & XboxOG::GP::Buttons::R3)      gp_in.buttons |= gamepad.MAP_BUTTON_R3;
+    button_map_.translate(gamepad, report, gp_in);
 
     if (gamepad.analog_enabled())
     {
@@ -66,8 +51,8 @@ void XboxOGHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
     std::memcpy(&prev_in_report_, in_report, sizeof(XboxOG::GP::InReport));
 }
 
-bool XboxOGHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
+HostDriver::Feedback XboxOGHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
     Gamepad::PadOut gp_out = gamepad.get_pad_out();
-    return tuh_xinput::set_rumble(address, instance, gp_out.rumble_l, gp_out.rumble_r, false);
+    return tuh_xinput::set_rumble(address, instance, gp_out.rumble_l, gp_out.rumble_r, false) ? Feedback::SENT : Feedback::BUSY;
 }
\ No newline at end of file
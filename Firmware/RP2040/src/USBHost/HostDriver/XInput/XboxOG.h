@@ -1,9 +1,11 @@
 #ifndef _XBOX_OG_HOST_H_
 #define _XBOX_OG_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/XboxOG.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class XboxOGHost : public HostDriver
@@ -14,9 +16,28 @@ public:
 
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
-    bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    Feedback send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
 private:
+    //Face buttons are pressure sensitive, any nonzero value counts as pressed
+    static constexpr auto BUTTON_MAP = ButtonMap::make(
+        ButtonMap::dpad(offsetof(XboxOG::GP::InReport, buttons),   XboxOG::GP::Buttons::DPAD_UP,    Gamepad::DPAD_UP),
+        ButtonMap::dpad(offsetof(XboxOG::GP::InReport, buttons),   XboxOG::GP::Buttons::DPAD_DOWN,  Gamepad::DPAD_DOWN),
+        ButtonMap::dpad(offsetof(XboxOG::GP::InReport, buttons),   XboxOG::GP::Buttons::DPAD_LEFT,  Gamepad::DPAD_LEFT),
+        ButtonMap::dpad(offsetof(XboxOG::GP::InReport, buttons),   XboxOG::GP::Buttons::DPAD_RIGHT, Gamepad::DPAD_RIGHT),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::START,      Gamepad::BUTTON_START),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::BACK,       Gamepad::BUTTON_BACK),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::L3,         Gamepad::BUTTON_L3),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, buttons), XboxOG::GP::Buttons::R3,         Gamepad::BUTTON_R3),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, a),     0xFF, Gamepad::BUTTON_A),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, b),     0xFF, Gamepad::BUTTON_B),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, x),     0xFF, Gamepad::BUTTON_X),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, y),     0xFF, Gamepad::BUTTON_Y),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, black), 0xFF, Gamepad::BUTTON_LB),
+        ButtonMap::button(offsetof(XboxOG::GP::InReport, white), 0xFF, Gamepad::BUTTON_RB)
+    );
+
+    ButtonMap::Translator<BUTTON_MAP> button_map_;
     XboxOG::GP::InReport prev_in_report_;
 };
 
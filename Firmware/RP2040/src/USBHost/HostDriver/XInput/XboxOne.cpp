@@ -50,40 +50,11 @@ void XboxOneHost::process_report(Gamepad &gamepad, uint8_t address,
 
   Gamepad::PadIn gp_in;
 
-  if (in_report->buttons[1] & XboxOne::Buttons1::DPAD_UP)
-    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-  if (in_report->buttons[1] & XboxOne::Buttons1::DPAD_DOWN)
-    gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-  if (in_report->buttons[1] & XboxOne::Buttons1::DPAD_LEFT)
-    gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-  if (in_report->buttons[1] & XboxOne::Buttons1::DPAD_RIGHT)
-    gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-  if (in_report->buttons[1] & XboxOne::Buttons1::L3)
-    gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-  if (in_report->buttons[1] & XboxOne::Buttons1::R3)
-    gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-  if (in_report->buttons[1] & XboxOne::Buttons1::LB)
-    gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-  if (in_report->buttons[1] & XboxOne::Buttons1::RB)
-    gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-  if (in_report->buttons[0] & XboxOne::Buttons0::BACK)
-    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-  if (in_report->buttons[0] & XboxOne::Buttons0::START)
-    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-  if (in_report->buttons[0] & XboxOne::Buttons0::SYNC)
-    gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+  button_map_.translate(gamepad, report, gp_in);
+
   // Guide é tratado via guide_pressed_ que vem do pacote GIP_CMD_VIRTUAL_KEY
   if (guide_pressed_)
     gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-  if (in_report->buttons[0] & XboxOne::Buttons0::A)
-    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-  if (in_report->buttons[0] & XboxOne::Buttons0::B)
-    gp_in.buttons |= gamepad.MAP_BUTTON_B;
-  if (in_report->buttons[0] & XboxOne::Buttons0::X)
-    gp_in.buttons |= gamepad.MAP_BUTTON_X;
-  if (in_report->buttons[0] & XboxOne::Buttons0::Y)
-    gp_in.buttons |= gamepad.MAP_BUTTON_Y;
 
   gp_in.trigger_l =
       gamepad.scale_trigger_l(static_cast<uint8_t>(in_report->trigger_l >> 2));
@@ -101,9 +72,12 @@ void XboxOneHost::process_report(Gamepad &gamepad, uint8_t address,
   std::memcpy(&prev_in_report_, in_report, 18);
 }
 
-bool XboxOneHost::send_feedback(Gamepad &gamepad, uint8_t address,
-                                uint8_t instance) {
+HostDriver::Feedback XboxOneHost::send_feedback(Gamepad &gamepad,
+                                                uint8_t address,
+                                                uint8_t instance) {
   Gamepad::PadOut gp_out = gamepad.get_pad_out();
   return tuh_xinput::set_rumble(address, instance, gp_out.rumble_l,
-                                gp_out.rumble_r, false);
+                                gp_out.rumble_r, false)
+             ? Feedback::SENT
+             : Feedback::BUSY;
 }
\ No newline at end of file
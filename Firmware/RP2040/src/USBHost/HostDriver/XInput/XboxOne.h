@@ -1,9 +1,11 @@
 #ifndef _XBOX_ONE_HOST_H_
 #define _XBOX_ONE_HOST_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Descriptors/XboxOne.h"
+#include "Gamepad/ButtonMap.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class XboxOneHost : public HostDriver {
@@ -14,10 +16,44 @@ public:
                   const uint8_t *report_desc, uint16_t desc_len) override;
   void process_report(Gamepad &gamepad, uint8_t address, uint8_t instance,
                       const uint8_t *report, uint16_t len) override;
-  bool send_feedback(Gamepad &gamepad, uint8_t address,
-                     uint8_t instance) override;
+  Feedback send_feedback(Gamepad &gamepad, uint8_t address,
+                         uint8_t instance) override;
 
 private:
+  // Guide arrives in its own GIP_CMD_VIRTUAL_KEY packet, see guide_pressed_
+  static constexpr auto BUTTON_MAP = ButtonMap::make(
+      ButtonMap::dpad(offsetof(XboxOne::InReport, buttons[1]),
+                      XboxOne::Buttons1::DPAD_UP, Gamepad::DPAD_UP),
+      ButtonMap::dpad(offsetof(XboxOne::InReport, buttons[1]),
+                      XboxOne::Buttons1::DPAD_DOWN, Gamepad::DPAD_DOWN),
+      ButtonMap::dpad(offsetof(XboxOne::InReport, buttons[1]),
+                      XboxOne::Buttons1::DPAD_LEFT, Gamepad::DPAD_LEFT),
+      ButtonMap::dpad(offsetof(XboxOne::InReport, buttons[1]),
+                      XboxOne::Buttons1::DPAD_RIGHT, Gamepad::DPAD_RIGHT),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[1]),
+                        XboxOne::Buttons1::L3, Gamepad::BUTTON_L3),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[1]),
+                        XboxOne::Buttons1::R3, Gamepad::BUTTON_R3),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[1]),
+                        XboxOne::Buttons1::LB, Gamepad::BUTTON_LB),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[1]),
+                        XboxOne::Buttons1::RB, Gamepad::BUTTON_RB),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::BACK, Gamepad::BUTTON_BACK),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::START, Gamepad::BUTTON_START),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::SYNC, Gamepad::BUTTON_MISC),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::A, Gamepad::BUTTON_A),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::B, Gamepad::BUTTON_B),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::X, Gamepad::BUTTON_X),
+      ButtonMap::button(offsetof(XboxOne::InReport, buttons[0]),
+                        XboxOne::Buttons0::Y, Gamepad::BUTTON_Y));
+
+  ButtonMap::Translator<BUTTON_MAP> button_map_;
   XboxOne::InReport prev_in_report_;
   bool guide_pressed_ = false; // Botão Guide é enviado em pacote separado
 };
@@ -2,9 +2,9 @@
 
 #if (TUSB_OPT_HOST_ENABLED && CFG_TUH_XINPUT)
 
-#include <chrono>
 #include <cstring>
 
+#include "TaskQueue/TaskQueue.h"
 #include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput.h"
 #include "USBHost/HostDriver/XInput/tuh_xinput/tuh_xinput_cmd.h"
 
@@ -85,18 +85,48 @@ get_itf_by_instance(uint8_t dev_addr, uint8_t instance) {
   return &device->interfaces[instance];
 }
 
-static void std_sleep_ms(uint32_t ms) {
-  auto start = std::chrono::high_resolution_clock::now();
-  while (std::chrono::duration_cast<std::chrono::milliseconds>(
-             std::chrono::high_resolution_clock::now() - start)
-             .count() < ms) {
-    tuh_task();
+// Sends now if the endpoint is free and nothing is queued ahead of it,
+// otherwise it goes out from xfer_cb when the reports before it complete
+static bool queue_report(Interface *interface, uint8_t dev_addr,
+                         uint8_t instance, const uint8_t *buffer,
+                         uint16_t len) {
+  if (interface->out_queue_count == 0 &&
+      send_report(dev_addr, instance, buffer, len)) {
+    return true;
+  }
+  TU_VERIFY(len <= interface->out_queue[0].data.size() &&
+            interface->out_queue_count < interface->out_queue.size());
+
+  OutReport &report =
+      interface->out_queue[(interface->out_queue_head +
+                            interface->out_queue_count) %
+                           interface->out_queue.size()];
+  std::memcpy(report.data.data(), buffer, len);
+  report.len = static_cast<uint8_t>(len);
+  ++interface->out_queue_count;
+  return true;
+}
+
+// Called on OUT completion, false if nothing was queued
+static bool send_queued_report(Interface *interface, uint8_t dev_addr,
+                               uint8_t instance) {
+  if (interface->out_queue_count == 0) {
+    return false;
+  }
+  const OutReport &report = interface->out_queue[interface->out_queue_head];
+  if (!send_report(dev_addr, instance, report.data.data(), report.len)) {
+    return false;
   }
+  interface->out_queue_head =
+      (interface->out_queue_head + 1) % interface->out_queue.size();
+  --interface->out_queue_count;
+  return true;
 }
 
-static void wait_for_tx_complete(uint8_t dev_addr, uint8_t ep_addr) {
-  while (usbh_edpt_busy(dev_addr, ep_addr)) {
-    tuh_task();
+static void cancel_connect(Interface *interface) {
+  if (interface->connect_pending) {
+    TaskQueue::Core1::cancel_delayed_task(interface->connect_task_id);
+    interface->connect_pending = false;
   }
 }
 
@@ -117,25 +147,23 @@ static void xboxone_init(Interface *interface, uint8_t dev_addr,
   uint16_t PID, VID;
   tuh_vid_pid_get(dev_addr, &VID, &PID);
 
-  send_report(dev_addr, instance, XboxOne::POWER_ON, sizeof(XboxOne::POWER_ON));
-  wait_for_tx_complete(dev_addr, interface->ep_out);
-  send_report(dev_addr, instance, XboxOne::S_INIT, sizeof(XboxOne::S_INIT));
-  wait_for_tx_complete(dev_addr, interface->ep_out);
+  queue_report(interface, dev_addr, instance, XboxOne::POWER_ON,
+               sizeof(XboxOne::POWER_ON));
+  queue_report(interface, dev_addr, instance, XboxOne::S_INIT,
+               sizeof(XboxOne::S_INIT));
 
   if (VID == 0x045e && (PID == 0x0b00)) {
-    send_report(dev_addr, instance, XboxOne::EXTRA_INPUT_PACKET_INIT,
-                sizeof(XboxOne::EXTRA_INPUT_PACKET_INIT));
-    wait_for_tx_complete(dev_addr, interface->ep_out);
+    queue_report(interface, dev_addr, instance,
+                 XboxOne::EXTRA_INPUT_PACKET_INIT,
+                 sizeof(XboxOne::EXTRA_INPUT_PACKET_INIT));
   }
 
   // Required for PDP aftermarket controllers
   if (VID == 0x0e6f) {
-    send_report(dev_addr, instance, XboxOne::PDP_LED_ON,
-                sizeof(XboxOne::PDP_LED_ON));
-    wait_for_tx_complete(dev_addr, interface->ep_out);
-    send_report(dev_addr, instance, XboxOne::PDP_AUTH,
-                sizeof(XboxOne::PDP_AUTH));
-    wait_for_tx_complete(dev_addr, interface->ep_out);
+    queue_report(interface, dev_addr, instance, XboxOne::PDP_LED_ON,
+                 sizeof(XboxOne::PDP_LED_ON));
+    queue_report(interface, dev_addr, instance, XboxOne::PDP_AUTH,
+                 sizeof(XboxOne::PDP_AUTH));
   }
 }
 
@@ -227,9 +255,8 @@ static bool set_config(uint8_t dev_addr, uint8_t itf_num) {
   switch (interface->dev_type) {
   case DevType::XBOX360W:
     interface->connected = false;
-    send_report(dev_addr, instance, Xbox360W::INQUIRE_PRESENT,
-                sizeof(Xbox360W::INQUIRE_PRESENT));
-    wait_for_tx_complete(dev_addr, interface->ep_out);
+    queue_report(interface, dev_addr, instance, Xbox360W::INQUIRE_PRESENT,
+                 sizeof(Xbox360W::INQUIRE_PRESENT));
     break;
   case DevType::XBOXONE:
     xboxone_init(interface, dev_addr, instance);
@@ -259,6 +286,8 @@ static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result,
     // corrompidos
     if (dir == TUSB_DIR_IN) {
       receive_report(dev_addr, instance);
+    } else {
+      send_queued_report(interface, dev_addr, instance);
     }
     return true; // Retorna após erro para evitar processar dados inválidos
   }
@@ -280,21 +309,38 @@ static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result,
 
           TU_LOG1("Xbox 360 wireless controller connected\n");
 
-          // I think some 3rd party adapters need this:
-          std_sleep_ms(1000);
-          send_report(dev_addr, instance, Xbox360W::RUMBLE_ENABLE,
-                      sizeof(Xbox360W::RUMBLE_ENABLE));
-
-          if (xbox360w_connect_cb) {
-            xbox360w_connect_cb(dev_addr, instance);
+          // I think some 3rd party adapters need a delay here, it runs
+          // from TaskQueue so the other controllers keep being serviced
+          if (interface->connect_task_id == 0) {
+            interface->connect_task_id = TaskQueue::Core1::get_new_task_id();
           }
+          interface->connect_pending = true;
+          TaskQueue::Core1::queue_delayed_task(
+              interface->connect_task_id, CONNECT_DELAY_MS, false,
+              [dev_addr, instance] {
+                Interface *interface = get_itf_by_instance(dev_addr, instance);
+                if (interface == nullptr || !interface->connect_pending) {
+                  return;
+                }
+                interface->connect_pending = false;
+                queue_report(interface, dev_addr, instance,
+                             Xbox360W::RUMBLE_ENABLE,
+                             sizeof(Xbox360W::RUMBLE_ENABLE));
+
+                if (xbox360w_connect_cb) {
+                  xbox360w_connect_cb(dev_addr, instance);
+                }
+              });
         } else if (in_buffer[1] == 0x00 && interface->connected) {
           interface->connected = false;
           interface->chatpad_inited = false;
 
           TU_LOG1("Xbox 360 wireless controller disconnected\n");
 
-          if (xbox360w_disconnect_cb) {
+          // Never reported as connected if it drops within the delay
+          if (interface->connect_pending) {
+            cancel_connect(interface);
+          } else if (xbox360w_disconnect_cb) {
             xbox360w_disconnect_cb(dev_addr, instance);
           }
         }
@@ -333,7 +379,8 @@ static bool xfer_cb(uint8_t dev_addr, uint8_t ep_addr, xfer_result_t result,
       receive_report(dev_addr, instance);
     }
   } else {
-    if (report_sent_cb) {
+    // Queued init reports go first, the callback hears once the endpoint's idle
+    if (!send_queued_report(interface, dev_addr, instance) && report_sent_cb) {
       report_sent_cb(dev_addr, instance, interface->ep_out_buffer.data(),
                      static_cast<uint16_t>(xferred_bytes));
     }
@@ -357,8 +404,10 @@ void close(uint8_t dev_addr) {
       TU_LOG1("XInput unmounting\r\n");
       unmount_cb(dev_addr, i, &device->interfaces[i]);
       TU_LOG1("XInput unmount\r\n");
+      cancel_connect(&device->interfaces[i]);
       device->interfaces[i].itf_num = 0xFF;
       device->interfaces[i].connected = false;
+      device->interfaces[i].out_queue_count = 0;
     }
   }
 }
@@ -409,7 +458,7 @@ bool receive_report(uint8_t dev_addr, uint8_t instance) {
   return true;
 }
 
-bool set_led(uint8_t dev_addr, uint8_t instance, uint8_t quadrant, bool block) {
+bool set_led(uint8_t dev_addr, uint8_t instance, uint8_t quadrant, bool queue) {
   Interface *interface = get_itf_by_instance(dev_addr, instance);
   TU_VERIFY(interface != nullptr);
 
@@ -431,15 +480,12 @@ bool set_led(uint8_t dev_addr, uint8_t instance, uint8_t quadrant, bool block) {
     return true;
   }
 
-  bool ret = send_report(dev_addr, instance, buffer, len);
-  if (block && ret) {
-    wait_for_tx_complete(dev_addr, interface->ep_out);
-  }
-  return ret;
+  return queue ? queue_report(interface, dev_addr, instance, buffer, len)
+               : send_report(dev_addr, instance, buffer, len);
 }
 
 bool set_rumble(uint8_t dev_addr, uint8_t instance, uint8_t rumble_l,
-                uint8_t rumble_r, bool block) {
+                uint8_t rumble_r, bool queue) {
   Interface *interface = get_itf_by_instance(dev_addr, instance);
   TU_VERIFY(interface != nullptr);
 
@@ -477,11 +523,9 @@ bool set_rumble(uint8_t dev_addr, uint8_t instance, uint8_t rumble_l,
     return true;
   }
 
-  bool ret = send_report(dev_addr, instance, buffer, len);
-  if (block && ret) {
-    wait_for_tx_complete(dev_addr, interface->ep_out);
-  }
-  return true;
+  // False while the endpoint's busy, HostManager retries it
+  return queue ? queue_report(interface, dev_addr, instance, buffer, len)
+               : send_report(dev_addr, instance, buffer, len);
 }
 
 void xbox360_chatpad_init(uint8_t address, uint8_t instance) {
@@ -493,23 +537,19 @@ void xbox360_chatpad_init(uint8_t address, uint8_t instance) {
                 DevType::XBOX360W, ); // Only supported on Xbox 360 Wireless
                                       // atm, wired is more complicated
 
-  send_report(address, instance, Xbox360W::CONTROLLER_INFO,
-              sizeof(Xbox360W::CONTROLLER_INFO));
-  wait_for_tx_complete(address, interface->ep_out);
-  send_report(address, instance, Xbox360W::Chatpad::INIT,
-              sizeof(Xbox360W::Chatpad::INIT));
-  wait_for_tx_complete(address, interface->ep_out);
-  send_report(address, instance, Xbox360W::RUMBLE_ENABLE,
-              sizeof(Xbox360W::RUMBLE_ENABLE));
-  wait_for_tx_complete(address, interface->ep_out);
+  queue_report(interface, address, instance, Xbox360W::CONTROLLER_INFO,
+               sizeof(Xbox360W::CONTROLLER_INFO));
+  queue_report(interface, address, instance, Xbox360W::Chatpad::INIT,
+               sizeof(Xbox360W::Chatpad::INIT));
+  queue_report(interface, address, instance, Xbox360W::RUMBLE_ENABLE,
+               sizeof(Xbox360W::RUMBLE_ENABLE));
 
   uint8_t led_ctrl[4];
   std::memcpy(led_ctrl, Xbox360W::Chatpad::LED_CTRL,
               sizeof(Xbox360W::Chatpad::LED_CTRL));
   led_ctrl[2] = Xbox360W::Chatpad::LED_ON[0];
 
-  send_report(address, instance, led_ctrl, sizeof(led_ctrl));
-  wait_for_tx_complete(address, interface->ep_out);
+  queue_report(interface, address, instance, led_ctrl, sizeof(led_ctrl));
 
   interface->chatpad_inited = true;
   interface->chatpad_stage = ChatpadStage::KEEPALIVE_1;
@@ -55,6 +55,14 @@ namespace tuh_xinput
 
     static constexpr uint8_t ENDPOINT_SIZE = 64;
     static constexpr uint32_t KEEPALIVE_MS = 1000;
+    static constexpr uint32_t CONNECT_DELAY_MS = 1000;
+    static constexpr uint8_t OUT_QUEUE_SIZE = 6;
+
+    struct OutReport
+    {
+        uint8_t len{0};
+        std::array<uint8_t, 32> data{0};
+    };
 
     struct Interface
     {
@@ -77,6 +85,14 @@ namespace tuh_xinput
 
         std::array<uint8_t, ENDPOINT_SIZE> ep_in_buffer{0};
         std::array<uint8_t, ENDPOINT_SIZE> ep_out_buffer{0};
+
+        //Init sequences go out one report per OUT completion instead of waiting on the endpoint
+        std::array<OutReport, OUT_QUEUE_SIZE> out_queue{};
+        uint8_t out_queue_head{0};
+        uint8_t out_queue_count{0};
+
+        uint32_t connect_task_id{0}; //Delayed 360W connect, TaskQueue::Core1
+        bool connect_pending{false};
     };
 
     // API
@@ -85,8 +101,9 @@ namespace tuh_xinput
 
     bool send_report(uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len);
     bool receive_report(uint8_t address, uint8_t instance);
-    bool set_rumble(uint8_t address, uint8_t instance, uint8_t rumble_l, uint8_t rumble_r, bool block);
-    bool set_led(uint8_t address, uint8_t instance, uint8_t led_number, bool block);
+    //queue: if the endpoint is busy, send it after the reports ahead of it instead of failing
+    bool set_rumble(uint8_t address, uint8_t instance, uint8_t rumble_l, uint8_t rumble_r, bool queue);
+    bool set_led(uint8_t address, uint8_t instance, uint8_t led_number, bool queue);
 
     //Wireless only atm
     void xbox360_chatpad_init(uint8_t address, uint8_t instance); 
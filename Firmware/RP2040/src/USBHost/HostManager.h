@@ -9,6 +9,8 @@
 #include <memory>
 
 #include "Board/Config.h"
+#include "Board/board_api.h"
+#include "Board/ogxm_log.h"
 #include "USBHost/HardwareIDs.h"
 #include "USBHost/HostDriver/DInput/DInput.h"
 #include "USBHost/HostDriver/HIDGeneric/HIDGeneric.h"
@@ -55,6 +57,9 @@ public:
                            uint16_t desc_len = 0) {
     uint8_t gp_idx = find_free_gamepad();
     if (gp_idx == INVALID_IDX || instance >= MAX_INTERFACES) {
+      OGXM_LOG_AT(HOST_MANAGER, WARN,
+                  "HostManager: no free gamepad for addr=%u inst=%u\n", address,
+                  instance);
       return false;
     }
 
@@ -130,6 +135,9 @@ public:
     interface.driver->initialize(*interface.gamepad, device_slot.address,
                                  instance, report_desc, desc_len);
 
+    OGXM_LOG_AT(HOST_MANAGER, INFO,
+                "HostManager: mounted addr=%u inst=%u type=%u gamepad=%u\n",
+                address, instance, static_cast<unsigned>(driver_type), gp_idx);
     return true;
   }
 
@@ -139,6 +147,7 @@ public:
       if (device_slot.address == address &&
           device_slot.interfaces[instance].driver &&
           device_slot.interfaces[instance].gamepad) {
+        device_slot.interfaces[instance].gamepad->update_profile();
         device_slot.interfaces[instance].driver->process_report(
             *device_slot.interfaces[instance].gamepad, address, instance,
             report, len);
@@ -163,6 +172,8 @@ public:
       if (device_slot.address == address &&
           device_slot.interfaces[instance].driver &&
           device_slot.interfaces[instance].gamepad) {
+        // Endpoint's free again, don't wait out a pending retry
+        device_slot.interfaces[instance].feedback_retry_ms = 0;
         device_slot.interfaces[instance].driver->report_sent_cb(
             *device_slot.interfaces[instance].gamepad, address, instance,
             report, len);
@@ -209,19 +220,17 @@ public:
     }
   }
 
-  // Call on a timer
+  // Call every pass of the core1 loop, between tuh_task() calls. Any set_pad_out
+  // marks its interface, the newest pad out goes out on the next pass. Only a
+  // Feedback::BUSY send is retried, once its last report completes or after
+  // FEEDBACK_RETRY_MS, whichever comes first. Feedback::NONE drops the pad out.
   inline void send_feedback() {
     for (auto &device_slot : device_slots_) {
       if (device_slot.address == INVALID_IDX) {
         continue;
       }
       for (uint8_t i = 0; i < MAX_INTERFACES; ++i) {
-        if (device_slot.interfaces[i].driver &&
-            device_slot.interfaces[i].gamepad->new_pad_out()) {
-          device_slot.interfaces[i].driver->send_feedback(
-              *device_slot.interfaces[i].gamepad, device_slot.address, i);
-          tuh_task();
-        }
+        send_feedback(device_slot.address, i, device_slot.interfaces[i]);
       }
     }
   }
@@ -230,6 +239,8 @@ public:
                      uint8_t instance) {
     for (auto &device_slot : device_slots_) {
       if (device_slot.address == address) {
+        OGXM_LOG_AT(HOST_MANAGER, INFO, "HostManager: unmounted addr=%u\n",
+                    address);
         for (uint8_t i = 0; i < MAX_INTERFACES; ++i) {
           if (device_slot.interfaces[i].driver &&
               device_slot.interfaces[i].gamepad) {
@@ -291,11 +302,14 @@ public:
 
 private:
   static constexpr uint8_t INVALID_IDX = 0xFF;
+  static constexpr uint32_t FEEDBACK_RETRY_MS = 20;
 
   struct Interface {
     std::unique_ptr<HostDriver> driver{nullptr};
     Gamepad *gamepad{nullptr};
     uint8_t gamepad_idx{INVALID_IDX};
+    bool feedback_pending{false};
+    uint32_t feedback_retry_ms{0}; // Earliest retry after a failed send, 0 = now
   };
   struct Device {
     uint8_t address{INVALID_IDX};
@@ -307,6 +321,8 @@ private:
         interface.driver.reset();
         interface.gamepad_idx = INVALID_IDX;
         interface.gamepad = nullptr;
+        interface.feedback_pending = false;
+        interface.feedback_retry_ms = 0;
       }
     }
   };
@@ -316,6 +332,42 @@ private:
 
   HostManager() {}
 
+  inline void send_feedback(uint8_t address, uint8_t instance,
+                            Interface &interface) {
+    if (!interface.driver || !interface.gamepad) {
+      return;
+    }
+    // new_pad_out() is cleared by the driver's get_pad_out(), a busy send
+    // stays pending here instead
+    if (interface.gamepad->new_pad_out()) {
+      interface.feedback_pending = true;
+      interface.feedback_retry_ms = 0;
+    }
+    if (!interface.feedback_pending) {
+      return;
+    }
+    const uint32_t now_ms = board_api::ms_since_boot();
+    if (interface.feedback_retry_ms != 0 &&
+        static_cast<int32_t>(now_ms - interface.feedback_retry_ms) < 0) {
+      return;
+    }
+    switch (interface.driver->send_feedback(*interface.gamepad, address,
+                                            instance)) {
+    case HostDriver::Feedback::SENT:
+      interface.feedback_pending = false;
+      break;
+    case HostDriver::Feedback::BUSY:
+      interface.feedback_retry_ms = (now_ms + FEEDBACK_RETRY_MS) | 1;
+      break;
+    case HostDriver::Feedback::NONE:
+      // The driver may not have read it, clear new_pad_out() so it isn't
+      // picked up again next pass
+      interface.gamepad->get_pad_out();
+      interface.feedback_pending = false;
+      break;
+    }
+  }
+
   inline uint8_t find_free_device_slot() {
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i) {
       if (device_slots_[i].address == INVALID_IDX) {
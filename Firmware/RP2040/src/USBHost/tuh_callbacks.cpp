@@ -75,6 +75,10 @@ void tuh_xinput::report_received_cb(uint8_t dev_addr, uint8_t instance, const ui
     HostManager::get_instance().process_report(dev_addr, instance, report, len);
 }
 
+void tuh_xinput::report_sent_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
+    HostManager::get_instance().report_sent_cb(dev_addr, instance, report, len);
+}
+
 void tuh_xinput::xbox360w_connect_cb(uint8_t dev_addr, uint8_t instance) {
     uint8_t idx = HostManager::get_instance().get_gamepad_idx(  HostManager::DriverClass::XINPUT, 
                                                                 dev_addr, instance);
@@ -0,0 +1,72 @@
+#include <hardware/sync.h>
+#include <pico/flash.h>
+
+#include "Board/board_api.h"
+#include "UserSettings/NVSTool.h"
+
+namespace
+{
+    struct FlashOp
+    {
+        uint32_t offset;
+        const void* data; //nullptr = erase one sector
+        size_t len;
+    };
+
+    //Runs with XIP unavailable, so it and everything it calls has to live in RAM
+    void __not_in_flash_func(flash_op_unsafe)(void* param)
+    {
+        const FlashOp* op = static_cast<const FlashOp*>(param);
+        if (op->data == nullptr)
+        {
+            flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+        }
+        else
+        {
+            flash_range_program(op->offset, static_cast<const uint8_t*>(op->data), op->len);
+        }
+    }
+
+    void flash_op_local(FlashOp& op)
+    {
+        uint32_t irq_state = save_and_disable_interrupts();
+        flash_op_unsafe(&op);
+        restore_interrupts(irq_state);
+    }
+
+    bool flash_op(FlashOp& op, uint32_t timeout_ms)
+    {
+        //Held in reset by board_api::usb::disconnect_all, it can't answer the lockout but
+        //isn't running from flash either
+        if (board_api::core1_stopped())
+        {
+            flash_op_local(op);
+            return true;
+        }
+        int ret = flash_safe_execute(flash_op_unsafe, &op, timeout_ms);
+        if (ret == PICO_OK)
+        {
+            return true;
+        }
+        //Not permitted: core1 hasn't been launched yet (boot), only this core's interrupts need
+        //to be kept off flash. A timeout means core1 is running but didn't park, so it's left alone.
+        if (ret == PICO_ERROR_NOT_PERMITTED)
+        {
+            flash_op_local(op);
+            return true;
+        }
+        return false;
+    }
+}
+
+bool NVSTool::flash_erase(uint32_t offset)
+{
+    FlashOp op{ offset, nullptr, 0 };
+    return flash_op(op, FLASH_SAFE_TIMEOUT_MS);
+}
+
+bool NVSTool::flash_program(uint32_t offset, const void* data, size_t len)
+{
+    FlashOp op{ offset, data, len };
+    return flash_op(op, FLASH_SAFE_TIMEOUT_MS);
+}
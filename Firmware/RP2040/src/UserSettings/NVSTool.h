@@ -1,21 +1,64 @@
 #ifndef _NVS_TOOL_H_
 #define _NVS_TOOL_H_
 
+#include <cstddef>
 #include <cstdint>
-#include <string>
 #include <array>
+#include <vector>
 #include <cstring>
+#include <algorithm>
+#include <functional>
+#include <utility>
 #include <hardware/flash.h>
 #include <pico/mutex.h>
 
 /* Define NVS_SECTORS (number of sectors to allocate to storage) either here or with CMake */
 
+/*  Log structured key/value store.
+
+    Each write appends one page sized record (sequence number, length, CRC, key, value)
+    to the head sector, the valid record with the highest sequence number wins. Sectors
+    are used as a ring with the one after the head always kept erased. When the head
+    fills it moves into that spare sector and the oldest sector is garbage collected:
+    its live records are appended to the new head and it's erased to become the next
+    spare. Erases rotate evenly over all NVS_SECTORS.
+
+    A RAM index of key -> newest record is built once at boot, so reads are a lookup and
+    a memcpy and a write is a single page program unless it crosses into a new sector.
+    Power loss can at worst leave a torn record (fails CRC, ignored) or an interrupted
+    garbage collection, which is finished on the next boot.
+
+    A Transaction stages several keys in RAM and commit() programs them, followed by a
+    commit record holding a CRC over them, into consecutive pages with one flash call.
+    Staged records only count if the commit record made it, so either all keys of the
+    transaction are visible after a power loss or none are.
+
+    Every flash operation runs through flash_safe_execute, so the other core is parked in
+    RAM for the duration instead of faulting on XIP. commit_async() queues a transaction
+    for process(), which does at most one page program or one sector erase per call, so
+    the caller can spread a save over several loop iterations. The erase that completes a
+    garbage collection is also left to process() and only forced when the head needs
+    that sector. */
+
 class NVSTool
 {
 public:
     static constexpr size_t   KEY_LEN_MAX = 16; //Including null terminator
-    static constexpr size_t   VALUE_LEN_MAX = FLASH_PAGE_SIZE - KEY_LEN_MAX;
-    static constexpr uint32_t MAX_ENTRIES = ((NVS_SECTORS * FLASH_SECTOR_SIZE) / FLASH_PAGE_SIZE) - 1;
+    static constexpr size_t   RECORD_HEADER_LEN = 16;
+    static constexpr size_t   VALUE_LEN_MAX = FLASH_PAGE_SIZE - RECORD_HEADER_LEN - KEY_LEN_MAX;
+    static constexpr uint32_t PAGES_PER_SECTOR = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+    static constexpr uint32_t SLOTS_PER_SECTOR = PAGES_PER_SECTOR - 1; //First page is the sector header
+    static constexpr size_t   INDEX_SIZE = 64;
+    //Members plus the commit record have to fit in one sector
+    static constexpr uint32_t TRANSACTION_KEYS_MAX = SLOTS_PER_SECTOR - 1;
+    //Live keys have to fit in the sectors that aren't the spare or being collected
+    static constexpr uint32_t MAX_ENTRIES = std::min<uint32_t>(INDEX_SIZE / 2, (NVS_SECTORS - 2) * SLOTS_PER_SECTOR);
+
+    static_assert(NVS_SECTORS >= 3, "NVSTool needs at least 3 sectors");
+
+    class Transaction;
+
+    using Callback = std::function<void(bool success)>;
 
     static NVSTool& get_instance()
     {
@@ -23,7 +66,10 @@ public:
         return instance;
     }
 
-    bool write(const std::string& key, const void* value, size_t len)
+    //Keys written through the returned Transaction only land in flash on its commit()
+    Transaction begin();
+
+    bool write(const char* key, const void* value, size_t len)
     {
         if (!valid_args(key, len))
         {
@@ -31,25 +77,35 @@ public:
         }
 
         mutex_enter_blocking(&nvs_mutex_);
+        drain();
 
-        for (uint32_t i = 1; i < MAX_ENTRIES; ++i) 
-        {
-            Entry* read_entry = get_entry(i);
+        IndexEntry* entry = find(key);
 
-            if (!is_valid_entry(read_entry) || std::strcmp(read_entry->key, key.c_str()) == 0)
+        if (entry != nullptr && entry->page != NO_PAGE)
+        {
+            const Record* stored = get_record(entry->page);
+            if (stored->len == len && std::memcmp(stored->value, value, len) == 0)
             {
-                update_entry(i, key, value, len);
-
+                //Nothing to do, save the flash
                 mutex_exit(&nvs_mutex_);
                 return true;
             }
         }
+        else if ((entry = insert(key)) == nullptr)
+        {
+            mutex_exit(&nvs_mutex_);
+            return false; // No space for new entry
+        }
+
+        Record record(key, value, len);
+        bool ret = append(record, *entry);
 
         mutex_exit(&nvs_mutex_);
-        return false; // No space for new entry
+        return ret;
     }
 
-    bool read(const std::string& key, void* value, size_t len)
+    //stored_len, if given, receives the length the value was written with
+    bool read(const char* key, void* value, size_t len, size_t* stored_len = nullptr)
     {
         if (!valid_args(key, len))
         {
@@ -58,123 +114,937 @@ public:
 
         mutex_enter_blocking(&nvs_mutex_);
 
-        for (uint32_t i = 1; i < MAX_ENTRIES; ++i) 
+        const IndexEntry* entry = find(key);
+        if (entry == nullptr || entry->page == NO_PAGE)
         {
-            Entry* read_entry = get_entry(i);
-
-            if (std::strcmp(read_entry->key, key.c_str()) == 0)
-            {
-                std::memcpy(value, read_entry->value, len);
+            // Key not found
+            mutex_exit(&nvs_mutex_);
+            return false;
+        }
 
-                mutex_exit(&nvs_mutex_);
-                return true;
-            }
-            else if (!is_valid_entry(read_entry))
-            {
-                // Key not found
-                break;
-            }
+        const Record* record = get_record(entry->page);
+        std::memcpy(value, record->value, std::min<size_t>(len, record->len));
+        if (stored_len != nullptr)
+        {
+            *stored_len = record->len;
         }
 
         mutex_exit(&nvs_mutex_);
-        return false;
+        return true;
     }
 
     void erase_all()
     {
         mutex_enter_blocking(&nvs_mutex_);
 
-        for (uint32_t i = 0; i < NVS_SECTORS; ++i) 
+        while (!jobs_.empty())
         {
-            flash_range_erase(NVS_START_OFFSET + i * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+            complete(false);
         }
+        pending_erase_ = NO_SECTOR;
 
-        Entry entry;
-
-        for (uint32_t i = 0; i < MAX_ENTRIES + 1; ++i) 
+        for (uint32_t i = 0; i < NVS_SECTORS; ++i)
         {
-            flash_range_program(NVS_START_OFFSET + i * sizeof(Entry), 
-                                reinterpret_cast<const uint8_t*>(&entry), 
-                                sizeof(Entry));
+            erase_sector(i);
         }
 
+        index_.fill(IndexEntry());
+        index_count_ = 0;
+        head_sector_ = 0;
+        head_slot_ = 1;
+
         mutex_exit(&nvs_mutex_);
+        run_callbacks();
+    }
+
+    //Does one flash operation of queued work and runs the callbacks of finished transactions,
+    //returns true while there is work left. Call from the core that owns the settings.
+    bool process()
+    {
+        mutex_enter_blocking(&nvs_mutex_);
+        step();
+        bool busy = (!jobs_.empty() || pending_erase_ != NO_SECTOR);
+        mutex_exit(&nvs_mutex_);
+
+        run_callbacks();
+        return busy;
     }
 
 private:
     NVSTool()
     {
         mutex_init(&nvs_mutex_);
-
-        Entry* initial_entry = get_entry(0);
-
-        if (std::strcmp(initial_entry->key, INVALID_KEY) != 0) 
-        {
-            erase_all();
-        }
+        mount();
     }
 
     ~NVSTool() = default;
     NVSTool(const NVSTool&) = delete;
     NVSTool& operator=(const NVSTool&) = delete;
 
-    struct Entry 
+    //Host tests (test/FlashSim.h) mount instances over a simulated flash and drop them at a power cut
+    friend class NVSToolTest;
+
+    static constexpr uint32_t SECTOR_MAGIC = 0x4C53564E; //"NVSL"
+    static constexpr uint32_t RECORD_MAGIC = 0x5243564E; //"NVCR"
+    static constexpr uint32_t ERASED_WORD = 0xFFFFFFFF;
+    static constexpr uint16_t NO_PAGE = 0xFFFF;
+    static constexpr uint32_t NO_SECTOR = 0xFFFFFFFF;
+    static constexpr size_t   ASYNC_JOBS_MAX = 4;
+    static constexpr uint32_t FLASH_SAFE_TIMEOUT_MS = 50;
+
+    //Record types, only ever clear bits so a torn type can't turn into another valid one
+    static constexpr uint16_t RECORD_SINGLE = 0xFFFF;
+    static constexpr uint16_t RECORD_TXN_MEMBER = 0xFFFE;
+    static constexpr uint16_t RECORD_TXN_COMMIT = 0xFFFC;
+
+    struct CommitValue
+    {
+        uint32_t first_seq;
+        uint32_t count;
+        uint32_t members_crc; //CRC over the members' crc fields
+    };
+    static constexpr const char LEGACY_INVALID_KEY[KEY_LEN_MAX] = "INVALID";
+    static constexpr uint32_t NVS_START_OFFSET = PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE * NVS_SECTORS;
+
+    struct SectorHeader
+    {
+        uint32_t magic;
+        uint32_t erase_count;
+        uint8_t reserved[FLASH_PAGE_SIZE - 8];
+
+        SectorHeader()
+        {
+            std::memset(this, 0xFF, sizeof(SectorHeader));
+        }
+    };
+    static_assert(sizeof(SectorHeader) == FLASH_PAGE_SIZE, "NVSTool::SectorHeader size mismatch");
+
+    struct Record
     {
+        uint32_t magic;
+        uint32_t crc; //Everything after this field
+        uint32_t seq;
+        uint16_t len;
+        uint16_t type;
         char key[KEY_LEN_MAX];
         uint8_t value[VALUE_LEN_MAX];
 
-        Entry()
+        Record()
         {
+            std::memset(this, 0xFF, sizeof(Record));
             std::fill(std::begin(key), std::end(key), '\0');
-            std::strncpy(key, INVALID_KEY, sizeof(key) - 1);
-            std::fill(std::begin(value), std::end(value), 0xFF);
+        }
+
+        Record(const char* new_key, const void* new_value, size_t new_len)
+            : Record()
+        {
+            copy_key(key, new_key);
+            len = static_cast<uint16_t>(new_len);
+            std::memcpy(value, new_value, new_len);
         }
     };
-    static_assert(sizeof(Entry) == FLASH_PAGE_SIZE, "NVSTool::Entry size mismatch");
+    static_assert(sizeof(Record) == FLASH_PAGE_SIZE, "NVSTool::Record size mismatch");
+    static_assert(offsetof(Record, key) == RECORD_HEADER_LEN, "NVSTool::Record header size mismatch");
 
-    static constexpr const char INVALID_KEY[KEY_LEN_MAX] = "INVALID";
-    static constexpr uint32_t NVS_START_OFFSET = PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE * NVS_SECTORS;
+    struct IndexEntry
+    {
+        char key[KEY_LEN_MAX]{0}; //Empty = unused
+        uint32_t seq{0};
+        uint16_t page{NO_PAGE};
+    };
+
+    struct AsyncJob
+    {
+        std::vector<Record> records; //Members, then the commit record once prepared
+        Callback done;
+        uint32_t first_page{0};
+        uint32_t next{0};
+        bool prepared{false};
+    };
 
     mutex_t nvs_mutex_;
 
-    inline Entry* get_entry(const uint32_t index) 
+    std::array<IndexEntry, INDEX_SIZE> index_;
+    uint32_t index_count_{0};
+    uint32_t seq_{0};
+    uint32_t head_sector_{0};
+    uint32_t head_slot_{1};
+    uint32_t max_erase_count_{0};
+    uint32_t pending_erase_{NO_SECTOR};
+
+    std::vector<AsyncJob> jobs_;
+    std::vector<std::pair<Callback, bool>> completed_;
+
+    //Defined in NVSTool.cpp, run from RAM with the other core locked out
+    static bool flash_erase(uint32_t offset);
+    static bool flash_program(uint32_t offset, const void* data, size_t len);
+
+    static inline uint32_t page_offset(uint32_t page)
     {
-        return reinterpret_cast<Entry*>(XIP_BASE + NVS_START_OFFSET + index * sizeof(Entry));
+        return NVS_START_OFFSET + page * FLASH_PAGE_SIZE;
     }
 
-    inline bool is_valid_entry(const Entry* entry) 
+    static inline uint32_t sector_offset(uint32_t sector)
     {
-        return std::strcmp(entry->key, INVALID_KEY) != 0;
+        return NVS_START_OFFSET + sector * FLASH_SECTOR_SIZE;
     }
 
-    inline bool valid_args(const std::string& key, size_t len)
+    static inline const Record* get_record(uint32_t page)
     {
-        return (key.size() < KEY_LEN_MAX - 1 && len <= sizeof(Entry::value) && std::strcmp(key.c_str(), INVALID_KEY) != 0);
+        return reinterpret_cast<const Record*>(XIP_BASE + page_offset(page));
+    }
+
+    static inline const SectorHeader* get_sector_header(uint32_t sector)
+    {
+        return reinterpret_cast<const SectorHeader*>(XIP_BASE + sector_offset(sector));
+    }
+
+    static inline bool valid_args(const char* key, size_t len)
+    {
+        return (key != nullptr && key[0] != '\0' && strnlen(key, KEY_LEN_MAX) < KEY_LEN_MAX - 1 && len <= VALUE_LEN_MAX);
+    }
+
+    //Keys are bounded by valid_args, dst is always terminated
+    static inline void copy_key(char* dst, const char* src)
+    {
+        const size_t len = strnlen(src, KEY_LEN_MAX - 1);
+        std::memcpy(dst, src, len);
+        dst[len] = '\0';
+    }
+
+    static uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t len)
+    {
+        for (size_t i = 0; i < len; ++i)
+        {
+            crc ^= data[i];
+            for (uint8_t bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+            }
+        }
+        return crc;
     }
 
-    void update_entry(uint32_t index, const std::string& key, const void* buffer, size_t len)
+    static inline uint32_t crc32(const uint8_t* data, size_t len)
     {
-        uint32_t entry_offset = index * sizeof(Entry);
-        uint32_t sector_offset = ((NVS_START_OFFSET + entry_offset) / FLASH_SECTOR_SIZE) * FLASH_SECTOR_SIZE;
+        return ~crc32_update(0xFFFFFFFF, data, len);
+    }
 
-        std::array<uint8_t, FLASH_SECTOR_SIZE> sector_buffer;
-        std::memcpy(sector_buffer.data(), reinterpret_cast<const uint8_t*>(XIP_BASE + sector_offset), FLASH_SECTOR_SIZE);
+    static inline uint32_t record_crc(const Record* record)
+    {
+        const uint8_t* start = reinterpret_cast<const uint8_t*>(&record->seq);
+        return crc32(start, sizeof(Record) - offsetof(Record, seq));
+    }
 
-        flash_range_erase(sector_offset, FLASH_SECTOR_SIZE);
+    static inline bool is_valid_record(const Record* record)
+    {
+        return (record->magic == RECORD_MAGIC &&
+                record->len <= VALUE_LEN_MAX &&
+                record->crc == record_crc(record));
+    }
 
-        Entry* entry_to_write = reinterpret_cast<Entry*>(sector_buffer.data() + entry_offset);
+    static bool is_blank_page(uint32_t page)
+    {
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(XIP_BASE + page_offset(page));
+        for (uint32_t i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); ++i)
+        {
+            if (words[i] != ERASED_WORD)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        *entry_to_write = Entry();
-        std::strncpy(entry_to_write->key, key.c_str(), key.size());
-        entry_to_write->key[key.size()] = '\0';
-        std::memcpy(entry_to_write->value, buffer, len);
+    static bool is_clean_sector(uint32_t sector)
+    {
+        for (uint32_t slot = 1; slot < PAGES_PER_SECTOR; ++slot)
+        {
+            if (!is_blank_page(sector * PAGES_PER_SECTOR + slot))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        for (uint32_t i = 0; i < FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE; ++i) 
+    static inline uint32_t hash(const char* key)
+    {
+        uint32_t hash = 2166136261u;
+        while (*key)
         {
-            flash_range_program(sector_offset + i * FLASH_PAGE_SIZE, sector_buffer.data() + i * FLASH_PAGE_SIZE, FLASH_PAGE_SIZE);
+            hash = (hash ^ static_cast<uint8_t>(*key++)) * 16777619u;
         }
+        return hash;
+    }
+
+    IndexEntry* find(const char* key)
+    {
+        for (uint32_t i = 0, pos = hash(key) % INDEX_SIZE; i < INDEX_SIZE; ++i, pos = (pos + 1) % INDEX_SIZE)
+        {
+            if (index_[pos].key[0] == '\0')
+            {
+                return nullptr;
+            }
+            if (std::strncmp(index_[pos].key, key, KEY_LEN_MAX) == 0)
+            {
+                return &index_[pos];
+            }
+        }
+        return nullptr;
+    }
+
+    //Returns the existing or a new (page == NO_PAGE) entry, nullptr if the index is full
+    IndexEntry* insert(const char* key)
+    {
+        if (IndexEntry* entry = find(key))
+        {
+            return entry;
+        }
+        if (index_count_ >= MAX_ENTRIES)
+        {
+            return nullptr;
+        }
+        for (uint32_t i = 0, pos = hash(key) % INDEX_SIZE; i < INDEX_SIZE; ++i, pos = (pos + 1) % INDEX_SIZE)
+        {
+            if (index_[pos].key[0] == '\0')
+            {
+                copy_key(index_[pos].key, key);
+                ++index_count_;
+                return &index_[pos];
+            }
+        }
+        return nullptr;
+    }
+
+    //False if the flash couldn't be locked for it, the sector is then left as it was or headerless
+    bool erase_sector(uint32_t sector)
+    {
+        const SectorHeader* old_header = get_sector_header(sector);
+        uint32_t erase_count = (old_header->magic == SECTOR_MAGIC) ? old_header->erase_count : max_erase_count_;
+
+        if (!flash_erase(sector_offset(sector)))
+        {
+            return false;
+        }
+
+        SectorHeader header;
+        header.magic = SECTOR_MAGIC;
+        header.erase_count = erase_count + 1;
+        max_erase_count_ = std::max(max_erase_count_, header.erase_count);
+
+        if (!flash_program(sector_offset(sector), &header, sizeof(SectorHeader)))
+        {
+            return false;
+        }
+
+        if (pending_erase_ == sector)
+        {
+            pending_erase_ = NO_SECTOR;
+        }
+        return true;
+    }
+
+    //A failed erase stays pending
+    bool finish_erase()
+    {
+        return (pending_erase_ == NO_SECTOR) || erase_sector(pending_erase_);
+    }
+
+    //Programs record into the next free slot and points entry at it, record.key and .value must be set
+    bool program(Record& record, IndexEntry& entry)
+    {
+        if (head_slot_ >= PAGES_PER_SECTOR)
+        {
+            return false;
+        }
+
+        record.magic = RECORD_MAGIC;
+        record.seq = ++seq_;
+        record.type = RECORD_SINGLE;
+        record.crc = record_crc(&record);
+
+        uint32_t page = head_sector_ * PAGES_PER_SECTOR + head_slot_++;
+        if (!flash_program(page_offset(page), &record, sizeof(Record)) || !is_valid_record(get_record(page)))
+        {
+            return false;
+        }
+
+        entry.seq = record.seq;
+        entry.page = static_cast<uint16_t>(page);
+        return true;
+    }
+
+    //A page that fails to verify is skipped and the next slot tried once
+    bool program_retry(Record& record, IndexEntry& entry)
+    {
+        return program(record, entry) || program(record, entry);
+    }
+
+    //Copies the live records of a sector to the head, the sector is erased later by process()
+    //or when the head reaches it. If a copy fails the sector keeps its live records and isn't
+    //scheduled for erase.
+    void collect(uint32_t sector)
+    {
+        bool copied = true;
+        for (IndexEntry& entry : index_)
+        {
+            if (entry.key[0] == '\0' || entry.page == NO_PAGE || (entry.page / PAGES_PER_SECTOR) != sector)
+            {
+                continue;
+            }
+            Record record;
+            std::memcpy(&record, get_record(entry.page), sizeof(Record));
+            copied = program_retry(record, entry) && copied;
+        }
+
+        if (copied && !is_clean_sector(sector))
+        {
+            finish_erase();
+            pending_erase_ = sector;
+        }
+    }
+
+    //Copies what's left in the spare to the head. Until that worked (collect() failed or was
+    //cut off) the head holds nothing but copies from it, so if they don't fit it's erased and
+    //the collection starts over from the originals. False while the spare has live records.
+    bool collect_spare()
+    {
+        uint32_t spare = (head_sector_ + 1) % NVS_SECTORS;
+        if (pending_erase_ == spare || is_clean_sector(spare))
+        {
+            return true;
+        }
+
+        if (live_records_in(spare) > (PAGES_PER_SECTOR - head_slot_))
+        {
+            if (!erase_sector(head_sector_))
+            {
+                return false;
+            }
+            scan();
+            spare = (head_sector_ + 1) % NVS_SECTORS;
+        }
+        collect(spare);
+        return (live_records_in(spare) == 0);
+    }
+
+    //Moves the head on until it has room for slots records, false if it can't. Nothing new goes
+    //into the head while a collection is unfinished, or collect_spare() could erase it with the copies.
+    bool reserve(uint32_t slots)
+    {
+        if (!collect_spare())
+        {
+            return false;
+        }
+
+        //Bounded, each step frees a whole sector
+        for (uint32_t i = 0; i < NVS_SECTORS && (PAGES_PER_SECTOR - head_slot_) < slots; ++i)
+        {
+            //The sector after the head is the erased spare, the one after that is the oldest
+            const uint32_t next = (head_sector_ + 1) % NVS_SECTORS;
+            if (pending_erase_ != next && get_sector_header(next)->magic != SECTOR_MAGIC)
+            {
+                //Its header program failed, erase it again
+                if (!finish_erase())
+                {
+                    return false;
+                }
+                pending_erase_ = next;
+            }
+            //Never move the head into a sector that isn't erased
+            if (pending_erase_ == next && !finish_erase())
+            {
+                return false;
+            }
+            head_sector_ = next;
+            head_slot_ = 1;
+            if (!collect_spare())
+            {
+                return false;
+            }
+        }
+        return (PAGES_PER_SECTOR - head_slot_) >= slots;
+    }
+
+    bool append(Record& record, IndexEntry& entry)
+    {
+        return reserve(1) && program_retry(record, entry);
+    }
+
+    //records holds the members followed by space for the commit record. Fills in the records
+    //and claims their pages at the head, nothing is programmed yet.
+    bool prepare_transaction(std::vector<Record>& records, uint32_t& first_page)
+    {
+        const uint32_t count = static_cast<uint32_t>(records.size() - 1);
+
+        uint32_t new_keys = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (find(records[i].key) == nullptr)
+            {
+                ++new_keys;
+            }
+        }
+        if (index_count_ + new_keys > MAX_ENTRIES)
+        {
+            return false;
+        }
+
+        if (!reserve(count + 1))
+        {
+            return false;
+        }
+
+        CommitValue commit{ seq_ + 1, count, 0 };
+        std::vector<uint32_t> member_crcs(count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            records[i].magic = RECORD_MAGIC;
+            records[i].seq = ++seq_;
+            records[i].type = RECORD_TXN_MEMBER;
+            records[i].crc = record_crc(&records[i]);
+            member_crcs[i] = records[i].crc;
+        }
+        commit.members_crc = crc32(reinterpret_cast<const uint8_t*>(member_crcs.data()), count * sizeof(uint32_t));
+
+        Record& commit_record = records.back();
+        commit_record = Record();
+        commit_record.magic = RECORD_MAGIC;
+        commit_record.seq = ++seq_;
+        commit_record.len = sizeof(CommitValue);
+        commit_record.type = RECORD_TXN_COMMIT;
+        std::memcpy(commit_record.value, &commit, sizeof(CommitValue));
+        commit_record.crc = record_crc(&commit_record);
+
+        first_page = head_sector_ * PAGES_PER_SECTOR + head_slot_;
+        head_slot_ += count + 1;
+        return true;
+    }
+
+    //Verifies the programmed commit record and points the index at the members
+    bool finish_transaction(const std::vector<Record>& records, uint32_t first_page)
+    {
+        const uint32_t count = static_cast<uint32_t>(records.size() - 1);
+        if (!is_committed(first_page + count))
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            IndexEntry* entry = insert(records[i].key);
+            entry->seq = records[i].seq;
+            entry->page = static_cast<uint16_t>(first_page + i);
+        }
+        return true;
+    }
+
+    bool program_transaction(std::vector<Record>& records)
+    {
+        uint32_t first_page = 0;
+        if (!prepare_transaction(records, first_page))
+        {
+            return false;
+        }
+
+        //Pages are programmed in order, the commit record lands last. The claimed pages stay
+        //used if one fails, without a commit record nothing in them counts.
+        for (uint32_t i = 0; i < records.size(); ++i)
+        {
+            if (!flash_program(page_offset(first_page + i), &records[i], sizeof(Record)))
+            {
+                return false;
+            }
+        }
+        return finish_transaction(records, first_page);
+    }
+
+    //Drops anything that wouldn't change
+    void drop_unchanged(std::vector<Record>& records)
+    {
+        records.erase(std::remove_if(records.begin(), records.end(), [this](const Record& record)
+        {
+            const IndexEntry* entry = find(record.key);
+            if (entry == nullptr || entry->page == NO_PAGE)
+            {
+                return false;
+            }
+            const Record* stored = get_record(entry->page);
+            return (stored->len == record.len && std::memcmp(stored->value, record.value, record.len) == 0);
+        }), records.end());
+    }
+
+    bool commit(std::vector<Record>& records)
+    {
+        mutex_enter_blocking(&nvs_mutex_);
+        drain();
+
+        drop_unchanged(records);
+
+        bool ret = true;
+        if (!records.empty())
+        {
+            records.emplace_back(); //Commit record
+            ret = program_transaction(records);
+        }
+
+        mutex_exit(&nvs_mutex_);
+        run_callbacks();
+        return ret;
+    }
+
+    bool commit_async(std::vector<Record>& records, Callback done)
+    {
+        mutex_enter_blocking(&nvs_mutex_);
+
+        bool ret = (jobs_.size() < ASYNC_JOBS_MAX);
+        if (ret)
+        {
+            jobs_.push_back(AsyncJob{ std::move(records), std::move(done) });
+        }
+
+        mutex_exit(&nvs_mutex_);
+        return ret;
+    }
+
+    //Moves the front job on by one flash operation, or does the pending erase if there are none
+    void step()
+    {
+        if (jobs_.empty())
+        {
+            finish_erase();
+            return;
+        }
+
+        AsyncJob& job = jobs_.front();
+        if (!job.prepared)
+        {
+            drop_unchanged(job.records);
+            if (job.records.empty())
+            {
+                complete(true);
+                return;
+            }
+            job.records.emplace_back(); //Commit record
+            if (!prepare_transaction(job.records, job.first_page))
+            {
+                complete(false);
+                return;
+            }
+            job.prepared = true;
+            return;
+        }
+
+        //One page per step, in order so the commit record lands last
+        if (!flash_program(page_offset(job.first_page + job.next), &job.records[job.next], sizeof(Record)))
+        {
+            complete(false);
+            return;
+        }
+        if (++job.next == job.records.size())
+        {
+            complete(finish_transaction(job.records, job.first_page));
+        }
+    }
+
+    //Queued jobs go first so synchronous writes keep their order
+    void drain()
+    {
+        while (!jobs_.empty())
+        {
+            step();
+        }
+    }
+
+    void complete(bool success)
+    {
+        completed_.emplace_back(std::move(jobs_.front().done), success);
+        jobs_.erase(jobs_.begin());
+    }
+
+    void run_callbacks()
+    {
+        mutex_enter_blocking(&nvs_mutex_);
+        std::vector<std::pair<Callback, bool>> completed;
+        completed.swap(completed_);
+        mutex_exit(&nvs_mutex_);
+
+        for (auto& [done, success] : completed)
+        {
+            if (done)
+            {
+                done(success);
+            }
+        }
+    }
+
+    //Checks a commit record and the members in the pages right before it
+    bool is_committed(uint32_t commit_page)
+    {
+        const Record* commit_record = get_record(commit_page);
+        if (!is_valid_record(commit_record) || commit_record->type != RECORD_TXN_COMMIT)
+        {
+            return false;
+        }
+
+        CommitValue commit;
+        std::memcpy(&commit, commit_record->value, sizeof(CommitValue));
+
+        const uint32_t commit_slot = commit_page % PAGES_PER_SECTOR;
+        if (commit.count == 0 || commit.count >= commit_slot || commit.first_seq + commit.count != commit_record->seq)
+        {
+            return false;
+        }
+
+        uint32_t crc = 0xFFFFFFFF;
+        for (uint32_t i = 0; i < commit.count; ++i)
+        {
+            const Record* member = get_record(commit_page - commit.count + i);
+            if (!is_valid_record(member) || member->type != RECORD_TXN_MEMBER || member->seq != commit.first_seq + i)
+            {
+                return false;
+            }
+            crc = crc32_update(crc, reinterpret_cast<const uint8_t*>(&member->crc), sizeof(uint32_t));
+        }
+        return (~crc == commit.members_crc);
+    }
+
+    void index_record(uint32_t page)
+    {
+        const Record* record = get_record(page);
+        IndexEntry* entry = insert(record->key);
+        if (entry != nullptr && (entry->page == NO_PAGE || record->seq > entry->seq))
+        {
+            entry->seq = record->seq;
+            entry->page = static_cast<uint16_t>(page);
+        }
+    }
+
+    uint32_t live_records_in(uint32_t sector)
+    {
+        uint32_t count = 0;
+        for (const IndexEntry& entry : index_)
+        {
+            if (entry.key[0] != '\0' && entry.page != NO_PAGE && (entry.page / PAGES_PER_SECTOR) == sector)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    bool scan()
+    {
+        index_.fill(IndexEntry());
+        index_count_ = 0;
+        seq_ = 0;
+        head_sector_ = 0;
+        head_slot_ = 1;
+
+        bool found_record = false;
+        max_erase_count_ = 0;
+        std::array<uint32_t, NVS_SECTORS> last_used_slot{0};
+
+        for (uint32_t sector = 0; sector < NVS_SECTORS; ++sector)
+        {
+            const SectorHeader* header = get_sector_header(sector);
+            if (header->magic != SECTOR_MAGIC)
+            {
+                continue;
+            }
+            max_erase_count_ = std::max(max_erase_count_, header->erase_count);
+
+            for (uint32_t slot = 1; slot < PAGES_PER_SECTOR; ++slot)
+            {
+                uint32_t page = sector * PAGES_PER_SECTOR + slot;
+                if (is_blank_page(page))
+                {
+                    continue;
+                }
+                last_used_slot[sector] = slot;
+
+                const Record* record = get_record(page);
+                if (!is_valid_record(record) || record->key[KEY_LEN_MAX - 1] != '\0')
+                {
+                    continue; //Torn write
+                }
+
+                if (record->type == RECORD_SINGLE)
+                {
+                    index_record(page);
+                }
+                else if (record->type == RECORD_TXN_COMMIT && is_committed(page))
+                {
+                    //Members are only applied once their commit record is found
+                    const uint32_t count = reinterpret_cast<const CommitValue*>(record->value)->count;
+                    for (uint32_t member = page - count; member < page; ++member)
+                    {
+                        index_record(member);
+                    }
+                }
+
+                if (!found_record || record->seq > seq_)
+                {
+                    seq_ = record->seq;
+                    head_sector_ = sector;
+                    found_record = true;
+                }
+            }
+        }
+
+        head_slot_ = last_used_slot[head_sector_] + 1;
+        return found_record;
+    }
+
+    void mount()
+    {
+        uint32_t valid_sectors = 0;
+        for (uint32_t sector = 0; sector < NVS_SECTORS; ++sector)
+        {
+            if (get_sector_header(sector)->magic == SECTOR_MAGIC)
+            {
+                ++valid_sectors;
+            }
+        }
+
+        if (valid_sectors == 0)
+        {
+            format();
+            return;
+        }
+
+        //Only a sector cut off mid erase can lack a header, its records were already moved
+        for (uint32_t sector = 0; sector < NVS_SECTORS; ++sector)
+        {
+            if (get_sector_header(sector)->magic != SECTOR_MAGIC)
+            {
+                erase_sector(sector);
+            }
+        }
+
+        scan();
+
+        //Finishes a garbage collection that was interrupted
+        collect_spare();
+        finish_erase(); //Nothing else is running yet
+    }
+
+    //Erases everything, carrying over records from the old fixed slot layout if present
+    void format()
+    {
+        const char* legacy_marker = reinterpret_cast<const char*>(XIP_BASE + page_offset(0));
+        std::vector<Record> legacy;
+
+        if (std::strncmp(legacy_marker, LEGACY_INVALID_KEY, KEY_LEN_MAX) == 0)
+        {
+            //Old layout: page 0 is a marker, then key[16] + value[240] per page until the first unused one
+            for (uint32_t page = 1; page < NVS_SECTORS * PAGES_PER_SECTOR; ++page)
+            {
+                const char* key = reinterpret_cast<const char*>(XIP_BASE + page_offset(page));
+                if (std::strncmp(key, LEGACY_INVALID_KEY, KEY_LEN_MAX) == 0 ||
+                    key[0] == '\0' || key[KEY_LEN_MAX - 1] != '\0')
+                {
+                    break;
+                }
+                Record record;
+                copy_key(record.key, key);
+                record.len = VALUE_LEN_MAX;
+                std::memcpy(record.value, key + KEY_LEN_MAX, VALUE_LEN_MAX);
+                legacy.push_back(record);
+            }
+        }
+
+        for (uint32_t i = 0; i < NVS_SECTORS; ++i)
+        {
+            erase_sector(i);
+        }
+
+        index_.fill(IndexEntry());
+        index_count_ = 0;
+        head_sector_ = 0;
+        head_slot_ = 1;
+
+        for (Record& record : legacy)
+        {
+            if (IndexEntry* entry = insert(record.key))
+            {
+                append(record, *entry);
+            }
+        }
+        finish_erase();
     }
 
 }; // class NVSTool
 
-#endif // _NVS_TOOL_H_
\ No newline at end of file
+class NVSTool::Transaction
+{
+public:
+    //Stages a write, writing the same key again replaces the staged value
+    bool write(const char* key, const void* value, size_t len)
+    {
+        if (!valid_args(key, len))
+        {
+            failed_ = true;
+            return false;
+        }
+        for (Record& record : records_)
+        {
+            if (std::strncmp(record.key, key, KEY_LEN_MAX) == 0)
+            {
+                record = Record(key, value, len);
+                return true;
+            }
+        }
+        if (records_.size() >= TRANSACTION_KEYS_MAX)
+        {
+            failed_ = true;
+            return false;
+        }
+        records_.emplace_back(key, value, len);
+        return true;
+    }
+
+    //Writes all staged keys or none of them, fails if any staged write failed
+    bool commit()
+    {
+        if (failed_)
+        {
+            return false;
+        }
+        bool ret = nvs_.commit(records_);
+        records_.clear();
+        return ret;
+    }
+
+    //Queues the staged keys for NVSTool::process(), done gets the result of the commit.
+    //Returns false if a staged write failed or the queue is full.
+    bool commit_async(Callback done = nullptr)
+    {
+        if (failed_)
+        {
+            return false;
+        }
+        bool ret = nvs_.commit_async(records_, std::move(done));
+        records_.clear();
+        return ret;
+    }
+
+private:
+    friend class NVSTool;
+
+    explicit Transaction(NVSTool& nvs)
+        : nvs_(nvs) {}
+
+    NVSTool& nvs_;
+    std::vector<Record> records_;
+    bool failed_{false};
+};
+
+inline NVSTool::Transaction NVSTool::begin()
+{
+    return Transaction(*this);
+}
+
+#endif // _NVS_TOOL_H_
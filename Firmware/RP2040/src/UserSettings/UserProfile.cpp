@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 
 #include "Gamepad/Gamepad.h"
@@ -37,4 +38,64 @@ UserProfile::UserProfile()
     analog_off_y = Gamepad::ANALOG_OFF_Y;
     analog_off_lb = Gamepad::ANALOG_OFF_LB;
     analog_off_rb = Gamepad::ANALOG_OFF_RB;
-}
\ No newline at end of file
+}
+
+namespace ProfileFormat
+{
+    //Brings a profile read from an older version up to the current layout, one version per step
+    static void migrate(uint8_t version, [[maybe_unused]] UserProfile& profile)
+    {
+        switch (version)
+        {
+            case LEGACY_VERSION:
+                //Same layout, only the header is new
+                [[fallthrough]];
+            default:
+                break;
+        }
+    }
+
+    size_t encode(const UserProfile& profile, uint8_t* buffer)
+    {
+        Header header{ MAGIC, VERSION, static_cast<uint16_t>(sizeof(UserProfile)) };
+        std::memcpy(buffer, &header, sizeof(Header));
+        std::memcpy(buffer + sizeof(Header), &profile, sizeof(UserProfile));
+        return ENCODED_LEN;
+    }
+
+    bool decode(const uint8_t* data, size_t len, UserProfile& profile, bool& outdated)
+    {
+        if (len == 0)
+        {
+            return false;
+        }
+
+        uint8_t version = LEGACY_VERSION;
+        const uint8_t* payload = data;
+        size_t payload_len = len;
+
+        if (data[0] == MAGIC)
+        {
+            Header header;
+            if (len < sizeof(Header))
+            {
+                return false;
+            }
+            std::memcpy(&header, data, sizeof(Header));
+            version = header.version;
+            payload = data + sizeof(Header);
+            payload_len = std::min<size_t>(header.len, len - sizeof(Header));
+        }
+
+        UserProfile decoded;
+        std::memcpy(&decoded, payload, std::min(payload_len, sizeof(UserProfile)));
+        if (version < VERSION)
+        {
+            migrate(version, decoded);
+        }
+
+        profile = decoded;
+        outdated = (version < VERSION);
+        return true;
+    }
+}
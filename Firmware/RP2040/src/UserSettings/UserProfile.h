@@ -1,6 +1,7 @@
 #ifndef _USER_PROFILE_H_
 #define _USER_PROFILE_H_
 
+#include <cstddef>
 #include <cstdint>
 
 #include "UserSettings/JoystickSettings.h"
@@ -52,4 +53,35 @@ struct UserProfile
 static_assert(sizeof(UserProfile) == 190, "UserProfile struct size mismatch");
 #pragma pack(pop)
 
+/*  On flash a profile is a Header followed by the UserProfile bytes.
+
+    UserProfile is also the WebApp/BLE wire format, so fields are only ever appended:
+    a shorter payload from older firmware is read over the defaults, a longer one from
+    newer firmware is cut to what this build knows. Changes that can't be expressed by
+    appending bump VERSION and add a step to migrate(). Profiles stored before the header
+    existed are a bare UserProfile, told apart by the magic (ids only go up to 8). */
+namespace ProfileFormat
+{
+    static constexpr uint8_t MAGIC = 0xA5;
+    static constexpr uint8_t LEGACY_VERSION = 0;
+    static constexpr uint8_t VERSION = 1;
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint8_t magic;
+        uint8_t version;
+        uint16_t len; //Payload length
+    };
+#pragma pack(pop)
+
+    static constexpr size_t ENCODED_LEN = sizeof(Header) + sizeof(UserProfile);
+
+    //buffer must hold ENCODED_LEN bytes, returns the encoded length
+    size_t encode(const UserProfile& profile, uint8_t* buffer);
+
+    //Fills profile from a stored value, outdated is set if it should be rewritten in the current format
+    bool decode(const uint8_t* data, size_t len, UserProfile& profile, bool& outdated);
+}
+
 #endif // _USER_PROFILE_H_
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "Board/board_api.h"
 #include "Board/ogxm_log.h"
+#include "TaskQueue/TaskQueue.h"
 #include "UserSettings/UserSettings.h"
 
 static constexpr uint32_t BUTTON_COMBO(const uint16_t &buttons,
@@ -91,25 +92,39 @@ static constexpr std::array<ComboMap, 11> BUTTON_COMBO_MAP = {
      {ButtonCombo::DS4, DeviceDriverType::DS4},
      {ButtonCombo::PSCLASSIC, DeviceDriverType::PSCLASSIC}}};
 
-const std::string UserSettings::INIT_FLAG_KEY() {
-  return std::string("init_flag");
+UserSettings::Key UserSettings::KEY(const char *prefix, int32_t number) {
+  Key key{};
+  size_t len = strnlen(prefix, key.size() - 1);
+  std::memcpy(key.data(), prefix, len);
+
+  if (number >= 0) {
+    char digits[10];
+    size_t count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + number % 10);
+      number /= 10;
+    } while (number > 0);
+
+    while (count > 0 && len < key.size() - 1) {
+      key[len++] = digits[--count];
+    }
+  }
+  return key;
 }
 
-const std::string UserSettings::PROFILE_KEY(const uint8_t profile_id) {
-  return std::string("profile_") + std::to_string(profile_id);
-}
+UserSettings::Key UserSettings::INIT_FLAG_KEY() { return KEY("init_flag"); }
 
-const std::string UserSettings::ACTIVE_PROFILE_KEY(const uint8_t index) {
-  return std::string("active_id_") + std::to_string(index);
+UserSettings::Key UserSettings::PROFILE_KEY(const uint8_t profile_id) {
+  return KEY("profile_", profile_id);
 }
 
-const std::string UserSettings::DRIVER_TYPE_KEY() {
-  return std::string("driver_type");
+UserSettings::Key UserSettings::ACTIVE_PROFILE_KEY(const uint8_t index) {
+  return KEY("active_id_", index);
 }
 
-const std::string UserSettings::DATETIME_KEY() {
-  return std::string("datetime");
-}
+UserSettings::Key UserSettings::DRIVER_TYPE_KEY() { return KEY("driver_type"); }
+
+UserSettings::Key UserSettings::DATETIME_KEY() { return KEY("datetime"); }
 
 DeviceDriverType UserSettings::DEFAULT_DRIVER() {
   return VALID_DRIVER_TYPES[0];
@@ -159,7 +174,59 @@ bool UserSettings::check_for_driver_change(Gamepad &gamepad) {
   return true;
 }
 
-// Disconnects usb and resets pico, call from core0
+void UserSettings::cache_profile(uint8_t index, const UserProfile &profile) {
+  mutex_enter_blocking(&cache_mutex_);
+  profiles_[profile.id - 1] = profile;
+  active_profile_ids_[index] = profile.id;
+  mutex_exit(&cache_mutex_);
+}
+
+// Queues the profile for the background flash writer
+bool UserSettings::write_profile(uint8_t index, const UserProfile &profile) {
+  std::array<uint8_t, ProfileFormat::ENCODED_LEN> encoded;
+  size_t encoded_len = ProfileFormat::encode(profile, encoded.data());
+
+  NVSTool::Transaction transaction = nvs_tool_.begin();
+  transaction.write(ACTIVE_PROFILE_KEY(index).data(), &profile.id, sizeof(uint8_t));
+  transaction.write(PROFILE_KEY(profile.id).data(), encoded.data(), encoded_len);
+  if (!transaction.commit_async([](bool success) {
+        if (!success) {
+          OGXM_LOG_AT(NVS, WARN, "UserSettings::write_profile: Commit failed\n");
+        }
+      })) {
+    OGXM_LOG_AT(NVS, WARN, "UserSettings::write_profile: Queue full\n");
+    return false;
+  }
+  start_flash_writer();
+  return true;
+}
+
+// Steps NVSTool one flash operation per core0 task pass so USB keeps being
+// serviced in between
+void UserSettings::start_flash_writer() {
+  if (flash_writer_running_) {
+    return;
+  }
+  if (flash_task_id_ == 0) {
+    flash_task_id_ = TaskQueue::Core0::get_new_task_id();
+  }
+  flash_writer_running_ = TaskQueue::Core0::queue_delayed_task(
+      flash_task_id_, FLASH_STEP_INTERVAL_MS, false, [this] { run_flash_writer(); });
+  if (!flash_writer_running_) {
+    while (nvs_tool_.process()) {
+    }
+  }
+}
+
+void UserSettings::run_flash_writer() {
+  flash_writer_running_ = false;
+  if (nvs_tool_.process()) {
+    start_flash_writer();
+  }
+}
+
+// Applies the profile to the running gamepad and writes it to flash in the
+// background, no re-enumeration. Call from core0
 bool UserSettings::store_profile(uint8_t index, const UserProfile &profile) {
   if (profile.id < 1 || profile.id > MAX_PROFILES) {
     return false;
@@ -168,17 +235,16 @@ bool UserSettings::store_profile(uint8_t index, const UserProfile &profile) {
     index = 0;
   }
 
-  board_api::usb::disconnect_all();
-
-  nvs_tool_.write(ACTIVE_PROFILE_KEY(index), &profile.id, sizeof(uint8_t));
-  nvs_tool_.write(PROFILE_KEY(profile.id), &profile, sizeof(UserProfile));
-
-  board_api::reboot();
+  cache_profile(index, profile);
+  if (gamepads_[index]) {
+    gamepads_[index]->queue_profile(profile);
+  }
 
-  return true;
+  return write_profile(index, profile);
 }
 
-// Disconnects usb and resets pico, call from core0
+// Disconnects usb and resets pico if the driver type changes, otherwise same as
+// store_profile. Call from core0
 bool UserSettings::store_profile_and_driver_type(
     DeviceDriverType new_driver_type, uint8_t index,
     const UserProfile &profile) {
@@ -199,14 +265,25 @@ bool UserSettings::store_profile_and_driver_type(
   if (!valid_driver) {
     new_driver_type = DEFAULT_DRIVER();
   }
+  if (new_driver_type == get_current_driver()) {
+    return store_profile(index, profile);
+  }
 
   board_api::usb::disconnect_all();
 
-  nvs_tool_.write(DRIVER_TYPE_KEY(),
-                  reinterpret_cast<const uint8_t *>(&new_driver_type),
-                  sizeof(new_driver_type));
-  nvs_tool_.write(ACTIVE_PROFILE_KEY(index), &profile.id, sizeof(uint8_t));
-  nvs_tool_.write(PROFILE_KEY(profile.id), &profile, sizeof(UserProfile));
+  std::array<uint8_t, ProfileFormat::ENCODED_LEN> encoded;
+  size_t encoded_len = ProfileFormat::encode(profile, encoded.data());
+
+  // Driver type and profile land together or not at all
+  NVSTool::Transaction transaction = nvs_tool_.begin();
+  transaction.write(DRIVER_TYPE_KEY().data(),
+                    reinterpret_cast<const uint8_t *>(&new_driver_type),
+                    sizeof(new_driver_type));
+  transaction.write(ACTIVE_PROFILE_KEY(index).data(), &profile.id, sizeof(uint8_t));
+  transaction.write(PROFILE_KEY(profile.id).data(), encoded.data(), encoded_len);
+  if (!transaction.commit()) {
+    OGXM_LOG_AT(NVS, WARN, "UserSettings::store_profile_and_driver_type: Commit failed\n");
+  }
 
   board_api::reboot();
 
@@ -216,34 +293,37 @@ bool UserSettings::store_profile_and_driver_type(
 // Disconnects usb and resets pico if it's a new & valid mode, call from core0
 void UserSettings::store_driver_type(DeviceDriverType new_driver) {
   if (!is_valid_driver(new_driver)) {
-    OGXM_LOG("Invalid driver type detected during store: " +
-             OGXM_TO_STRING(new_driver) + "\n");
+    OGXM_LOG_AT(NVS, WARN, "Invalid driver type detected during store: " +
+                OGXM_TO_STRING(new_driver) + "\n");
     return;
   }
 
-  OGXM_LOG("Storing new driver type: " + OGXM_TO_STRING(new_driver) + "\n");
+  OGXM_LOG_AT(NVS, INFO, "Storing new driver type: " + OGXM_TO_STRING(new_driver) + "\n");
 
   board_api::usb::disconnect_all();
 
-  nvs_tool_.write(DRIVER_TYPE_KEY(), &new_driver, sizeof(uint8_t));
+  nvs_tool_.write(DRIVER_TYPE_KEY().data(), &new_driver, sizeof(uint8_t));
 
   board_api::reboot();
 }
 
+void UserSettings::initialize_profiles(Gamepad (&gamepads)[MAX_GAMEPADS]) {
+  for (uint8_t i = 0; i < MAX_GAMEPADS; i++) {
+    gamepads_[i] = &gamepads[i];
+    gamepads[i].set_profile(get_profile_by_index(i));
+  }
+}
+
 uint8_t UserSettings::get_active_profile_id(const uint8_t index) {
   if (index > MAX_GAMEPADS - 1) {
-    OGXM_LOG("UserSettings::get_active_profile_id: Invalid index\n");
+    OGXM_LOG_AT(NVS, WARN, "UserSettings::get_active_profile_id: Invalid index\n");
     return 0x01;
   }
 
-  uint8_t read_profile_id = 0;
-  nvs_tool_.read(ACTIVE_PROFILE_KEY(index), &read_profile_id, sizeof(uint8_t));
-
-  if (read_profile_id < 1 || read_profile_id > MAX_PROFILES) {
-    OGXM_LOG("UserSettings::get_active_profile_id: Invalid profile id\n");
-    return 0x01;
-  }
-  return read_profile_id;
+  mutex_enter_blocking(&cache_mutex_);
+  uint8_t profile_id = active_profile_ids_[index];
+  mutex_exit(&cache_mutex_);
+  return profile_id;
 }
 
 UserProfile UserSettings::get_profile_by_index(const uint8_t index) {
@@ -251,16 +331,60 @@ UserProfile UserSettings::get_profile_by_index(const uint8_t index) {
 }
 
 UserProfile UserSettings::get_profile_by_id(const uint8_t profile_id) {
-  UserProfile profile;
-  nvs_tool_.read(PROFILE_KEY(profile_id), &profile, sizeof(UserProfile));
-
-  if (profile.id != profile_id) {
-    OGXM_LOG("Profile read failed, returning default profile\n");
+  if (profile_id < 1 || profile_id > MAX_PROFILES) {
+    OGXM_LOG_AT(NVS, WARN, "UserSettings::get_profile_by_id: Invalid profile id\n");
     return UserProfile();
   }
+
+  mutex_enter_blocking(&cache_mutex_);
+  UserProfile profile = profiles_[profile_id - 1];
+  mutex_exit(&cache_mutex_);
   return profile;
 }
 
+// Reads every profile and active id once, profiles stored in an older format
+// are rewritten in the current one
+void UserSettings::load_cache() {
+  std::array<uint8_t, ProfileFormat::ENCODED_LEN> buffer;
+  NVSTool::Transaction migration = nvs_tool_.begin();
+  bool migrate = false;
+
+  for (uint8_t profile_id = 1; profile_id <= MAX_PROFILES; profile_id++) {
+    UserProfile profile;
+    size_t stored_len = 0;
+    bool outdated = false;
+
+    if (!nvs_tool_.read(PROFILE_KEY(profile_id).data(), buffer.data(), buffer.size(), &stored_len) ||
+        !ProfileFormat::decode(buffer.data(), std::min(stored_len, buffer.size()), profile, outdated) ||
+        profile.id != profile_id) {
+      OGXM_LOG_AT(NVS, WARN, "Profile %i read failed, using default profile\n", profile_id);
+      profile = UserProfile();
+      profile.id = profile_id;
+    } else if (outdated) {
+      OGXM_LOG_AT(NVS, INFO, "Migrating profile %i\n", profile_id);
+      size_t encoded_len = ProfileFormat::encode(profile, buffer.data());
+      migration.write(PROFILE_KEY(profile_id).data(), buffer.data(), encoded_len);
+      migrate = true;
+    }
+    profiles_[profile_id - 1] = profile;
+  }
+
+  for (uint8_t i = 0; i < MAX_GAMEPADS; i++) {
+    uint8_t profile_id = 0;
+    nvs_tool_.read(ACTIVE_PROFILE_KEY(i).data(), &profile_id, sizeof(uint8_t));
+
+    if (profile_id < 1 || profile_id > MAX_PROFILES) {
+      OGXM_LOG_AT(NVS, WARN, "UserSettings::load_cache: Invalid profile id\n");
+      profile_id = 0x01;
+    }
+    active_profile_ids_[i] = profile_id;
+  }
+
+  if (migrate && !migration.commit()) {
+    OGXM_LOG_AT(NVS, WARN, "UserSettings::load_cache: Migration commit failed\n");
+  }
+}
+
 bool UserSettings::is_valid_driver(DeviceDriverType driver) {
   for (const auto &valid_driver : VALID_DRIVER_TYPES) {
     if (driver == valid_driver) {
@@ -276,32 +400,32 @@ DeviceDriverType UserSettings::get_current_driver() {
   }
 
   uint8_t stored_value = 0;
-  nvs_tool_.read(DRIVER_TYPE_KEY(), &stored_value, sizeof(uint8_t));
+  nvs_tool_.read(DRIVER_TYPE_KEY().data(), &stored_value, sizeof(uint8_t));
 
   if (is_valid_driver(static_cast<DeviceDriverType>(stored_value))) {
-    OGXM_LOG("Driver type read from flash: " +
-             OGXM_TO_STRING(static_cast<DeviceDriverType>(stored_value)) +
-             "\n");
+    OGXM_LOG_AT(NVS, INFO, "Driver type read from flash: " +
+                OGXM_TO_STRING(static_cast<DeviceDriverType>(stored_value)) +
+                "\n");
 
     current_driver_ = static_cast<DeviceDriverType>(stored_value);
     return current_driver_;
   }
 
-  OGXM_LOG("Invalid driver type read from flash, setting default driver\n");
+  OGXM_LOG_AT(NVS, WARN, "Invalid driver type read from flash, setting default driver\n");
 
   current_driver_ = DEFAULT_DRIVER();
   return current_driver_;
 }
 
 void UserSettings::write_datetime() {
-  nvs_tool_.write(DATETIME_KEY(), DATETIME_TAG.c_str(),
+  nvs_tool_.write(DATETIME_KEY().data(), DATETIME_TAG.c_str(),
                   DATETIME_TAG.size() + 1);
 }
 
 bool UserSettings::verify_datetime() {
   char read_dt_tag[DATETIME_TAG.size() + 1] = {0};
 
-  if (!nvs_tool_.read(DATETIME_KEY(), read_dt_tag, sizeof(read_dt_tag)) ||
+  if (!nvs_tool_.read(DATETIME_KEY().data(), read_dt_tag, sizeof(read_dt_tag)) ||
       (std::strcmp(read_dt_tag, DATETIME_TAG.c_str()) != 0)) {
     return false;
   }
@@ -311,48 +435,53 @@ bool UserSettings::verify_datetime() {
 // Checks for first boot and initializes user profiles, call before tusb is
 // inited.
 void UserSettings::initialize_flash() {
-  OGXM_LOG("Initializing flash\n");
+  OGXM_LOG_AT(NVS, INFO, "Initializing flash\n");
 
   uint8_t read_init_flag = 0;
-  nvs_tool_.read(INIT_FLAG_KEY(), &read_init_flag, sizeof(uint8_t));
+  nvs_tool_.read(INIT_FLAG_KEY().data(), &read_init_flag, sizeof(uint8_t));
 
   if (read_init_flag == FLASH_INIT_FLAG) {
-    OGXM_LOG("Flash already initialized: %i\n", read_init_flag);
+    OGXM_LOG_AT(NVS, INFO, "Flash already initialized: %i\n", read_init_flag);
+    load_cache();
     return;
   }
 
-  OGXM_LOG("Flash not initialized, erasing\n");
+  OGXM_LOG_AT(NVS, INFO, "Flash not initialized, erasing\n");
   nvs_tool_.erase_all();
 
-  OGXM_LOG("Writing default driver\n");
+  OGXM_LOG_AT(NVS, INFO, "Writing default driver\n");
 
   uint8_t device_mode_buffer = static_cast<uint8_t>(DEFAULT_DRIVER());
-  nvs_tool_.write(DRIVER_TYPE_KEY(), &device_mode_buffer, sizeof(uint8_t));
+  nvs_tool_.write(DRIVER_TYPE_KEY().data(), &device_mode_buffer, sizeof(uint8_t));
 
-  OGXM_LOG("Writing default profile ids\n");
+  OGXM_LOG_AT(NVS, INFO, "Writing default profile ids\n");
 
   for (uint8_t i = 0; i < MAX_GAMEPADS; i++) {
     uint8_t profile_id = i + 1;
-    nvs_tool_.write(ACTIVE_PROFILE_KEY(i), &profile_id, sizeof(uint8_t));
+    nvs_tool_.write(ACTIVE_PROFILE_KEY(i).data(), &profile_id, sizeof(uint8_t));
   }
 
-  OGXM_LOG("Writing default profiles\n");
+  OGXM_LOG_AT(NVS, INFO, "Writing default profiles\n");
 
   {
     UserProfile profile;
-    OGXM_LOG("Profile size: %i\n", sizeof(UserProfile));
+    std::array<uint8_t, ProfileFormat::ENCODED_LEN> encoded;
+    OGXM_LOG_AT(NVS, DEBUG, "Profile size: %i\n", sizeof(UserProfile));
 
     for (uint8_t i = 0; i < MAX_PROFILES; i++) {
       profile.id = i + 1;
-      nvs_tool_.write(PROFILE_KEY(profile.id), &profile, sizeof(UserProfile));
-      OGXM_LOG("Profile " + std::to_string(profile.id) + " written\n");
+      size_t encoded_len = ProfileFormat::encode(profile, encoded.data());
+      nvs_tool_.write(PROFILE_KEY(profile.id).data(), encoded.data(), encoded_len);
+      OGXM_LOG_AT(NVS, INFO, "Profile " + std::to_string(profile.id) + " written\n");
     }
   }
 
-  OGXM_LOG("Writing init flag\n");
+  OGXM_LOG_AT(NVS, INFO, "Writing init flag\n");
 
   uint8_t init_flag_buffer = FLASH_INIT_FLAG;
-  nvs_tool_.write(INIT_FLAG_KEY(), &init_flag_buffer, sizeof(uint8_t));
+  nvs_tool_.write(INIT_FLAG_KEY().data(), &init_flag_buffer, sizeof(uint8_t));
+
+  OGXM_LOG_AT(NVS, INFO, "Flash initialized\n");
 
-  OGXM_LOG("Flash initialized\n");
+  load_cache();
 }
\ No newline at end of file
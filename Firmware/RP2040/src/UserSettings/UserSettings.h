@@ -1,8 +1,10 @@
 #ifndef _USER_SETTINGS_H_
 #define _USER_SETTINGS_H_
 
+#include <array>
 #include <cstdint>
 #include <string>
+#include <pico/mutex.h>
 
 #include "Board/Config.h"
 #include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
@@ -10,7 +12,9 @@
 #include "UserSettings/NVSTool.h"
 #include "Gamepad/Gamepad.h"
 
-/* Only write/store flash from Core0 */
+/*  Only write/store flash from Core0.
+    Profiles and active profile ids are cached in RAM by initialize_flash(), the getters
+    never touch flash and are safe to call from either core. */
 class UserSettings
 {
 public:
@@ -24,6 +28,8 @@ public:
     }
 
     void initialize_flash();
+    //Sets each gamepad's active profile and keeps them so later stores apply live
+    void initialize_profiles(Gamepad (&gamepads)[MAX_GAMEPADS]);
 
     bool is_valid_driver(DeviceDriverType driver);
     bool verify_datetime();
@@ -41,24 +47,47 @@ public:
     bool store_profile_and_driver_type(DeviceDriverType new_driver_type, uint8_t index, const UserProfile& profile);
 
 private:
-    UserSettings() = default;
+    UserSettings()
+    {
+        mutex_init(&cache_mutex_);
+    }
     ~UserSettings() = default;
     UserSettings(const UserSettings&) = delete;
     UserSettings& operator=(const UserSettings&) = delete;
 
     static constexpr uint8_t GP_CHECK_COUNT = 3000 / GP_CHECK_DELAY_MS;
     static constexpr uint8_t FLASH_INIT_FLAG = 0xF8;
+    static constexpr uint32_t FLASH_STEP_INTERVAL_MS = 1;
     const std::string DATETIME_TAG = BUILD_DATETIME; 
+
+    static_assert(ProfileFormat::ENCODED_LEN <= NVSTool::VALUE_LEN_MAX, "Encoded profile doesn't fit an NVS record");
+
+    //Built on the stack, no heap allocation per flash access
+    using Key = std::array<char, NVSTool::KEY_LEN_MAX>;
     
     NVSTool& nvs_tool_{NVSTool::get_instance()};
     DeviceDriverType current_driver_{DeviceDriverType::NONE};
+    Gamepad* gamepads_[MAX_GAMEPADS]{nullptr};
+    uint32_t flash_task_id_{0};
+    bool flash_writer_running_{false};
+
+    mutex_t cache_mutex_;
+    std::array<UserProfile, MAX_PROFILES> profiles_;
+    std::array<uint8_t, MAX_GAMEPADS> active_profile_ids_{};
     
     DeviceDriverType DEFAULT_DRIVER();
-    const std::string INIT_FLAG_KEY();
-    const std::string PROFILE_KEY(const uint8_t profile_id);
-    const std::string ACTIVE_PROFILE_KEY(const uint8_t index);
-    const std::string DRIVER_TYPE_KEY();
-    const std::string DATETIME_KEY();
+    static Key KEY(const char* prefix, int32_t number = -1);
+    static Key INIT_FLAG_KEY();
+    static Key PROFILE_KEY(const uint8_t profile_id);
+    static Key ACTIVE_PROFILE_KEY(const uint8_t index);
+    static Key DRIVER_TYPE_KEY();
+    static Key DATETIME_KEY();
+
+    void load_cache();
+    void cache_profile(uint8_t index, const UserProfile& profile);
+    bool write_profile(uint8_t index, const UserProfile& profile);
+    void start_flash_writer();
+    void run_flash_writer();
 };
 
 #endif // _USER_SETTINGS_H_
\ No newline at end of file
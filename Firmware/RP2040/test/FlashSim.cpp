@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "FlashSim.h"
+
+alignas(FLASH_SECTOR_SIZE) uint8_t flash_sim_memory[flash_sim::SIZE];
+
+int test_failures = 0;
+
+namespace flash_sim
+{
+    namespace
+    {
+        uint32_t op_count = 0;
+        uint32_t fault_op = 0;
+        Fault fault = Fault::NONE;
+        size_t fault_torn_bytes = 0;
+        uint32_t fault_fail_ops = 0;
+        bool fault_fired = false;
+
+        //Returns false if the op should fail, throws after tearing it for a cut
+        bool next_op(uint8_t* dst, const uint8_t* src, size_t len)
+        {
+            const uint32_t op = op_count++;
+            if (fault == Fault::NONE || op < fault_op)
+            {
+                return true;
+            }
+            fault_fired = true;
+            if (fault == Fault::FAIL)
+            {
+                if (op - fault_op + 1 >= fault_fail_ops)
+                {
+                    fault = Fault::NONE;
+                }
+                return false;
+            }
+
+            const size_t torn = std::min(fault_torn_bytes, len);
+            for (size_t i = 0; i < torn; ++i)
+            {
+                dst[i] = (src == nullptr) ? 0xFF : (dst[i] & src[i]);
+            }
+            fault = Fault::NONE;
+            throw PowerCut{};
+        }
+    }
+
+    void reset()
+    {
+        std::memset(flash_sim_memory, 0xFF, SIZE);
+        disarm();
+    }
+
+    void arm(uint32_t op, Fault new_fault, size_t torn_bytes, uint32_t fail_ops)
+    {
+        op_count = 0;
+        fault_op = op;
+        fault = new_fault;
+        fault_torn_bytes = torn_bytes;
+        fault_fail_ops = fail_ops;
+        fault_fired = false;
+    }
+
+    void disarm()
+    {
+        arm(0, Fault::NONE);
+    }
+
+    bool fired()
+    {
+        return fault_fired;
+    }
+
+    uint32_t ops()
+    {
+        return op_count;
+    }
+}
+
+bool NVSTool::flash_erase(uint32_t offset)
+{
+    if (offset % FLASH_SECTOR_SIZE != 0 || offset + FLASH_SECTOR_SIZE > flash_sim::SIZE)
+    {
+        throw std::out_of_range("flash_erase");
+    }
+    uint8_t* dst = flash_sim_memory + offset;
+    if (!flash_sim::next_op(dst, nullptr, FLASH_SECTOR_SIZE))
+    {
+        return false;
+    }
+    std::memset(dst, 0xFF, FLASH_SECTOR_SIZE);
+    return true;
+}
+
+bool NVSTool::flash_program(uint32_t offset, const void* data, size_t len)
+{
+    if (offset % FLASH_PAGE_SIZE != 0 || len % FLASH_PAGE_SIZE != 0 || offset + len > flash_sim::SIZE)
+    {
+        throw std::out_of_range("flash_program");
+    }
+    uint8_t* dst = flash_sim_memory + offset;
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    if (!flash_sim::next_op(dst, src, len))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < len; ++i)
+    {
+        dst[i] &= src[i];
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef _FLASH_SIM_H_
+#define _FLASH_SIM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#include "UserSettings/NVSTool.h"
+
+/*  Host side NOR flash for the NVSTool tests.
+
+    Programming can only clear bits and an erase sets a whole sector to 0xFF, like the
+    real part. Every erase or program counts as one operation and a fault can be armed
+    for the nth operation from now:
+    CUT  - power is lost part way through: the first torn_bytes of the range are
+           programmed/erased, then PowerCut is thrown and the NVSTool instance has to
+           be dropped, like the RAM it lived in.
+    FAIL - the flash couldn't be locked out (flash_safe_execute timeout), the call
+           returns false and nothing changes. Repeats for fail_ops operations in a row. */
+
+namespace flash_sim
+{
+    static constexpr size_t SIZE = PICO_FLASH_SIZE_BYTES;
+
+    enum class Fault { NONE, CUT, FAIL };
+
+    struct PowerCut {};
+
+    //Blank chip, disarms any fault and zeroes the op count
+    void reset();
+
+    void arm(uint32_t op, Fault fault, size_t torn_bytes = 0, uint32_t fail_ops = 1);
+    void disarm();
+    bool fired();
+
+    //Operations since the last reset() or arm()
+    uint32_t ops();
+}
+
+//Mounts instances directly instead of through the get_instance() singleton, so a test
+//can drop one at a power cut and mount again over the same flash
+class NVSToolTest
+{
+public:
+    using Instance = std::unique_ptr<NVSTool, void(*)(NVSTool*)>;
+
+    static Instance mount()
+    {
+        return Instance(new NVSTool(), [](NVSTool* nvs) { delete nvs; });
+    }
+};
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++test_failures;                                                \
+        }                                                                   \
+    } while (0)
+
+extern int test_failures;
+
+#endif // _FLASH_SIM_H_
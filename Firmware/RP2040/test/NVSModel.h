@@ -0,0 +1,105 @@
+#ifndef _NVS_MODEL_H_
+#define _NVS_MODEL_H_
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "FlashSim.h"
+
+/*  What each test key is allowed to read back as. A value that was being written when
+    power was cut, or whose write returned false, may or may not have landed, so it's
+    added to the allowed values. A successful write makes its value the only one. */
+
+namespace nvs_model
+{
+    static constexpr const char* KEYS[] = { "profile_id", "driver", "k", "fourteen_chars", "analog" };
+    static constexpr uint32_t NUM_KEYS = sizeof(KEYS) / sizeof(KEYS[0]);
+
+    struct Value
+    {
+        std::array<uint8_t, NVSTool::VALUE_LEN_MAX> bytes{};
+        size_t len{0};
+
+        bool operator==(const Value& other) const
+        {
+            return (len == other.len && std::memcmp(bytes.data(), other.bytes.data(), len) == 0);
+        }
+    };
+
+    //Different length and contents for every key and generation
+    inline Value make_value(uint32_t key, uint32_t gen)
+    {
+        Value value;
+        value.len = 1 + (gen * 37 + key * 11) % NVSTool::VALUE_LEN_MAX;
+        for (size_t i = 0; i < value.len; ++i)
+        {
+            value.bytes[i] = static_cast<uint8_t>(key * 31 + gen * 17 + i);
+        }
+        return value;
+    }
+
+    struct KeyState
+    {
+        bool may_be_absent{true};
+        std::vector<Value> allowed;
+    };
+
+    struct Model
+    {
+        std::array<KeyState, NUM_KEYS> keys;
+
+        void begin_write(uint32_t key, const Value& value)
+        {
+            keys[key].allowed.push_back(value);
+        }
+
+        void end_write(uint32_t key, const Value& value, bool success)
+        {
+            if (success)
+            {
+                keys[key].may_be_absent = false;
+                keys[key].allowed = { value };
+            }
+        }
+
+        bool matches(uint32_t key, NVSTool& nvs) const
+        {
+            Value value;
+            if (!nvs.read(KEYS[key], value.bytes.data(), value.bytes.size(), &value.len))
+            {
+                return keys[key].may_be_absent;
+            }
+            for (const Value& allowed : keys[key].allowed)
+            {
+                if (allowed == value)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    inline bool write(NVSTool& nvs, Model& model, uint32_t key, const Value& value)
+    {
+        model.begin_write(key, value);
+        bool ret = nvs.write(KEYS[key], value.bytes.data(), value.len);
+        model.end_write(key, value, ret);
+        return ret;
+    }
+
+    inline void verify(NVSTool& nvs, const Model& model, int line)
+    {
+        for (uint32_t key = 0; key < NUM_KEYS; ++key)
+        {
+            if (!model.matches(key, nvs))
+            {
+                std::printf("line %d: key %s read back a value it was never written with\n", line, KEYS[key]);
+                ++test_failures;
+            }
+        }
+    }
+}
+
+#endif // _NVS_MODEL_H_
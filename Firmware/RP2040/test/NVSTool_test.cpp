@@ -0,0 +1,197 @@
+#include <cstdio>
+
+#include "FlashSim.h"
+#include "NVSModel.h"
+
+/*  Power loss tests for the NVSTool log. A fixed workload of single key writes (enough to
+    rotate the head through every sector and garbage collect each one a few times) is cut
+    at every flash operation it does, then the store is mounted again and every key has to
+    read back its last written value or the one that was in flight. */
+
+using namespace nvs_model;
+
+namespace
+{
+    constexpr uint32_t WORKLOAD_WRITES = 150;
+    constexpr size_t TORN_BYTES[] = { 0, 8, FLASH_PAGE_SIZE / 2, FLASH_PAGE_SIZE - 4, FLASH_SECTOR_SIZE };
+
+    //Every key is read back after each write as well, a failed write or collection mustn't
+    //corrupt the RAM index
+    void workload(NVSTool& nvs, Model& model)
+    {
+        for (uint32_t gen = 0; gen < WORKLOAD_WRITES; ++gen)
+        {
+            //The last key is only written now and then, so it lives on in old sectors and
+            //gets copied forward by garbage collection
+            const uint32_t key = (gen % 60 == 0) ? NUM_KEYS - 1 : (gen % 7) % (NUM_KEYS - 1);
+            write(nvs, model, key, make_value(key, gen));
+            verify(nvs, model, __LINE__);
+        }
+    }
+
+    uint32_t workload_ops()
+    {
+        flash_sim::reset();
+        auto nvs = NVSToolTest::mount();
+        Model model;
+        flash_sim::disarm();
+        workload(*nvs, model);
+        return flash_sim::ops();
+    }
+
+    //After recovery the store has to take new writes of every key and keep them
+    void check_usable(NVSTool& nvs, Model& model)
+    {
+        for (uint32_t key = 0; key < NUM_KEYS; ++key)
+        {
+            CHECK(write(nvs, model, key, make_value(key, WORKLOAD_WRITES + key)));
+        }
+        verify(nvs, model, __LINE__);
+
+        auto remounted = NVSToolTest::mount();
+        verify(*remounted, model, __LINE__);
+    }
+
+    void test_roundtrip()
+    {
+        flash_sim::reset();
+        Model model;
+        {
+            auto nvs = NVSToolTest::mount();
+            workload(*nvs, model);
+            verify(*nvs, model, __LINE__);
+        }
+        for (const KeyState& key : model.keys)
+        {
+            CHECK(key.allowed.size() == 1);
+        }
+
+        auto nvs = NVSToolTest::mount();
+        verify(*nvs, model, __LINE__);
+
+        uint8_t value = 0;
+        CHECK(!nvs->read("missing", &value, sizeof(value)));
+        CHECK(!nvs->write("", &value, sizeof(value)));
+        CHECK(!nvs->write("fifteen_chars__", &value, sizeof(value)));
+
+        nvs->erase_all();
+        CHECK(!nvs->read(KEYS[0], &value, sizeof(value)));
+        auto remounted = NVSToolTest::mount();
+        CHECK(!remounted->read(KEYS[0], &value, sizeof(value)));
+    }
+
+    void test_power_loss_during_writes()
+    {
+        const uint32_t total_ops = workload_ops();
+
+        for (size_t torn_bytes : TORN_BYTES)
+        {
+            for (uint32_t cut = 0; cut < total_ops; ++cut)
+            {
+                flash_sim::reset();
+                Model model;
+                {
+                    auto nvs = NVSToolTest::mount();
+                    flash_sim::arm(cut, flash_sim::Fault::CUT, torn_bytes);
+                    try
+                    {
+                        workload(*nvs, model);
+                    }
+                    catch (const flash_sim::PowerCut&) {}
+                    CHECK(flash_sim::fired());
+                }
+
+                flash_sim::disarm();
+                auto nvs = NVSToolTest::mount();
+                verify(*nvs, model, __LINE__);
+                check_usable(*nvs, model);
+            }
+        }
+    }
+
+    //Power is lost again while the mount is repairing the first cut
+    void test_power_loss_during_recovery()
+    {
+        const uint32_t total_ops = workload_ops();
+
+        for (uint32_t cut = 0; cut < total_ops; ++cut)
+        {
+            for (uint32_t recovery_cut = 0; ; ++recovery_cut)
+            {
+                flash_sim::reset();
+                Model model;
+                {
+                    auto nvs = NVSToolTest::mount();
+                    flash_sim::arm(cut, flash_sim::Fault::CUT, FLASH_PAGE_SIZE / 2);
+                    try
+                    {
+                        workload(*nvs, model);
+                    }
+                    catch (const flash_sim::PowerCut&) {}
+                }
+
+                flash_sim::arm(recovery_cut, flash_sim::Fault::CUT, FLASH_PAGE_SIZE / 2);
+                try
+                {
+                    NVSToolTest::mount();
+                }
+                catch (const flash_sim::PowerCut&) {}
+                const bool recovery_was_cut = flash_sim::fired();
+
+                flash_sim::disarm();
+                auto nvs = NVSToolTest::mount();
+                verify(*nvs, model, __LINE__);
+                check_usable(*nvs, model);
+
+                if (!recovery_was_cut)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    //flash_safe_execute timing out: the op does nothing and reports failure. Runs of them
+    //get past the one retry a record program gets.
+    void test_failed_ops()
+    {
+        const uint32_t total_ops = workload_ops();
+
+        for (uint32_t fail_ops : { 1u, 2u, 4u })
+        {
+            for (uint32_t fail = 0; fail < total_ops; ++fail)
+            {
+                flash_sim::reset();
+                Model model;
+                {
+                    auto nvs = NVSToolTest::mount();
+                    flash_sim::arm(fail, flash_sim::Fault::FAIL, 0, fail_ops);
+                    workload(*nvs, model);
+                    CHECK(flash_sim::fired());
+                    verify(*nvs, model, __LINE__);
+                }
+
+                flash_sim::disarm();
+                auto nvs = NVSToolTest::mount();
+                verify(*nvs, model, __LINE__);
+                check_usable(*nvs, model);
+            }
+        }
+    }
+}
+
+int main()
+{
+    test_roundtrip();
+    test_power_loss_during_writes();
+    test_power_loss_during_recovery();
+    test_failed_ops();
+
+    if (test_failures > 0)
+    {
+        std::printf("NVSTool: %d check(s) failed\n", test_failures);
+        return 1;
+    }
+    std::printf("NVSTool: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,297 @@
+#include <cstdio>
+#include <optional>
+
+#include "FlashSim.h"
+#include "NVSModel.h"
+
+/*  Power loss tests for NVSTool transactions. Whatever the cut, after mounting again the
+    whole store has to read back as it was before the interrupted commit or with all of
+    its keys applied, never with only some of them. Covers commit() and commit_async()
+    driven by process(), one page per call. */
+
+using namespace nvs_model;
+
+namespace
+{
+    using Snapshot = std::array<std::optional<Value>, NUM_KEYS>;
+
+    struct Txn
+    {
+        std::array<bool, NUM_KEYS> has{};
+        Snapshot values;
+    };
+
+    constexpr uint32_t WORKLOAD_TXNS = 60;
+    constexpr size_t TORN_BYTES[] = { 0, 8, FLASH_PAGE_SIZE / 2, FLASH_PAGE_SIZE - 4, FLASH_SECTOR_SIZE };
+
+    //Two to four keys, a different set each time so members land in every slot position
+    Txn make_txn(uint32_t gen)
+    {
+        Txn txn;
+        const uint32_t count = 2 + gen % 3;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t key = (gen + i * 2) % NUM_KEYS;
+            txn.has[key] = true;
+            txn.values[key] = make_value(key, gen);
+        }
+        return txn;
+    }
+
+    Snapshot with_txn(Snapshot snapshot, const Txn& txn)
+    {
+        for (uint32_t key = 0; key < NUM_KEYS; ++key)
+        {
+            if (txn.has[key])
+            {
+                snapshot[key] = txn.values[key];
+            }
+        }
+        return snapshot;
+    }
+
+    Snapshot read_all(NVSTool& nvs)
+    {
+        Snapshot snapshot;
+        for (uint32_t key = 0; key < NUM_KEYS; ++key)
+        {
+            Value value;
+            if (nvs.read(KEYS[key], value.bytes.data(), value.bytes.size(), &value.len))
+            {
+                snapshot[key] = value;
+            }
+        }
+        return snapshot;
+    }
+
+    //committed is what the store holds, in_flight the transaction that may or may not have landed
+    struct TxnModel
+    {
+        Snapshot committed;
+        std::optional<Txn> in_flight;
+
+        void check(NVSTool& nvs, int line) const
+        {
+            const Snapshot stored = read_all(nvs);
+            if (stored == committed || (in_flight && stored == with_txn(committed, *in_flight)))
+            {
+                return;
+            }
+            std::printf("line %d: store isn't in the state before or after the transaction\n", line);
+            ++test_failures;
+        }
+
+        //After a remount: the in flight transaction either landed or it didn't, take what's there
+        void settle(NVSTool& nvs, int line)
+        {
+            check(nvs, line);
+            committed = read_all(nvs);
+            in_flight.reset();
+        }
+
+        void finish(bool success)
+        {
+            if (success)
+            {
+                committed = with_txn(committed, *in_flight);
+            }
+            in_flight.reset();
+        }
+    };
+
+    bool stage(NVSTool::Transaction& transaction, const Txn& txn)
+    {
+        bool ret = true;
+        for (uint32_t key = 0; key < NUM_KEYS; ++key)
+        {
+            if (txn.has[key])
+            {
+                ret = transaction.write(KEYS[key], txn.values[key]->bytes.data(), txn.values[key]->len) && ret;
+            }
+        }
+        return ret;
+    }
+
+    void commit_sync(NVSTool& nvs, TxnModel& model, const Txn& txn)
+    {
+        NVSTool::Transaction transaction = nvs.begin();
+        CHECK(stage(transaction, txn));
+        model.in_flight = txn;
+        model.finish(transaction.commit());
+    }
+
+    void commit_async(NVSTool& nvs, TxnModel& model, const Txn& txn)
+    {
+        NVSTool::Transaction transaction = nvs.begin();
+        CHECK(stage(transaction, txn));
+        model.in_flight = txn;
+
+        std::optional<bool> result;
+        CHECK(transaction.commit_async([&result](bool success) { result = success; }));
+        //The commit is spread over several calls, reads in between see the old state
+        while (nvs.process())
+        {
+            if (!result)
+            {
+                model.check(nvs, __LINE__);
+            }
+        }
+        CHECK(result.has_value());
+        model.finish(result.value_or(false));
+    }
+
+    using Commit = void (*)(NVSTool&, TxnModel&, const Txn&);
+
+    void workload(NVSTool& nvs, TxnModel& model, Commit commit)
+    {
+        for (uint32_t gen = 0; gen < WORKLOAD_TXNS; ++gen)
+        {
+            commit(nvs, model, make_txn(gen));
+            model.check(nvs, __LINE__);
+        }
+    }
+
+    uint32_t workload_ops(Commit commit)
+    {
+        flash_sim::reset();
+        auto nvs = NVSToolTest::mount();
+        TxnModel model;
+        flash_sim::disarm();
+        workload(*nvs, model, commit);
+        return flash_sim::ops();
+    }
+
+    //After recovery the store has to take another transaction of every key and keep it
+    void check_usable(NVSTool& nvs, TxnModel& model, Commit commit)
+    {
+        Txn txn;
+        for (uint32_t key = 0; key < NUM_KEYS; ++key)
+        {
+            txn.has[key] = true;
+            txn.values[key] = make_value(key, WORKLOAD_TXNS + key);
+        }
+        commit(nvs, model, txn);
+        CHECK(read_all(nvs) == with_txn(Snapshot(), txn));
+
+        auto remounted = NVSToolTest::mount();
+        CHECK(read_all(*remounted) == with_txn(Snapshot(), txn));
+    }
+
+    void test_power_loss(Commit commit)
+    {
+        const uint32_t total_ops = workload_ops(commit);
+
+        for (size_t torn_bytes : TORN_BYTES)
+        {
+            for (uint32_t cut = 0; cut < total_ops; ++cut)
+            {
+                flash_sim::reset();
+                TxnModel model;
+                {
+                    auto nvs = NVSToolTest::mount();
+                    flash_sim::arm(cut, flash_sim::Fault::CUT, torn_bytes);
+                    try
+                    {
+                        workload(*nvs, model, commit);
+                    }
+                    catch (const flash_sim::PowerCut&) {}
+                    CHECK(flash_sim::fired());
+                }
+
+                flash_sim::disarm();
+                auto nvs = NVSToolTest::mount();
+                model.settle(*nvs, __LINE__);
+                check_usable(*nvs, model, commit);
+            }
+        }
+    }
+
+    //A commit that reports failure has to leave the old state, in RAM and after a remount
+    void test_failed_ops(Commit commit)
+    {
+        const uint32_t total_ops = workload_ops(commit);
+
+        for (uint32_t fail_ops : { 1u, 2u, 4u })
+        {
+            for (uint32_t fail = 0; fail < total_ops; ++fail)
+            {
+                flash_sim::reset();
+                TxnModel model;
+                {
+                    auto nvs = NVSToolTest::mount();
+                    flash_sim::arm(fail, flash_sim::Fault::FAIL, 0, fail_ops);
+                    workload(*nvs, model, commit);
+                    CHECK(flash_sim::fired());
+                }
+
+                flash_sim::disarm();
+                auto nvs = NVSToolTest::mount();
+                CHECK(read_all(*nvs) == model.committed);
+                check_usable(*nvs, model, commit);
+            }
+        }
+    }
+
+    //Tears the commit record itself at every word. It only counts once its header and CRC are
+    //in, and the tail it doesn't use is left erased, so from some point on a torn record is
+    //already the whole record. Either way the transaction lands complete or not at all.
+    void test_torn_commit_record(Commit commit)
+    {
+        const Txn before = make_txn(0);
+        const Txn txn = make_txn(1);
+        uint32_t members = 0;
+        for (bool has : txn.has)
+        {
+            members += has ? 1 : 0;
+        }
+
+        bool landed = false;
+        for (size_t torn_bytes = 0; torn_bytes <= FLASH_PAGE_SIZE; torn_bytes += sizeof(uint32_t))
+        {
+            flash_sim::reset();
+            TxnModel model;
+            {
+                auto nvs = NVSToolTest::mount();
+                commit(*nvs, model, before);
+
+                //Members are programmed first, the commit record is the operation after them
+                flash_sim::arm(members, flash_sim::Fault::CUT, torn_bytes);
+                model.in_flight = txn;
+                try
+                {
+                    commit(*nvs, model, txn);
+                }
+                catch (const flash_sim::PowerCut&) {}
+                CHECK(flash_sim::fired());
+            }
+
+            flash_sim::disarm();
+            auto nvs = NVSToolTest::mount();
+            model.check(*nvs, __LINE__);
+
+            const bool now_landed = (read_all(*nvs) != model.committed);
+            CHECK(!landed || now_landed);
+            CHECK(!now_landed || torn_bytes > NVSTool::RECORD_HEADER_LEN);
+            landed = now_landed;
+        }
+        CHECK(landed);
+    }
+}
+
+int main()
+{
+    for (Commit commit : { &commit_sync, &commit_async })
+    {
+        test_torn_commit_record(commit);
+        test_power_loss(commit);
+        test_failed_ops(commit);
+    }
+
+    if (test_failures > 0)
+    {
+        std::printf("NVSTool transactions: %d check(s) failed\n", test_failures);
+        return 1;
+    }
+    std::printf("NVSTool transactions: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,672 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/DInput/DInput.h"
+#include "USBDevice/DeviceDriver/DS4/DS4.h"
+#include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/PS4/PS4.h"
+#include "USBDevice/DeviceDriver/Switch/Switch.h"
+#include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+
+/*  Diffs the ReportMap tables against the hand written report builders they replaced. The
+    legacy builders below are the bodies of the old process() functions, unchanged apart
+    from taking the report, pad and analog flag as arguments.
+
+    Both sides start from the report the driver's initialize() leaves behind and are fed the
+    same pads, so a byte a table forgets to clear shows up as a stale value. Analog mode is
+    fixed for a run like it is for a profile: the one known difference is DInput zeroing its
+    pressure bytes when analog is off, where the old builder left them as they were, and
+    that only shows when analog mode is switched off mid session. */
+
+namespace
+{
+    int test_failures = 0;
+
+    constexpr uint32_t RANDOM_PADS = 20000;
+    constexpr int16_t STICK_EDGES[] =
+    {
+        -32768, -32767, -16384, -1641, -1640, -1639, -1, 0, 1, 1639, 1640, 1641, 16383, 32766, 32767
+    };
+
+    int16_t random_stick(std::mt19937& rng)
+    {
+        if (rng() % 2)
+        {
+            return STICK_EDGES[rng() % (sizeof(STICK_EDGES) / sizeof(STICK_EDGES[0]))];
+        }
+        return static_cast<int16_t>(rng());
+    }
+
+    //Every dpad value against every single button first, then random pads. Buttons use all
+    //16 bits, the tables have to ignore the ones no Gamepad::BUTTON_* lives in
+    Gamepad::PadIn make_pad(std::mt19937& rng, uint32_t idx)
+    {
+        Gamepad::PadIn gp_in;
+        if (idx < 16 * 17)
+        {
+            gp_in.dpad = static_cast<uint8_t>(idx / 17);
+            gp_in.buttons = (idx % 17 < 16) ? static_cast<uint16_t>(1 << (idx % 17)) : 0xFFFF;
+            gp_in.trigger_l = (idx % 3 == 0) ? 0 : static_cast<uint8_t>(idx);
+            gp_in.trigger_r = (idx % 5 == 0) ? 0 : static_cast<uint8_t>(~idx);
+        }
+        else
+        {
+            gp_in.dpad = static_cast<uint8_t>(rng() % 16);
+            gp_in.buttons = static_cast<uint16_t>(rng());
+            gp_in.trigger_l = (rng() % 4 == 0) ? 0 : static_cast<uint8_t>(rng());
+            gp_in.trigger_r = (rng() % 4 == 0) ? 0 : static_cast<uint8_t>(rng());
+        }
+        gp_in.joystick_lx = random_stick(rng);
+        gp_in.joystick_ly = random_stick(rng);
+        gp_in.joystick_rx = random_stick(rng);
+        gp_in.joystick_ry = random_stick(rng);
+        for (uint8_t& analog : gp_in.analog)
+        {
+            analog = static_cast<uint8_t>(rng());
+        }
+        return gp_in;
+    }
+
+    template <typename REPORT_T, typename LEGACY_F, typename TABLE_F>
+    void diff_reports(const char* name, const REPORT_T& initial, LEGACY_F&& legacy, TABLE_F&& table)
+    {
+        for (bool analog_enabled : { false, true })
+        {
+            std::mt19937 rng(0x0613 + analog_enabled);
+            REPORT_T expected = initial;
+            REPORT_T actual = initial;
+
+            for (uint32_t idx = 0; idx < 16 * 17 + RANDOM_PADS; ++idx)
+            {
+                const Gamepad::PadIn gp_in = make_pad(rng, idx);
+                legacy(expected, gp_in, analog_enabled);
+                table(actual, gp_in, analog_enabled);
+
+                if (std::memcmp(&expected, &actual, sizeof(REPORT_T)) == 0)
+                {
+                    continue;
+                }
+
+                //Report the first differing byte and move on, the rest of the run would only repeat it
+                const uint8_t* exp_bytes = reinterpret_cast<const uint8_t*>(&expected);
+                const uint8_t* act_bytes = reinterpret_cast<const uint8_t*>(&actual);
+                size_t offset = 0;
+                while (exp_bytes[offset] == act_bytes[offset])
+                {
+                    ++offset;
+                }
+                std::printf("%s (analog %s) pad %u, dpad 0x%X buttons 0x%04X: byte %zu is 0x%02X, expected 0x%02X\n",
+                            name, analog_enabled ? "on" : "off", idx, gp_in.dpad, gp_in.buttons,
+                            offset, act_bytes[offset], exp_bytes[offset]);
+                ++test_failures;
+                break;
+            }
+        }
+    }
+
+    namespace legacy
+    {
+        void xinput(XInput::InReport& in_report_, const Gamepad::PadIn& gp_in, bool)
+        {
+            in_report_.buttons[0] = 0;
+            in_report_.buttons[1] = 0;
+
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_UP;
+                    break;
+                case Gamepad::DPAD_DOWN:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_DOWN;
+                    break;
+                case Gamepad::DPAD_LEFT:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_RIGHT:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_RIGHT;
+                    break;
+                case Gamepad::DPAD_UP_LEFT:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_UP_RIGHT:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_RIGHT;
+                    break;
+                case Gamepad::DPAD_DOWN_LEFT:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_DOWN_RIGHT:
+                    in_report_.buttons[0] = XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_RIGHT;
+                    break;
+                default:
+                    break;
+            }
+
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report_.buttons[0] |= XInput::Buttons0::BACK;
+            if (gp_in.buttons & Gamepad::BUTTON_START) in_report_.buttons[0] |= XInput::Buttons0::START;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report_.buttons[0] |= XInput::Buttons0::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report_.buttons[0] |= XInput::Buttons0::R3;
+
+            if (gp_in.buttons & Gamepad::BUTTON_X)     in_report_.buttons[1] |= XInput::Buttons1::X;
+            if (gp_in.buttons & Gamepad::BUTTON_A)     in_report_.buttons[1] |= XInput::Buttons1::A;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)     in_report_.buttons[1] |= XInput::Buttons1::Y;
+            if (gp_in.buttons & Gamepad::BUTTON_B)     in_report_.buttons[1] |= XInput::Buttons1::B;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    in_report_.buttons[1] |= XInput::Buttons1::LB;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report_.buttons[1] |= XInput::Buttons1::RB;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report_.buttons[1] |= XInput::Buttons1::HOME;
+
+            in_report_.trigger_l = gp_in.trigger_l;
+            in_report_.trigger_r = gp_in.trigger_r;
+
+            in_report_.joystick_lx = gp_in.joystick_lx;
+            in_report_.joystick_ly = Range::invert(gp_in.joystick_ly);
+            in_report_.joystick_rx = gp_in.joystick_rx;
+            in_report_.joystick_ry = Range::invert(gp_in.joystick_ry);
+        }
+
+        void dinput(DInput::InReport& in_report, const Gamepad::PadIn& gp_in, bool analog_enabled)
+        {
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:
+                    in_report.dpad = DInput::DPad::UP;
+                    break;
+                case Gamepad::DPAD_DOWN:
+                    in_report.dpad = DInput::DPad::DOWN;
+                    break;
+                case Gamepad::DPAD_LEFT:
+                    in_report.dpad = DInput::DPad::LEFT;
+                    break;
+                case Gamepad::DPAD_RIGHT:
+                    in_report.dpad = DInput::DPad::RIGHT;
+                    break;
+                case Gamepad::DPAD_UP_LEFT:
+                    in_report.dpad = DInput::DPad::UP_LEFT;
+                    break;
+                case Gamepad::DPAD_UP_RIGHT:
+                    in_report.dpad = DInput::DPad::UP_RIGHT;
+                    break;
+                case Gamepad::DPAD_DOWN_LEFT:
+                    in_report.dpad = DInput::DPad::DOWN_LEFT;
+                    break;
+                case Gamepad::DPAD_DOWN_RIGHT:
+                    in_report.dpad = DInput::DPad::DOWN_RIGHT;
+                    break;
+                default:
+                    in_report.dpad = DInput::DPad::CENTER;
+                    break;
+            }
+
+            std::memset(in_report.buttons, 0, sizeof(in_report.buttons));
+
+            if (gp_in.buttons & Gamepad::BUTTON_A)   in_report.buttons[0] |= DInput::Buttons0::CROSS;
+            if (gp_in.buttons & Gamepad::BUTTON_B)   in_report.buttons[0] |= DInput::Buttons0::CIRCLE;
+            if (gp_in.buttons & Gamepad::BUTTON_X)   in_report.buttons[0] |= DInput::Buttons0::SQUARE;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)   in_report.buttons[0] |= DInput::Buttons0::TRIANGLE;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)  in_report.buttons[0] |= DInput::Buttons0::L1;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)  in_report.buttons[0] |= DInput::Buttons0::R1;
+
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report.buttons[1] |= DInput::Buttons1::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report.buttons[1] |= DInput::Buttons1::R3;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report.buttons[1] |= DInput::Buttons1::SELECT;
+            if (gp_in.buttons & Gamepad::BUTTON_START) in_report.buttons[1] |= DInput::Buttons1::START;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report.buttons[1] |= DInput::Buttons1::SYS;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)  in_report.buttons[1] |= DInput::Buttons1::TP;
+
+            if (analog_enabled)
+            {
+                in_report.up_axis    = gp_in.analog[Gamepad::ANALOG_OFF_UP];
+                in_report.down_axis  = gp_in.analog[Gamepad::ANALOG_OFF_DOWN];
+                in_report.right_axis = gp_in.analog[Gamepad::ANALOG_OFF_RIGHT];
+                in_report.left_axis  = gp_in.analog[Gamepad::ANALOG_OFF_LEFT];
+
+                in_report.triangle_axis = gp_in.analog[Gamepad::ANALOG_OFF_Y];
+                in_report.circle_axis   = gp_in.analog[Gamepad::ANALOG_OFF_X];
+                in_report.cross_axis    = gp_in.analog[Gamepad::ANALOG_OFF_B];
+                in_report.square_axis   = gp_in.analog[Gamepad::ANALOG_OFF_A];
+
+                in_report.r1_axis = gp_in.analog[Gamepad::ANALOG_OFF_RB];
+                in_report.l1_axis = gp_in.analog[Gamepad::ANALOG_OFF_LB];
+            }
+
+            in_report.joystick_lx = Scale::int16_to_uint8(gp_in.joystick_lx);
+            in_report.joystick_ly = Scale::int16_to_uint8(gp_in.joystick_ly);
+            in_report.joystick_rx = Scale::int16_to_uint8(gp_in.joystick_rx);
+            in_report.joystick_ry = Scale::int16_to_uint8(gp_in.joystick_ry);
+
+            in_report.l2_axis = gp_in.trigger_l;
+            in_report.r2_axis = gp_in.trigger_r;
+        }
+
+        //DS4 and PS4 only differ in their constant names, battery level and the DS4 counter
+        uint8_t ds4_counter = 0;
+
+        uint8_t joystick_to_ds4(int16_t value, int16_t deadzone)
+        {
+            if (value > -deadzone && value < deadzone)
+            {
+                return 0x80;
+            }
+            return static_cast<uint8_t>(((static_cast<int32_t>(value) + 32768) * 255) / 65535);
+        }
+
+        void ds4(DS4::InReport& report_in_, const Gamepad::PadIn& gp_in, bool)
+        {
+            std::memset(&report_in_, 0, sizeof(DS4::InReport));
+            report_in_.report_id = 0x01;
+
+            constexpr int16_t DEADZONE = 1640;
+            report_in_.joystick_lx = joystick_to_ds4(gp_in.joystick_lx, DEADZONE);
+            report_in_.joystick_ly = joystick_to_ds4(gp_in.joystick_ly, DEADZONE);
+            report_in_.joystick_rx = joystick_to_ds4(gp_in.joystick_rx, DEADZONE);
+            report_in_.joystick_ry = joystick_to_ds4(gp_in.joystick_ry, DEADZONE);
+
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:         report_in_.buttons0 = DS4::DPad::UP;         break;
+                case Gamepad::DPAD_UP_RIGHT:   report_in_.buttons0 = DS4::DPad::UP_RIGHT;   break;
+                case Gamepad::DPAD_RIGHT:      report_in_.buttons0 = DS4::DPad::RIGHT;      break;
+                case Gamepad::DPAD_DOWN_RIGHT: report_in_.buttons0 = DS4::DPad::DOWN_RIGHT; break;
+                case Gamepad::DPAD_DOWN:       report_in_.buttons0 = DS4::DPad::DOWN;       break;
+                case Gamepad::DPAD_DOWN_LEFT:  report_in_.buttons0 = DS4::DPad::DOWN_LEFT;  break;
+                case Gamepad::DPAD_LEFT:       report_in_.buttons0 = DS4::DPad::LEFT;       break;
+                case Gamepad::DPAD_UP_LEFT:    report_in_.buttons0 = DS4::DPad::UP_LEFT;    break;
+                default:                       report_in_.buttons0 = DS4::DPad::CENTER;     break;
+            }
+
+            if (gp_in.buttons & Gamepad::BUTTON_X) report_in_.buttons0 |= DS4::Buttons0::SQUARE;
+            if (gp_in.buttons & Gamepad::BUTTON_A) report_in_.buttons0 |= DS4::Buttons0::CROSS;
+            if (gp_in.buttons & Gamepad::BUTTON_B) report_in_.buttons0 |= DS4::Buttons0::CIRCLE;
+            if (gp_in.buttons & Gamepad::BUTTON_Y) report_in_.buttons0 |= DS4::Buttons0::TRIANGLE;
+
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    report_in_.buttons1 |= DS4::Buttons1::L1;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    report_in_.buttons1 |= DS4::Buttons1::R1;
+            if (gp_in.trigger_l > 0)                   report_in_.buttons1 |= DS4::Buttons1::L2;
+            if (gp_in.trigger_r > 0)                   report_in_.buttons1 |= DS4::Buttons1::R2;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  report_in_.buttons1 |= DS4::Buttons1::SHARE;
+            if (gp_in.buttons & Gamepad::BUTTON_START) report_in_.buttons1 |= DS4::Buttons1::OPTIONS;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    report_in_.buttons1 |= DS4::Buttons1::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    report_in_.buttons1 |= DS4::Buttons1::R3;
+
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   report_in_.buttons2 |= DS4::Buttons2::PS;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)  report_in_.buttons2 |= DS4::Buttons2::TP;
+
+            report_in_.buttons2 |= ((ds4_counter++ & 0x3F) << 2);
+
+            report_in_.trigger_l = gp_in.trigger_l;
+            report_in_.trigger_r = gp_in.trigger_r;
+
+            report_in_.timestamp = 0;
+            report_in_.battery = 0x00;
+            report_in_.battery_level = 0x0B;
+        }
+
+        void ps4(PS4::InReport& report_in_, const Gamepad::PadIn& gp_in, bool)
+        {
+            std::memset(&report_in_, 0, sizeof(PS4::InReport));
+            report_in_.report_id = 0x01;
+
+            constexpr int16_t DEADZONE = 1640;
+            report_in_.joystick_lx = joystick_to_ds4(gp_in.joystick_lx, DEADZONE);
+            report_in_.joystick_ly = joystick_to_ds4(gp_in.joystick_ly, DEADZONE);
+            report_in_.joystick_rx = joystick_to_ds4(gp_in.joystick_rx, DEADZONE);
+            report_in_.joystick_ry = joystick_to_ds4(gp_in.joystick_ry, DEADZONE);
+
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:         report_in_.buttons0 = PS4::Buttons0::DPAD_UP;         break;
+                case Gamepad::DPAD_UP_RIGHT:   report_in_.buttons0 = PS4::Buttons0::DPAD_UP_RIGHT;   break;
+                case Gamepad::DPAD_RIGHT:      report_in_.buttons0 = PS4::Buttons0::DPAD_RIGHT;      break;
+                case Gamepad::DPAD_DOWN_RIGHT: report_in_.buttons0 = PS4::Buttons0::DPAD_RIGHT_DOWN; break;
+                case Gamepad::DPAD_DOWN:       report_in_.buttons0 = PS4::Buttons0::DPAD_DOWN;       break;
+                case Gamepad::DPAD_DOWN_LEFT:  report_in_.buttons0 = PS4::Buttons0::DPAD_DOWN_LEFT;  break;
+                case Gamepad::DPAD_LEFT:       report_in_.buttons0 = PS4::Buttons0::DPAD_LEFT;       break;
+                case Gamepad::DPAD_UP_LEFT:    report_in_.buttons0 = PS4::Buttons0::DPAD_LEFT_UP;    break;
+                default:                       report_in_.buttons0 = PS4::Buttons0::DPAD_CENTER;     break;
+            }
+
+            if (gp_in.buttons & Gamepad::BUTTON_X) report_in_.buttons0 |= PS4::Buttons0::SQUARE;
+            if (gp_in.buttons & Gamepad::BUTTON_A) report_in_.buttons0 |= PS4::Buttons0::CROSS;
+            if (gp_in.buttons & Gamepad::BUTTON_B) report_in_.buttons0 |= PS4::Buttons0::CIRCLE;
+            if (gp_in.buttons & Gamepad::BUTTON_Y) report_in_.buttons0 |= PS4::Buttons0::TRIANGLE;
+
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    report_in_.buttons1 |= PS4::Buttons1::L1;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    report_in_.buttons1 |= PS4::Buttons1::R1;
+            if (gp_in.trigger_l > 0)                   report_in_.buttons1 |= PS4::Buttons1::L2;
+            if (gp_in.trigger_r > 0)                   report_in_.buttons1 |= PS4::Buttons1::R2;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  report_in_.buttons1 |= PS4::Buttons1::SHARE;
+            if (gp_in.buttons & Gamepad::BUTTON_START) report_in_.buttons1 |= PS4::Buttons1::OPTIONS;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    report_in_.buttons1 |= PS4::Buttons1::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    report_in_.buttons1 |= PS4::Buttons1::R3;
+
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   report_in_.buttons2 |= PS4::Buttons2::PS;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)  report_in_.buttons2 |= PS4::Buttons2::TP;
+
+            report_in_.trigger_l = gp_in.trigger_l;
+            report_in_.trigger_r = gp_in.trigger_r;
+
+            report_in_.battery_level = 0xFF;
+        }
+
+        uint8_t joystick_to_ps3(int16_t value, int16_t deadzone)
+        {
+            if (value > -deadzone && value < deadzone)
+            {
+                return 0x7F;
+            }
+            return static_cast<uint8_t>(((static_cast<int32_t>(value) + 32768) * 254) / 65535);
+        }
+
+        void ps3(PS3::InReport& report_in_, const Gamepad::PadIn& gp_in, bool analog_enabled)
+        {
+            report_in_ = PS3::InReport();
+
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_UP;
+                    break;
+                case Gamepad::DPAD_DOWN:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN;
+                    break;
+                case Gamepad::DPAD_LEFT:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_RIGHT:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_RIGHT;
+                    break;
+                case Gamepad::DPAD_UP_LEFT:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_UP_RIGHT:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_RIGHT;
+                    break;
+                case Gamepad::DPAD_DOWN_LEFT:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_DOWN_RIGHT:
+                    report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_RIGHT;
+                    break;
+                default:
+                    break;
+            }
+
+            if (gp_in.buttons & Gamepad::BUTTON_X)     report_in_.buttons[1] |= PS3::Buttons1::SQUARE;
+            if (gp_in.buttons & Gamepad::BUTTON_A)     report_in_.buttons[1] |= PS3::Buttons1::CROSS;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)     report_in_.buttons[1] |= PS3::Buttons1::TRIANGLE;
+            if (gp_in.buttons & Gamepad::BUTTON_B)     report_in_.buttons[1] |= PS3::Buttons1::CIRCLE;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    report_in_.buttons[1] |= PS3::Buttons1::L1;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    report_in_.buttons[1] |= PS3::Buttons1::R1;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  report_in_.buttons[0] |= PS3::Buttons0::SELECT;
+            if (gp_in.buttons & Gamepad::BUTTON_START) report_in_.buttons[0] |= PS3::Buttons0::START;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    report_in_.buttons[0] |= PS3::Buttons0::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    report_in_.buttons[0] |= PS3::Buttons0::R3;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   report_in_.buttons[2] |= PS3::Buttons2::SYS;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)  report_in_.buttons[2] |= PS3::Buttons2::TP;
+
+            if (gp_in.trigger_l) report_in_.buttons[1] |= PS3::Buttons1::L2;
+            if (gp_in.trigger_r) report_in_.buttons[1] |= PS3::Buttons1::R2;
+
+            report_in_.l2_axis = gp_in.trigger_l;
+            report_in_.r2_axis = gp_in.trigger_r;
+
+            constexpr int16_t DEADZONE = 1640;
+            report_in_.joystick_lx = joystick_to_ps3(gp_in.joystick_lx, DEADZONE);
+            report_in_.joystick_ly = joystick_to_ps3(gp_in.joystick_ly, DEADZONE);
+            report_in_.joystick_rx = joystick_to_ps3(gp_in.joystick_rx, DEADZONE);
+            report_in_.joystick_ry = joystick_to_ps3(gp_in.joystick_ry, DEADZONE);
+
+            report_in_.up_axis    = (gp_in.dpad & Gamepad::DPAD_UP)    ? 0xFF : 0;
+            report_in_.down_axis  = (gp_in.dpad & Gamepad::DPAD_DOWN)  ? 0xFF : 0;
+            report_in_.right_axis = (gp_in.dpad & Gamepad::DPAD_RIGHT) ? 0xFF : 0;
+            report_in_.left_axis  = (gp_in.dpad & Gamepad::DPAD_LEFT)  ? 0xFF : 0;
+
+            if (analog_enabled)
+            {
+                report_in_.triangle_axis = gp_in.analog[Gamepad::ANALOG_OFF_Y];
+                report_in_.circle_axis   = gp_in.analog[Gamepad::ANALOG_OFF_B];
+                report_in_.cross_axis    = gp_in.analog[Gamepad::ANALOG_OFF_A];
+                report_in_.square_axis   = gp_in.analog[Gamepad::ANALOG_OFF_X];
+                report_in_.r1_axis       = gp_in.analog[Gamepad::ANALOG_OFF_RB];
+                report_in_.l1_axis       = gp_in.analog[Gamepad::ANALOG_OFF_LB];
+            }
+            else
+            {
+                report_in_.triangle_axis = (gp_in.buttons & Gamepad::BUTTON_Y)  ? 0xFF : 0;
+                report_in_.circle_axis   = (gp_in.buttons & Gamepad::BUTTON_B)  ? 0xFF : 0;
+                report_in_.cross_axis    = (gp_in.buttons & Gamepad::BUTTON_A)  ? 0xFF : 0;
+                report_in_.square_axis   = (gp_in.buttons & Gamepad::BUTTON_X)  ? 0xFF : 0;
+                report_in_.r1_axis       = (gp_in.buttons & Gamepad::BUTTON_RB) ? 0xFF : 0;
+                report_in_.l1_axis       = (gp_in.buttons & Gamepad::BUTTON_LB) ? 0xFF : 0;
+            }
+        }
+
+        void switch_wired(SwitchWired::InReport& in_report, const Gamepad::PadIn& gp_in, bool)
+        {
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:
+                    in_report.dpad = SwitchWired::DPad::UP;
+                    break;
+                case Gamepad::DPAD_DOWN:
+                    in_report.dpad = SwitchWired::DPad::DOWN;
+                    break;
+                case Gamepad::DPAD_LEFT:
+                    in_report.dpad = SwitchWired::DPad::LEFT;
+                    break;
+                case Gamepad::DPAD_RIGHT:
+                    in_report.dpad = SwitchWired::DPad::RIGHT;
+                    break;
+                case Gamepad::DPAD_UP_LEFT:
+                    in_report.dpad = SwitchWired::DPad::UP_LEFT;
+                    break;
+                case Gamepad::DPAD_UP_RIGHT:
+                    in_report.dpad = SwitchWired::DPad::UP_RIGHT;
+                    break;
+                case Gamepad::DPAD_DOWN_LEFT:
+                    in_report.dpad = SwitchWired::DPad::DOWN_LEFT;
+                    break;
+                case Gamepad::DPAD_DOWN_RIGHT:
+                    in_report.dpad = SwitchWired::DPad::DOWN_RIGHT;
+                    break;
+                default:
+                    in_report.dpad = SwitchWired::DPad::CENTER;
+                    break;
+            }
+
+            in_report.buttons = 0;
+
+            if (gp_in.buttons & Gamepad::BUTTON_X)        in_report.buttons |= SwitchWired::Buttons::Y;
+            if (gp_in.buttons & Gamepad::BUTTON_A)        in_report.buttons |= SwitchWired::Buttons::B;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)        in_report.buttons |= SwitchWired::Buttons::X;
+            if (gp_in.buttons & Gamepad::BUTTON_B)        in_report.buttons |= SwitchWired::Buttons::A;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)       in_report.buttons |= SwitchWired::Buttons::L;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)       in_report.buttons |= SwitchWired::Buttons::R;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report.buttons |= SwitchWired::Buttons::MINUS;
+            if (gp_in.buttons & Gamepad::BUTTON_START)    in_report.buttons |= SwitchWired::Buttons::PLUS;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report.buttons |= SwitchWired::Buttons::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report.buttons |= SwitchWired::Buttons::R3;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)      in_report.buttons |= SwitchWired::Buttons::HOME;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)     in_report.buttons |= SwitchWired::Buttons::CAPTURE;
+
+            if (gp_in.trigger_l) in_report.buttons |= SwitchWired::Buttons::ZL;
+            if (gp_in.trigger_r) in_report.buttons |= SwitchWired::Buttons::ZR;
+
+            in_report.joystick_lx = Scale::int16_to_uint8(gp_in.joystick_lx);
+            in_report.joystick_ly = Scale::int16_to_uint8(gp_in.joystick_ly);
+            in_report.joystick_rx = Scale::int16_to_uint8(gp_in.joystick_rx);
+            in_report.joystick_ry = Scale::int16_to_uint8(gp_in.joystick_ry);
+        }
+
+        void xbox_og(XboxOG::GP::InReport& in_report_, const Gamepad::PadIn& gp_in, bool analog_enabled)
+        {
+            std::memset(&in_report_.buttons, 0, 8);
+
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP;
+                    break;
+                case Gamepad::DPAD_DOWN:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN;
+                    break;
+                case Gamepad::DPAD_LEFT:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_RIGHT:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_RIGHT;
+                    break;
+                case Gamepad::DPAD_UP_LEFT:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_UP_RIGHT:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_RIGHT;
+                    break;
+                case Gamepad::DPAD_DOWN_LEFT:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_LEFT;
+                    break;
+                case Gamepad::DPAD_DOWN_RIGHT:
+                    in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_RIGHT;
+                    break;
+                default:
+                    break;
+            }
+
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report_.buttons |= XboxOG::GP::Buttons::BACK;
+            if (gp_in.buttons & Gamepad::BUTTON_START)    in_report_.buttons |= XboxOG::GP::Buttons::START;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report_.buttons |= XboxOG::GP::Buttons::L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report_.buttons |= XboxOG::GP::Buttons::R3;
+
+            if (analog_enabled)
+            {
+                in_report_.a = gp_in.analog[Gamepad::ANALOG_OFF_A];
+                in_report_.b = gp_in.analog[Gamepad::ANALOG_OFF_B];
+                in_report_.x = gp_in.analog[Gamepad::ANALOG_OFF_X];
+                in_report_.y = gp_in.analog[Gamepad::ANALOG_OFF_Y];
+                in_report_.white = gp_in.analog[Gamepad::ANALOG_OFF_LB];
+                in_report_.black = gp_in.analog[Gamepad::ANALOG_OFF_RB];
+            }
+            else
+            {
+                if (gp_in.buttons & Gamepad::BUTTON_X)    in_report_.x = 0xFF;
+                if (gp_in.buttons & Gamepad::BUTTON_A)    in_report_.a = 0xFF;
+                if (gp_in.buttons & Gamepad::BUTTON_Y)    in_report_.y = 0xFF;
+                if (gp_in.buttons & Gamepad::BUTTON_B)    in_report_.b = 0xFF;
+                if (gp_in.buttons & Gamepad::BUTTON_LB)   in_report_.white = 0xFF;
+                if (gp_in.buttons & Gamepad::BUTTON_RB)   in_report_.black = 0xFF;
+            }
+
+            in_report_.trigger_l = gp_in.trigger_l;
+            in_report_.trigger_r = gp_in.trigger_r;
+
+            in_report_.joystick_lx = gp_in.joystick_lx;
+            in_report_.joystick_ly = Range::invert(gp_in.joystick_ly);
+            in_report_.joystick_rx = gp_in.joystick_rx;
+            in_report_.joystick_ry = Range::invert(gp_in.joystick_ry);
+        }
+
+    } // namespace legacy
+
+    //The table side of each driver's process(), plus whatever the driver does around write()
+    template <const auto& TABLE, typename REPORT_T>
+    void write_table(REPORT_T& report, const Gamepad::PadIn& gp_in, bool analog_enabled)
+    {
+        ReportMap::Writer<TABLE>::write(gp_in, analog_enabled, reinterpret_cast<uint8_t*>(&report));
+    }
+
+    void test_xinput()
+    {
+        diff_reports("XInput", XInput::InReport(), legacy::xinput,
+                     write_table<XInputDevice::REPORT_MAP, XInput::InReport>);
+    }
+
+    void test_dinput()
+    {
+        DInput::InReport initial;
+        std::memset(reinterpret_cast<void*>(&initial), 0, sizeof(DInput::InReport));
+        initial.dpad = DInput::DPad::CENTER;
+        initial.joystick_lx = DInput::AXIS_MID;
+        initial.joystick_ly = DInput::AXIS_MID;
+        initial.joystick_rx = DInput::AXIS_MID;
+        initial.joystick_ry = DInput::AXIS_MID;
+
+        diff_reports("DInput", initial, legacy::dinput,
+                     write_table<DInputDevice::REPORT_MAP, DInput::InReport>);
+    }
+
+    void test_ds4()
+    {
+        DS4::InReport initial;
+        std::memset(&initial, 0, sizeof(DS4::InReport));
+        initial.report_id = 0x01;
+        initial.battery_level = 0x0B;
+
+        uint8_t report_counter = 0;
+        legacy::ds4_counter = 0;
+        diff_reports("DS4", initial, legacy::ds4,
+                     [&report_counter](DS4::InReport& report_in, const Gamepad::PadIn& gp_in, bool analog_enabled)
+                     {
+                         write_table<DS4Device::REPORT_MAP>(report_in, gp_in, analog_enabled);
+                         report_in.buttons2 |= ((report_counter++ & 0x3F) << 2);
+                     });
+    }
+
+    void test_ps3()
+    {
+        diff_reports("PS3", PS3::InReport(), legacy::ps3,
+                     [](PS3::InReport& report_in, const Gamepad::PadIn& gp_in, bool analog_enabled)
+                     {
+                         report_in = PS3::InReport();
+                         write_table<PS3Device::REPORT_MAP>(report_in, gp_in, analog_enabled);
+                     });
+    }
+
+    void test_ps4()
+    {
+        PS4::InReport initial;
+        std::memset(&initial, 0, sizeof(PS4::InReport));
+        initial.report_id = 0x01;
+        initial.battery_level = 0xFF;
+
+        diff_reports("PS4", initial, legacy::ps4,
+                     write_table<PS4Device::REPORT_MAP, PS4::InReport>);
+    }
+
+    void test_switch()
+    {
+        diff_reports("Switch", SwitchWired::InReport(), legacy::switch_wired,
+                     write_table<SwitchDevice::REPORT_MAP, SwitchWired::InReport>);
+    }
+
+    void test_xbox_og()
+    {
+        XboxOG::GP::InReport initial;
+        std::memset(&initial, 0, sizeof(XboxOG::GP::InReport));
+        initial.report_len = sizeof(XboxOG::GP::InReport);
+
+        diff_reports("XboxOG", initial, legacy::xbox_og,
+                     write_table<XboxOGDevice::REPORT_MAP, XboxOG::GP::InReport>);
+    }
+
+} // namespace
+
+int main()
+{
+    test_xinput();
+    test_dinput();
+    test_ds4();
+    test_ps3();
+    test_ps4();
+    test_switch();
+    test_xbox_og();
+
+    if (test_failures > 0)
+    {
+        std::printf("ReportMap: %d report(s) differ\n", test_failures);
+        return 1;
+    }
+    std::printf("ReportMap: all reports match\n");
+    return 0;
+}
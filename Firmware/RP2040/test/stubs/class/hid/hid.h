@@ -0,0 +1,14 @@
+#ifndef _TEST_STUB_HID_H_
+#define _TEST_STUB_HID_H_
+
+#include "tusb.h"
+
+typedef enum
+{
+    HID_REPORT_TYPE_INVALID = 0,
+    HID_REPORT_TYPE_INPUT,
+    HID_REPORT_TYPE_OUTPUT,
+    HID_REPORT_TYPE_FEATURE,
+} hid_report_type_t;
+
+#endif // _TEST_STUB_HID_H_
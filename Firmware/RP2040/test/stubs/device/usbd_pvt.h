@@ -0,0 +1,20 @@
+#ifndef _TEST_STUB_USBD_PVT_H_
+#define _TEST_STUB_USBD_PVT_H_
+
+#include "tusb.h"
+
+typedef int xfer_result_t;
+
+typedef struct
+{
+    const char* name;
+    void (*init)(void);
+    bool (*deinit)(void);
+    void (*reset)(uint8_t rhport);
+    uint16_t (*open)(uint8_t rhport, const tusb_desc_interface_t* desc_intf, uint16_t max_len);
+    bool (*control_xfer_cb)(uint8_t rhport, uint8_t stage, const tusb_control_request_t* request);
+    bool (*xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+    void (*sof)(uint8_t rhport, uint32_t frame_count);
+} usbd_class_driver_t;
+
+#endif // _TEST_STUB_USBD_PVT_H_
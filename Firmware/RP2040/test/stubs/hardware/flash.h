@@ -0,0 +1,15 @@
+#ifndef _TEST_STUB_HARDWARE_FLASH_H_
+#define _TEST_STUB_HARDWARE_FLASH_H_
+
+#include <cstdint>
+
+/* Host stand-in for the pico-sdk header, flash is the array in FlashSim.cpp */
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define PICO_FLASH_SIZE_BYTES (NVS_SECTORS * FLASH_SECTOR_SIZE)
+
+extern uint8_t flash_sim_memory[];
+#define XIP_BASE (reinterpret_cast<uintptr_t>(flash_sim_memory))
+
+#endif // _TEST_STUB_HARDWARE_FLASH_H_
@@ -0,0 +1,38 @@
+#ifndef _TEST_STUB_FIX16_H_
+#define _TEST_STUB_FIX16_H_
+
+#include <cstdint>
+
+/*  Host stand-in for libfixmath. Conversions are inline, the math functions are only
+    declared: the tests include Gamepad.h for its types and never run the stick math. */
+
+typedef int32_t fix16_t;
+
+static const fix16_t fix16_one = 0x00010000;
+
+#define F16(x) ((fix16_t)(((x) >= 0) ? ((x) * 65536.0 + 0.5) : ((x) * 65536.0 - 0.5)))
+
+static inline fix16_t fix16_from_int(int a) { return a * fix16_one; }
+static inline int fix16_to_int(fix16_t a) { return a >> 16; }
+static inline fix16_t fix16_from_float(float a) { return static_cast<fix16_t>(a * 65536.0f); }
+static inline fix16_t fix16_from_dbl(double a) { return static_cast<fix16_t>(a * 65536.0); }
+static inline float fix16_to_float(fix16_t a) { return static_cast<float>(a) / 65536.0f; }
+static inline double fix16_to_dbl(fix16_t a) { return static_cast<double>(a) / 65536.0; }
+
+fix16_t fix16_abs(fix16_t x);
+fix16_t fix16_rad_to_deg(fix16_t radians);
+fix16_t fix16_deg_to_rad(fix16_t degrees);
+fix16_t fix16_atan(fix16_t x);
+fix16_t fix16_atan2(fix16_t y, fix16_t x);
+fix16_t fix16_tan(fix16_t x);
+fix16_t fix16_cos(fix16_t x);
+fix16_t fix16_sin(fix16_t x);
+fix16_t fix16_sqrt(fix16_t x);
+fix16_t fix16_sq(fix16_t x);
+fix16_t fix16_clamp(fix16_t x, fix16_t lo, fix16_t hi);
+fix16_t fix16_exp(fix16_t x);
+fix16_t fix16_log(fix16_t x);
+fix16_t fix16_mul(fix16_t a, fix16_t b);
+fix16_t fix16_div(fix16_t a, fix16_t b);
+
+#endif // _TEST_STUB_FIX16_H_
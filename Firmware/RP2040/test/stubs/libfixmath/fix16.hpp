@@ -0,0 +1,48 @@
+#ifndef _TEST_STUB_FIX16_HPP_
+#define _TEST_STUB_FIX16_HPP_
+
+#include "fix16.h"
+
+class Fix16
+{
+public:
+    fix16_t value{0};
+
+    Fix16() = default;
+    Fix16(const Fix16&) = default;
+    Fix16(fix16_t v) : value(v) {}
+    Fix16(double v) : value(fix16_from_dbl(v)) {}
+    Fix16(float v) : value(fix16_from_float(v)) {}
+    Fix16(int16_t v) : value(fix16_from_int(v)) {}
+
+    Fix16& operator=(const Fix16&) = default;
+
+    operator fix16_t() const { return value; }
+    operator double() const { return fix16_to_dbl(value); }
+    operator float() const { return fix16_to_float(value); }
+    operator int16_t() const { return static_cast<int16_t>(fix16_to_int(value)); }
+
+    Fix16& operator+=(const Fix16& rhs) { value += rhs.value; return *this; }
+    Fix16& operator-=(const Fix16& rhs) { value -= rhs.value; return *this; }
+    Fix16& operator*=(const Fix16& rhs) { value = fix16_mul(value, rhs.value); return *this; }
+    Fix16& operator/=(const Fix16& rhs) { value = fix16_div(value, rhs.value); return *this; }
+    Fix16& operator*=(int16_t rhs) { value *= rhs; return *this; }
+
+    const Fix16 operator+(const Fix16& other) const { Fix16 ret = *this; ret += other; return ret; }
+    const Fix16 operator-(const Fix16& other) const { Fix16 ret = *this; ret -= other; return ret; }
+    const Fix16 operator*(const Fix16& other) const { Fix16 ret = *this; ret *= other; return ret; }
+    const Fix16 operator/(const Fix16& other) const { Fix16 ret = *this; ret /= other; return ret; }
+    const Fix16 operator*(int16_t other) const { Fix16 ret = *this; ret *= Fix16(other); return ret; }
+    const Fix16 operator/(int16_t other) const { Fix16 ret = *this; ret /= Fix16(other); return ret; }
+    const Fix16 operator/(float other) const { Fix16 ret = *this; ret /= Fix16(other); return ret; }
+    const Fix16 operator-() const { return Fix16(-value); }
+
+    bool operator==(const Fix16& other) const { return value == other.value; }
+    bool operator!=(const Fix16& other) const { return value != other.value; }
+    bool operator<(const Fix16& other) const { return value < other.value; }
+    bool operator>(const Fix16& other) const { return value > other.value; }
+    bool operator<=(const Fix16& other) const { return value <= other.value; }
+    bool operator>=(const Fix16& other) const { return value >= other.value; }
+};
+
+#endif // _TEST_STUB_FIX16_HPP_
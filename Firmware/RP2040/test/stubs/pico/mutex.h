@@ -0,0 +1,15 @@
+#ifndef _TEST_STUB_PICO_MUTEX_H_
+#define _TEST_STUB_PICO_MUTEX_H_
+
+/* Host stand-in for the pico-sdk header, tests are single threaded */
+
+typedef struct
+{
+    int owner;
+} mutex_t;
+
+inline void mutex_init(mutex_t* mtx) { mtx->owner = -1; }
+inline void mutex_enter_blocking(mutex_t* mtx) { mtx->owner = 0; }
+inline void mutex_exit(mutex_t* mtx) { mtx->owner = -1; }
+
+#endif // _TEST_STUB_PICO_MUTEX_H_
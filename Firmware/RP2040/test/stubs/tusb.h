@@ -0,0 +1,87 @@
+#ifndef _TEST_STUB_TUSB_H_
+#define _TEST_STUB_TUSB_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/*  Host stand-in for TinyUSB, just enough for the driver headers to compile so their
+    report tables can be tested. Descriptor macros expand to a single placeholder byte. */
+
+#define CFG_TUSB_DEBUG 0
+#define CFG_TUD_LOG_LEVEL 2
+#define CFG_TUD_ENDPOINT0_SIZE 64
+#define CFG_TUD_HID_EP_BUFSIZE 64
+
+#define TU_ATTR_PACKED __attribute__((packed))
+#define TU_ATTR_ALIGNED(x) __attribute__((aligned(x)))
+#define TU_U16_LOW(x) (static_cast<uint8_t>((x) & 0xFF))
+#define TU_U16_HIGH(x) (static_cast<uint8_t>(((x) >> 8) & 0xFF))
+#define U16_TO_U8S_LE(x) TU_U16_LOW(x), TU_U16_HIGH(x)
+
+#define TUD_CONFIG_DESC_LEN 9
+#define TUD_HID_DESC_LEN 9
+#define TUD_HID_INOUT_DESC_LEN 9
+#define TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP 0x20
+#define TUD_CONFIG_DESCRIPTOR(...) 0
+#define TUD_HID_DESCRIPTOR(...) 0
+#define TUD_HID_INOUT_DESCRIPTOR(...) 0
+#define HID_ITF_PROTOCOL_NONE 0
+
+typedef struct
+{
+    uint8_t bmRequestType;
+    uint8_t bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+typedef struct TU_ATTR_PACKED
+{
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t bcdUSB;
+    uint8_t bDeviceClass;
+    uint8_t bDeviceSubClass;
+    uint8_t bDeviceProtocol;
+    uint8_t bMaxPacketSize0;
+    uint16_t idVendor;
+    uint16_t idProduct;
+    uint16_t bcdDevice;
+    uint8_t iManufacturer;
+    uint8_t iProduct;
+    uint8_t iSerialNumber;
+    uint8_t bNumConfigurations;
+} tusb_desc_device_t;
+
+typedef struct TU_ATTR_PACKED
+{
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bInterfaceNumber;
+    uint8_t bAlternateSetting;
+    uint8_t bNumEndpoints;
+    uint8_t bInterfaceClass;
+    uint8_t bInterfaceSubClass;
+    uint8_t bInterfaceProtocol;
+    uint8_t iInterface;
+} tusb_desc_interface_t;
+
+enum
+{
+    TUSB_DESC_DEVICE = 1,
+    TUSB_DESC_CONFIGURATION = 2,
+    TUSB_DESC_STRING = 3,
+    TUSB_DESC_INTERFACE = 4,
+    TUSB_DESC_ENDPOINT = 5,
+};
+
+enum
+{
+    TUSB_XFER_CONTROL = 0,
+    TUSB_XFER_ISOCHRONOUS = 1,
+    TUSB_XFER_BULK = 2,
+    TUSB_XFER_INTERRUPT = 3,
+};
+
+#endif // _TEST_STUB_TUSB_H_
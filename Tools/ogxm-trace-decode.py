@@ -0,0 +1,125 @@
+import re
+import sys
+import struct
+import argparse
+
+# Decodes the debug UART stream of a CONFIG_OGXM_DEBUG build.
+# Text logs are passed through, OGXM_TRACE frames are formatted using the firmware ELF.
+#
+#   python ogxm-trace-decode.py build/OGX-Mini.elf capture.bin
+#   python ogxm-trace-decode.py build/OGX-Mini.elf --port /dev/ttyUSB0   (needs pyserial)
+
+FRAME_START = 0x1E
+FRAME_TYPE_TRACE = ord('T')
+FRAME_HEADER_LEN = 4
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diuxXcsp%])")
+
+class Elf:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError("Expected a 32 bit little endian ELF")
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", self.data, shoff + i * shentsize)
+            if sh_type == SHT_PROGBITS and (flags & SHF_ALLOC) and size:
+                self.sections.append((addr, offset, size))
+
+    def read_string(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + (address - addr)
+                end = self.data.index(b"\0", start, offset + size)
+                return self.data[start:end].decode("utf-8", errors="replace")
+        return None
+
+def format_trace(elf, fmt_address, args):
+    fmt = elf.read_string(fmt_address)
+    if fmt is None:
+        return f"<unknown trace format 0x{fmt_address:08X}> " + " ".join(f"{a:08X}" for a in args) + "\n"
+
+    arg_iter = iter(args)
+
+    def convert(match):
+        flags, width, precision, _, spec = match.groups()
+        if spec == "%":
+            return "%"
+        value = next(arg_iter, 0)
+        if spec in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            spec = "d"
+        elif spec == "u":
+            spec = "d"
+        elif spec == "p":
+            return f"0x{value:08x}"
+        elif spec == "c":
+            value = chr(value & 0xFF)
+        elif spec == "s":
+            value = elf.read_string(value)
+            if value is None:
+                value = "<str>"
+        py_fmt = "%" + flags + width + (("." + precision) if precision else "") + spec
+        return py_fmt % value
+
+    return CONVERSION.sub(convert, fmt)
+
+def decode(elf, stream, out, follow=False):
+    buffer = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if follow:
+                continue
+            break
+        buffer += chunk
+        while buffer:
+            start = buffer.find(FRAME_START)
+            if start != 0:
+                text = buffer if start < 0 else buffer[:start]
+                out.write(text.decode("utf-8", errors="replace"))
+                del buffer[:len(text)]
+                continue
+            if len(buffer) < FRAME_HEADER_LEN:
+                break
+            _, frame_type, core, length = buffer[:FRAME_HEADER_LEN]
+            if frame_type != FRAME_TYPE_TRACE or length < 8 or length % 4:
+                del buffer[:1] # Not a frame
+                continue
+            if len(buffer) < FRAME_HEADER_LEN + length:
+                break
+            words = struct.unpack_from(f"<{length // 4}I", buffer, FRAME_HEADER_LEN)
+            del buffer[:FRAME_HEADER_LEN + length]
+            fmt_address, time_us, args = words[0], words[1], words[2:]
+            out.write(f"[{time_us / 1000000:12.6f}] C{core} " + format_trace(elf, fmt_address, args))
+        out.flush()
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode OGX-Mini binary trace logs")
+    parser.add_argument("elf", help="Firmware ELF the stream was produced by")
+    parser.add_argument("input", nargs="?", help="Captured UART stream, stdin if omitted")
+    parser.add_argument("--port", help="Read from a serial port instead")
+    parser.add_argument("--baud", type=int, default=115200)
+    options = parser.parse_args()
+
+    elf = Elf(options.elf)
+
+    if options.port:
+        import serial
+        with serial.Serial(options.port, options.baud, timeout=0.1) as port:
+            decode(elf, port, sys.stdout, follow=True)
+    elif options.input:
+        with open(options.input, "rb") as f:
+            decode(elf, f, sys.stdout)
+    else:
+        decode(elf, sys.stdin.buffer, sys.stdout)
+
+if __name__ == "__main__":
+    main()